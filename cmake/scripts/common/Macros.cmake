@@ -119,6 +119,19 @@ function(core_add_test_library name)
   endforeach()
 endfunction()
 
+# Add sources to the list of benchmark sources
+# Implicit arguments:
+#   SOURCES the benchmark sources
+#   HEADERS the benchmark headers (only for IDE support)
+# On return:
+#   Sources are added to bench_sources
+function(core_add_bench_library name)
+  foreach(src IN LISTS SOURCES HEADERS)
+    get_filename_component(src_path "${src}" ABSOLUTE)
+    set(bench_sources "${src_path}" ${bench_sources} CACHE STRING "" FORCE)
+  endforeach()
+endfunction()
+
 # Add an addon callback library
 # Arguments:
 #   name name of the library to add
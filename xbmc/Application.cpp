@@ -37,6 +37,7 @@
 #include "guilib/TextureManager.h"
 #include "cores/IPlayer.h"
 #include "cores/VideoPlayer/DVDFileInfo.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxSeekIndex.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/playercorefactory/PlayerCoreFactory.h"
@@ -624,6 +625,11 @@ bool CApplication::Create(const CAppParamParser &params)
 
   g_mediaManager.Initialize();
 
+  // drop directory listings stored by earlier sessions that haven't been refreshed for a while
+  g_directoryCache.PrunePersistent();
+  // and keyframe indexes of recordings that weren't played for a month, all of them if disabled
+  CDVDDemuxSeekIndex::Prune(g_advancedSettings.m_videoSeekIndex ? 30 : 0);
+
   m_lastRenderTime = XbmcThreads::SystemClockMillis();
   return true;
 }
@@ -3310,6 +3316,7 @@ void CApplication::OnPlayBackEnded()
   CVariant data(CVariant::VariantTypeObject);
   data["end"] = true;
   CAnnouncementManager::GetInstance().Announce(Player, "xbmc", "OnStop", m_itemCurrentFile, data);
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_ENDED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -3341,6 +3348,7 @@ void CApplication::OnPlayBackStarted(const CFileItem &file)
   m_stackHelper.OnPlayBackStarted(file);
 
   m_playerEvent.Reset();
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_STARTED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -3430,6 +3438,7 @@ void CApplication::OnPlayBackStopped()
   CVariant data(CVariant::VariantTypeObject);
   data["end"] = false;
   CAnnouncementManager::GetInstance().Announce(Player, "xbmc", "OnStop", m_itemCurrentFile, data);
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_STOPPED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -3457,6 +3466,7 @@ void CApplication::OnPlayBackPaused()
   param["player"]["speed"] = 0;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
   CAnnouncementManager::GetInstance().Announce(Player, "xbmc", "OnPause", m_itemCurrentFile, param);
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 }
 
 void CApplication::OnPlayBackResumed()
@@ -3473,6 +3483,7 @@ void CApplication::OnPlayBackResumed()
   param["player"]["speed"] = 1;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
   CAnnouncementManager::GetInstance().Announce(Player, "xbmc", "OnResume", m_itemCurrentFile, param);
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 }
 
 void CApplication::OnPlayBackSpeedChanged(int iSpeed)
@@ -3485,6 +3496,7 @@ void CApplication::OnPlayBackSpeedChanged(int iSpeed)
   param["player"]["speed"] = iSpeed;
   param["player"]["playerid"] = CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist();
   CAnnouncementManager::GetInstance().Announce(Player, "xbmc", "OnSpeedChanged", m_itemCurrentFile, param);
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 }
 
 void CApplication::OnPlayBackSeek(int64_t iTime, int64_t seekOffset)
@@ -3513,6 +3525,8 @@ void CApplication::OnAVStarted(const CFileItem &file)
 {
   CLog::LogF(LOGDEBUG, "CApplication::OnAVStarted");
 
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
+
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVSTARTED, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
 
@@ -3527,6 +3541,7 @@ void CApplication::OnAVChange()
   CLog::LogF(LOGDEBUG, "CApplication::OnAVChange");
 
   CServiceBroker::GetGUI()->GetStereoscopicsManager().OnStreamChange();
+  CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 
   CGUIMessage msg(GUI_MSG_PLAYBACK_AVCHANGE, 0, 0);
   CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
@@ -27,6 +27,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "cores/DataCacheCore.h"
 #include "Application.h"
+#include "GUIInfoManager.h"
 #include "PlayListPlayer.h"
 #include "ServiceBroker.h"
 #include "settings/MediaSettings.h"
@@ -53,6 +54,10 @@ void CApplicationPlayer::ClosePlayer()
     CSingleLock lock(m_playerLock);
     m_pPlayer.reset();
   }
+
+  CGUIComponent *gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
 }
 
 void CApplicationPlayer::CloseFile(bool reopen)
@@ -822,8 +827,13 @@ void CApplicationPlayer::FrameMove()
   if (player)
   {
     if (CDataCacheCore::GetInstance().IsPlayerStateChanged())
+    {
+      // player callbacks may precede the change they announce, so tracked
+      // player infos are notified again once the player has applied it
+      CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetPlayerInfoProvider().OnPlayerStateChanged();
       // CApplicationMessenger would be overhead because we are already in gui thread
       CServiceBroker::GetGUI()->GetWindowManager().SendMessage(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_STATE_CHANGED);
+    }
   }
 }
 
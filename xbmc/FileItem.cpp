@@ -2251,25 +2251,27 @@ void CFileItemList::Sort(SortDescription sortDescription)
     sortDescription.sortAttributes = (SortAttribute)((int)sortDescription.sortAttributes | SortAttributeIgnoreFolders);
 
   const Fields fields = SortUtils::GetFieldsForSorting(sortDescription.sortBy);
-  SortItems sortItems((size_t)Size());
+  DatabaseResults sortItems((size_t)Size());
   for (int index = 0; index < Size(); index++)
   {
-    sortItems[index] = std::shared_ptr<SortItem>(new SortItem);
-    m_items[index]->ToSortable(*sortItems[index], fields);
-    (*sortItems[index])[FieldId] = index;
+    m_items[index]->ToSortable(sortItems[index], fields);
+    sortItems[index][FieldId] = index;
   }
 
   // do the sorting
-  SortUtils::Sort(sortDescription, sortItems);
+  std::vector<size_t> order;
+  std::vector<std::wstring> sortLabels;
+  SortUtils::GetSortedOrder(sortDescription, sortItems, order, sortLabels);
 
   // apply the new order to the existing CFileItems
   VECFILEITEMS sortedFileItems;
-  sortedFileItems.reserve(Size());
-  for (SortItems::const_iterator it = sortItems.begin(); it != sortItems.end(); it++)
+  sortedFileItems.reserve(order.size());
+  for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
   {
-    CFileItemPtr item = m_items[(int)(*it)->at(FieldId).asInteger()];
+    CFileItemPtr item = m_items[*it];
     // Set the sort label in the CFileItem
-    item->SetSortLabel((*it)->at(FieldSort).asWideString());
+    if (!sortLabels.empty())
+      item->SetSortLabel(sortLabels[*it]);
 
     sortedFileItems.push_back(item);
   }
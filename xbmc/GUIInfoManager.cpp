@@ -6932,6 +6932,23 @@ void CGUIInfoManager::ResetCache()
   ++m_refreshCounter;
 }
 
+const std::atomic<unsigned int>* CGUIInfoManager::GetChangeStamp(int condition) const
+{
+  int info = std::abs(condition);
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+  {
+    const size_t index = info - MULTI_INFO_START;
+    if (index >= m_multiInfo.size())
+      return nullptr;
+    info = m_multiInfo[index].m_info;
+  }
+
+  if (info >= LISTITEM_START && info < LISTITEM_END)
+    return nullptr;
+
+  return m_infoProviders.GetChanges().GetStamp(info);
+}
+
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
 {
   m_currentFile->SetFromVideoInfoTag(tag);
@@ -19,6 +19,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -103,6 +104,13 @@ public:
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
+  /*! \brief Get the change stamp of the info behind a condition
+   \param condition the condition as returned by TranslateSingleString
+   \return the stamp, or nullptr if changes of the info are not announced by its provider
+   \sa KODI::GUILIB::GUIINFO::CGUIInfoChanges
+   */
+  const std::atomic<unsigned int>* GetChangeStamp(int condition) const;
+
   std::string GetLabel(int info, int contextWindow = 0, std::string *fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
   bool GetInt(int &value, int info, int contextWindow = 0, const CGUIListItem *item = nullptr) const;
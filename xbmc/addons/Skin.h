@@ -28,6 +28,7 @@
 #include "addons/Addon.h"
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 #include "guilib/GUIIncludes.h"    // needed for the GUIInclude member
+#include "guilib/GUIXMLCache.h"
 
 #define CREDIT_LINE_LENGTH 50
 
@@ -166,6 +167,10 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Cache for the window xml files of this skin
+   */
+  CGUIXMLCache& GetXMLCache() { return m_xmlCache; }
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
@@ -237,12 +242,15 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIXMLCache m_xmlCache{m_includes};
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
   bool m_debugging;
 
 private:
+  void OnSettingsChanged();
+
   std::map<int, CSkinSettingStringPtr> m_strings;
   std::map<int, CSkinSettingBoolPtr> m_bools;
   std::unique_ptr<CSkinSettingUpdateHandler> m_settingsUpdateHandler;
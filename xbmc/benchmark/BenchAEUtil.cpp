@@ -0,0 +1,134 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// one period of 7.1 float audio at 192 kHz as mixed by ActiveAE
+namespace
+{
+const int planes = 8;
+const int samples = 4096;
+
+class CKernelSetScope
+{
+public:
+  explicit CKernelSetScope(benchmark::State& state) : m_previous(CAEUtil::GetKernelSet())
+  {
+    AEKernelSet set = static_cast<AEKernelSet>(state.range(0));
+    m_valid = CAEUtil::SetKernelSet(set);
+    if (!m_valid)
+      state.SkipWithError("kernel set not supported by this cpu");
+  }
+  ~CKernelSetScope()
+  {
+    CAEUtil::SetKernelSet(m_previous);
+  }
+  bool IsValid() const { return m_valid; }
+
+private:
+  AEKernelSet m_previous;
+  bool m_valid;
+};
+
+std::vector<std::vector<float>> CreatePlanes(float scale)
+{
+  std::vector<std::vector<float>> data(planes, std::vector<float>(samples));
+  for (int p = 0; p < planes; ++p)
+  {
+    for (int i = 0; i < samples; ++i)
+      data[p][i] = scale * std::sin((i + p) * 0.01f);
+  }
+  return data;
+}
+}
+
+static void AEUtil_MulArray(benchmark::State& state)
+{
+  CKernelSetScope scope(state);
+  std::vector<std::vector<float>> data = CreatePlanes(1.0f);
+  for (auto _ : state)
+  {
+    if (!scope.IsValid())
+      break;
+    for (int p = 0; p < planes; ++p)
+      CAEUtil::MulArray(data[p].data(), 0.999f, samples);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * planes * samples);
+}
+BENCHMARK(AEUtil_MulArray)->DenseRange(AE_KERNELS_GENERIC, AE_KERNELS_NEON);
+
+static void AEUtil_MulAddArray(benchmark::State& state)
+{
+  CKernelSetScope scope(state);
+  std::vector<std::vector<float>> data = CreatePlanes(0.0f);
+  std::vector<std::vector<float>> add = CreatePlanes(0.5f);
+  for (auto _ : state)
+  {
+    if (!scope.IsValid())
+      break;
+    bool clip = false;
+    for (int p = 0; p < planes; ++p)
+      clip |= CAEUtil::MulAddArray(data[p].data(), add[p].data(), 0.001f, samples);
+    benchmark::DoNotOptimize(clip);
+  }
+  state.SetItemsProcessed(state.iterations() * planes * samples);
+}
+BENCHMARK(AEUtil_MulAddArray)->DenseRange(AE_KERNELS_GENERIC, AE_KERNELS_NEON);
+
+static void AEUtil_ClampArray(benchmark::State& state)
+{
+  CKernelSetScope scope(state);
+  std::vector<std::vector<float>> data = CreatePlanes(1.5f);
+  for (auto _ : state)
+  {
+    if (!scope.IsValid())
+      break;
+    for (int p = 0; p < planes; ++p)
+      CAEUtil::ClampArray(data[p].data(), samples);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * planes * samples);
+}
+BENCHMARK(AEUtil_ClampArray)->DenseRange(AE_KERNELS_GENERIC, AE_KERNELS_NEON);
+
+static void AEUtil_InterleaveArray(benchmark::State& state)
+{
+  CKernelSetScope scope(state);
+  std::vector<std::vector<float>> data = CreatePlanes(1.0f);
+  std::vector<const float*> src;
+  for (const std::vector<float>& plane : data)
+    src.push_back(plane.data());
+  std::vector<float> dst(planes * samples);
+  for (auto _ : state)
+  {
+    if (!scope.IsValid())
+      break;
+    CAEUtil::InterleaveArray(dst.data(), src.data(), planes, samples);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * planes * samples);
+}
+BENCHMARK(AEUtil_InterleaveArray)->DenseRange(AE_KERNELS_GENERIC, AE_KERNELS_NEON);
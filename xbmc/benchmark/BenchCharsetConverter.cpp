@@ -0,0 +1,76 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/CharsetConverter.h"
+#include "BenchFixtures.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+std::string CreateText()
+{
+  // mix of ascii and multi-byte characters as found in tags and subtitles
+  std::string text;
+  for (unsigned int i = 0; i < 100; ++i)
+    text += CBenchFixtures::CreateTitle(i) + " \xc3\xa9t\xc3\xa9 \xc3\xbc\xc3\xb6\xc3\xa4 ";
+  return text;
+}
+}
+
+static void CharsetConverter_Utf8ToW(benchmark::State& state)
+{
+  std::string text = CreateText();
+  for (auto _ : state)
+  {
+    std::wstring result;
+    benchmark::DoNotOptimize(g_charsetConverter.utf8ToW(text, result, false));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(CharsetConverter_Utf8ToW);
+
+static void CharsetConverter_WToUtf8(benchmark::State& state)
+{
+  std::wstring text;
+  g_charsetConverter.utf8ToW(CreateText(), text, false);
+  for (auto _ : state)
+  {
+    std::string result;
+    benchmark::DoNotOptimize(g_charsetConverter.wToUTF8(text, result));
+  }
+  state.SetItemsProcessed(state.iterations() * text.size());
+}
+BENCHMARK(CharsetConverter_WToUtf8);
+
+static void CharsetConverter_Latin1ToUtf8(benchmark::State& state)
+{
+  std::string text;
+  g_charsetConverter.utf8To("ISO-8859-1", CreateText(), text);
+  for (auto _ : state)
+  {
+    std::string result;
+    benchmark::DoNotOptimize(g_charsetConverter.ToUtf8("ISO-8859-1", text, result));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(CharsetConverter_Latin1ToUtf8);
@@ -0,0 +1,132 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "BenchFixtures.h"
+
+#include "FileItem.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+
+namespace
+{
+const char* const words[] = {
+  "Silent", "Garden", "Night", "Return", "Empire", "Shadow", "Ocean", "Last",
+  "Winter", "Machine", "Kingdom", "Stranger", "Island", "Fire", "Journey", "Storm",
+  "Dream", "Hunter", "River", "Ghost", "Velvet", "Zero", "Crystal", "Iron"
+};
+const unsigned int wordCount = sizeof(words) / sizeof(words[0]);
+
+const char* const genres[] = {
+  "Action", "Adventure", "Comedy", "Drama", "Fantasy", "Horror", "Thriller", "Science Fiction"
+};
+const unsigned int genreCount = sizeof(genres) / sizeof(genres[0]);
+
+// small LCG so that the fixtures don't depend on the standard library implementation
+unsigned int Next(unsigned int &state)
+{
+  state = state * 1103515245u + 12345u;
+  return (state >> 16) & 0x7fff;
+}
+}
+
+std::string CBenchFixtures::CreateTitle(unsigned int index)
+{
+  unsigned int state = index + 1;
+  std::string title;
+  if (Next(state) % 4 == 0)
+    title = "The ";
+  unsigned int numWords = 1 + Next(state) % 3;
+  for (unsigned int i = 0; i < numWords; ++i)
+  {
+    if (i > 0)
+      title += " ";
+    title += words[Next(state) % wordCount];
+  }
+  if (Next(state) % 5 == 0)
+    title += StringUtils::Format(" %u", 2 + Next(state) % 10);
+  return title;
+}
+
+void CBenchFixtures::CreateFileItemList(CFileItemList &items, int count)
+{
+  items.Clear();
+  items.SetPath("smb://server/share/Movies/");
+  items.Reserve(count);
+
+  unsigned int state = 42;
+  for (int i = 0; i < count; ++i)
+  {
+    std::string title = CreateTitle(i);
+    CFileItemPtr item;
+    if (i % 10 == 0)
+      item.reset(new CFileItem("smb://server/share/Movies/" + title + "/", true));
+    else
+    {
+      item.reset(new CFileItem("smb://server/share/Movies/" + title + StringUtils::Format(" (%d).mkv", 1950 + i % 70), false));
+      item->m_dwSize = static_cast<int64_t>(Next(state)) * 1024 * 1024;
+    }
+    item->SetLabel(title);
+    item->m_dateTime = CDateTime(2000 + Next(state) % 18, 1 + Next(state) % 12, 1 + Next(state) % 28,
+                                 Next(state) % 24, Next(state) % 60, Next(state) % 60);
+    items.Add(item);
+  }
+}
+
+CVariant CBenchFixtures::CreateMovieList(int count)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  CVariant &movies = result["movies"];
+  movies = CVariant(CVariant::VariantTypeArray);
+
+  unsigned int state = 42;
+  for (int i = 0; i < count; ++i)
+  {
+    std::string title = CreateTitle(i);
+    CVariant movie(CVariant::VariantTypeObject);
+    movie["movieid"] = i + 1;
+    movie["label"] = title;
+    movie["title"] = title;
+    movie["year"] = 1950 + i % 70;
+    movie["rating"] = (Next(state) % 100) / 10.0;
+    movie["playcount"] = Next(state) % 3;
+    movie["file"] = "smb://server/share/Movies/" + title + ".mkv";
+    movie["plot"] = "A " + std::string(words[Next(state) % wordCount]) + " stranger arrives in a small town where "
+                    "nothing is quite what it seems, and everybody has something to hide.";
+    CVariant genre(CVariant::VariantTypeArray);
+    genre.push_back(genres[Next(state) % genreCount]);
+    genre.push_back(genres[Next(state) % genreCount]);
+    movie["genre"] = genre;
+    movie["art"]["poster"] = "image://smb%3a%2f%2fserver%2fshare%2fMovies%2fposter.jpg/";
+    movie["art"]["fanart"] = "image://smb%3a%2f%2fserver%2fshare%2fMovies%2ffanart.jpg/";
+    movies.push_back(movie);
+  }
+
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = count;
+  result["limits"]["total"] = count;
+  return result;
+}
+
+std::string CBenchFixtures::CreateMovieListJSON(int count)
+{
+  std::string json;
+  CJSONVariantWriter::Write(CreateMovieList(count), json, true);
+  return json;
+}
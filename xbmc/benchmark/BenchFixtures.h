@@ -0,0 +1,58 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "utils/Variant.h"
+
+class CFileItemList;
+
+/*!
+ \brief Deterministic data sets shared by the benchmarks.
+
+ All fixtures are generated from a fixed seed, so every run of every build
+ works on the same data and results can be compared between builds.
+ */
+class CBenchFixtures
+{
+public:
+  /*!
+   \brief Create a movie title like "The Silent Garden 2".
+   \param index selects the title, the same index always results in the same title
+   */
+  static std::string CreateTitle(unsigned int index);
+
+  /*!
+   \brief Fill the list with items resembling the listing of a large movie share.
+   Every tenth item is a folder, files have a size and a date.
+   */
+  static void CreateFileItemList(CFileItemList &items, int count);
+
+  /*!
+   \brief Create a result resembling a VideoLibrary.GetMovies response.
+   */
+  static CVariant CreateMovieList(int count);
+
+  /*!
+   \brief Serialize CreateMovieList() to compact JSON.
+   */
+  static std::string CreateMovieListJSON(int count);
+};
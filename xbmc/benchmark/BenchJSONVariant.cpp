@@ -0,0 +1,54 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+#include "BenchFixtures.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+static void JSONVariant_Parse(benchmark::State& state)
+{
+  std::string json = CBenchFixtures::CreateMovieListJSON(state.range(0));
+  for (auto _ : state)
+  {
+    CVariant result;
+    benchmark::DoNotOptimize(CJSONVariantParser::Parse(json, result));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(JSONVariant_Parse)->Arg(100)->Arg(10000);
+
+static void JSONVariant_Write(benchmark::State& state)
+{
+  CVariant movies = CBenchFixtures::CreateMovieList(state.range(0));
+  size_t size = 0;
+  for (auto _ : state)
+  {
+    std::string json;
+    benchmark::DoNotOptimize(CJSONVariantWriter::Write(movies, json, state.range(1) != 0));
+    size = json.size();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(JSONVariant_Write)->Args({100, 1})->Args({10000, 1})->Args({10000, 0});
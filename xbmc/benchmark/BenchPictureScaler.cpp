@@ -0,0 +1,66 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "pictures/PictureScaler.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// the luma plane of a 1080p frame as decoded for a video thumbnail
+namespace
+{
+const unsigned int width = 1920;
+const unsigned int height = 1080;
+
+std::vector<uint8_t> CreatePlane()
+{
+  std::vector<uint8_t> plane(width * height);
+  for (size_t i = 0; i < plane.size(); ++i)
+    plane[i] = static_cast<uint8_t>(i * 7);
+  return plane;
+}
+}
+
+static void PictureScaler_HalvePlaneGeneric(benchmark::State& state)
+{
+  std::vector<uint8_t> src = CreatePlane();
+  std::vector<uint8_t> dst(width / 2 * height / 2);
+  for (auto _ : state)
+  {
+    CPictureScaler::HalvePlaneGeneric(src.data(), width, width, height, dst.data(), width / 2, 1);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(PictureScaler_HalvePlaneGeneric);
+
+static void PictureScaler_HalvePlane(benchmark::State& state)
+{
+  std::vector<uint8_t> src = CreatePlane();
+  std::vector<uint8_t> dst(width / 2 * height / 2);
+  for (auto _ : state)
+  {
+    CPictureScaler::HalvePlane(src.data(), width, width, height, dst.data(), width / 2, 1);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(PictureScaler_HalvePlane);
@@ -0,0 +1,91 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/RegExp.h"
+#include "BenchFixtures.h"
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// default tvshow episode matching expressions from CAdvancedSettings
+const char* const episodeExpressions[] = {
+  "s([0-9]+)[ ._x-]*e([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+  "[\\._ -]()[Ee][Pp]_?([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$",
+  "([0-9]{4})[\\.-]([0-9]{2})[\\.-]([0-9]{2})",
+  "[\\\\/\\._ \\[\\(-]([0-9]+)x([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)([^\\\\/]*)$"
+};
+
+std::vector<std::string> CreateFileNames()
+{
+  std::vector<std::string> names;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    std::string title = CBenchFixtures::CreateTitle(i);
+    if (i % 2)
+      names.push_back("smb://server/share/TV Shows/" + title + "/Season 1/" + title + ".s01e" + std::to_string(i % 24 + 1) + ".720p.mkv");
+    else
+      names.push_back("smb://server/share/TV Shows/" + title + "/" + title + " 1x" + std::to_string(i % 24 + 1) + ".avi");
+  }
+  return names;
+}
+}
+
+static void RegExp_Compile(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    CRegExp reg(true, CRegExp::autoUtf8);
+    benchmark::DoNotOptimize(reg.RegComp(episodeExpressions[0]));
+  }
+}
+BENCHMARK(RegExp_Compile);
+
+static void RegExp_MatchEpisodes(benchmark::State& state)
+{
+  std::vector<CRegExp> expressions;
+  for (const char* expression : episodeExpressions)
+  {
+    CRegExp reg(true, CRegExp::autoUtf8);
+    reg.RegComp(expression, CRegExp::StudyRegExp);
+    expressions.push_back(reg);
+  }
+  std::vector<std::string> names = CreateFileNames();
+
+  for (auto _ : state)
+  {
+    for (const std::string& name : names)
+    {
+      for (CRegExp& reg : expressions)
+      {
+        if (reg.RegFind(name) >= 0)
+        {
+          benchmark::DoNotOptimize(reg.GetMatch(1));
+          break;
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(RegExp_MatchEpisodes);
@@ -0,0 +1,66 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "utils/DatabaseUtils.h"
+#include "utils/SortUtils.h"
+#include "BenchFixtures.h"
+
+#include <benchmark/benchmark.h>
+
+static void SortUtils_SortItems(benchmark::State& state)
+{
+  SortItems items;
+  for (int i = 0; i < state.range(0); ++i)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldTitle] = CBenchFixtures::CreateTitle(i);
+    (*item)[FieldLabel] = (*item)[FieldTitle];
+    (*item)[FieldYear] = 1950 + i % 70;
+    items.push_back(item);
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    SortItems sorted(items);
+    state.ResumeTiming();
+    SortUtils::Sort(static_cast<SortBy>(state.range(1)), SortOrderAscending, SortAttributeIgnoreArticle, sorted);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SortUtils_SortItems)->Args({10000, SortByTitle})->Args({10000, SortByYear});
+
+static void FileItemList_Sort(benchmark::State& state)
+{
+  CFileItemList items;
+  CBenchFixtures::CreateFileItemList(items, state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    CFileItemList sorted;
+    sorted.Copy(items);
+    state.ResumeTiming();
+    sorted.Sort(static_cast<SortBy>(state.range(1)), SortOrderAscending);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(FileItemList_Sort)->Args({10000, SortByLabel})->Args({10000, SortByDate})->Args({10000, SortBySize});
@@ -0,0 +1,115 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/StringUtils.h"
+#include "BenchFixtures.h"
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+static void StringUtils_Format(benchmark::State& state)
+{
+  std::string title = CBenchFixtures::CreateTitle(1);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Format("%s - S%02dE%02d (%.1f) [%s]", title.c_str(), 3, 14, 7.5, "1080p"));
+}
+BENCHMARK(StringUtils_Format);
+
+static void StringUtils_ToLower(benchmark::State& state)
+{
+  std::string title = "smb://SERVER/Share/Movies/" + CBenchFixtures::CreateTitle(1) + ".MKV";
+  for (auto _ : state)
+  {
+    std::string str = title;
+    StringUtils::ToLower(str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(StringUtils_ToLower);
+
+static void StringUtils_EqualsNoCase(benchmark::State& state)
+{
+  std::string left = CBenchFixtures::CreateTitle(7);
+  std::string right = left;
+  StringUtils::ToUpper(right);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::EqualsNoCase(left, right));
+}
+BENCHMARK(StringUtils_EqualsNoCase);
+
+static void StringUtils_Split(benchmark::State& state)
+{
+  std::string path = "smb://server/share/Movies/Collections/Science Fiction/" + CBenchFixtures::CreateTitle(3) + "/movie.mkv";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Split(path, "/"));
+}
+BENCHMARK(StringUtils_Split);
+
+static void StringUtils_Join(benchmark::State& state)
+{
+  std::vector<std::string> strings;
+  for (int i = 0; i < state.range(0); ++i)
+    strings.push_back(CBenchFixtures::CreateTitle(i));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Join(strings, " / "));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(StringUtils_Join)->Arg(10)->Arg(1000);
+
+static void StringUtils_Replace(benchmark::State& state)
+{
+  std::string path = "smb://server/share/Movies/Collections/Science Fiction/" + CBenchFixtures::CreateTitle(3) + "/movie.mkv";
+  for (auto _ : state)
+  {
+    std::string str = path;
+    benchmark::DoNotOptimize(StringUtils::Replace(str, "/", "\\"));
+  }
+}
+BENCHMARK(StringUtils_Replace);
+
+static void StringUtils_Trim(benchmark::State& state)
+{
+  std::string title = " \t  " + CBenchFixtures::CreateTitle(5) + "  \r\n";
+  for (auto _ : state)
+  {
+    std::string str = title;
+    benchmark::DoNotOptimize(StringUtils::Trim(str));
+  }
+}
+BENCHMARK(StringUtils_Trim);
+
+static void StringUtils_AlphaNumericCompare(benchmark::State& state)
+{
+  std::vector<std::wstring> titles;
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::string title = CBenchFixtures::CreateTitle(i);
+    titles.push_back(std::wstring(title.begin(), title.end()));
+  }
+  for (auto _ : state)
+  {
+    for (size_t i = 1; i < titles.size(); ++i)
+      benchmark::DoNotOptimize(StringUtils::AlphaNumericCompare(titles[i - 1].c_str(), titles[i].c_str()));
+  }
+  state.SetItemsProcessed(state.iterations() * (titles.size() - 1));
+}
+BENCHMARK(StringUtils_AlphaNumericCompare);
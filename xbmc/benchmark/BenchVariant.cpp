@@ -0,0 +1,82 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/Variant.h"
+#include "BenchFixtures.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+static void Variant_Build(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(CBenchFixtures::CreateMovieList(state.range(0)));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Variant_Build)->Arg(100)->Arg(10000);
+
+static void Variant_Copy(benchmark::State& state)
+{
+  CVariant movies = CBenchFixtures::CreateMovieList(state.range(0));
+  for (auto _ : state)
+  {
+    CVariant copy(movies);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Variant_Copy)->Arg(100)->Arg(10000);
+
+static void Variant_Lookup(benchmark::State& state)
+{
+  const CVariant movies = CBenchFixtures::CreateMovieList(1000)["movies"];
+  for (auto _ : state)
+  {
+    for (CVariant::const_iterator_array it = movies.begin_array(); it != movies.end_array(); ++it)
+    {
+      benchmark::DoNotOptimize((*it)["label"].asString());
+      benchmark::DoNotOptimize((*it)["year"].asInteger());
+      benchmark::DoNotOptimize((*it)["art"]["poster"].asString());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * movies.size());
+}
+BENCHMARK(Variant_Lookup);
+
+static void Variant_ObjectMembers(benchmark::State& state)
+{
+  // a typical JSON-RPC item: a few dozen short keys added out of order
+  std::vector<std::string> keys;
+  for (int i = 0; i < state.range(0); ++i)
+    keys.push_back("property" + std::to_string((i * 7) % state.range(0)));
+
+  for (auto _ : state)
+  {
+    CVariant object(CVariant::VariantTypeObject);
+    for (const auto& key : keys)
+      object[key] = 1;
+    for (const auto& key : keys)
+      benchmark::DoNotOptimize(object.isMember(key));
+    benchmark::DoNotOptimize(object);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Variant_ObjectMembers)->Arg(8)->Arg(32)->Arg(256);
@@ -0,0 +1,90 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Application.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/SpecialProtocol.h"
+#include "platform/Filesystem.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/Settings.h"
+#include "utils/CharsetConverter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+
+#include <benchmark/benchmark.h>
+
+namespace fs = KODI::PLATFORM::FILESYSTEM;
+
+/* Sets up the same minimal environment as TestBasicEnvironment, the
+ * utilities rely on settings and special paths being available.
+ */
+static bool SetUp(std::string &tempPath)
+{
+  g_advancedSettings.Initialize();
+
+  g_application.m_ServiceManager.reset(new CServiceManager());
+  g_application.EnablePlatformDirectories(false);
+
+  std::error_code ec;
+  tempPath = fs::create_temp_directory(ec);
+  if (ec)
+    return false;
+
+  CSpecialProtocol::SetTempPath(tempPath);
+  CSpecialProtocol::SetProfilePath(tempPath);
+
+  if (!g_application.m_ServiceManager->InitForTesting())
+    return false;
+
+  CServiceBroker::GetSettings().Initialize();
+  g_charsetConverter.reset();
+  return true;
+}
+
+static void TearDown(const std::string &tempPath)
+{
+  XFILE::CDirectory::RemoveRecursive(tempPath);
+
+  CServiceBroker::GetSettings().Uninitialize();
+  g_application.m_ServiceManager->DeinitTesting();
+}
+
+int main(int argc, char **argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return EXIT_FAILURE;
+
+  std::string tempPath;
+  if (!SetUp(tempPath))
+  {
+    fprintf(stderr, "Setup of basic environment failed.\n");
+    exit(EXIT_FAILURE);
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  TearDown(tempPath);
+  return 0;
+}
@@ -25,20 +25,35 @@ using namespace ActiveAE;
 #include "ActiveAESettings.h"
 #include "ActiveAESound.h"
 #include "ActiveAEStream.h"
+#include "ActiveAEWorkerPool.h"
 #include "ServiceBroker.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 
+#include "cores/DataCacheCore.h"
 #include "settings/Settings.h"
 #include "windowing/WinSystem.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 #define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
 #define MAX_WATER_LEVEL 0.2   // buffered time after stream stages in seconds
 #define MAX_BUFFER_TIME 0.1   // max time of a buffer in seconds
 
+// low latency mode, levels grow in steps towards the defaults on underruns
+#define LOW_LATENCY_CACHE_LEVEL 0.06
+#define LOW_LATENCY_WATER_LEVEL 0.04
+#define LOW_LATENCY_BUFFER_TIME 0.02
+#define LOW_LATENCY_STEP        0.02
+#define LOW_LATENCY_RELAX_TIME  60000 // ms without underrun before levels are reduced again
+#define LATENCY_UPDATE_INTERVAL 500   // ms
+
+#define MAX_PROCESSING_WORKERS 3      // threads helping with stream processing
+
 void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
 {
   CSingleLock lock(m_lock);
@@ -87,6 +102,7 @@ void CEngineStats::AddStream(unsigned int streamid)
   StreamStats stream;
   stream.m_streamId = streamid;
   stream.m_bufferedTime = 0;
+  stream.m_processingTime = 0;
   stream.m_resampleRatio = 1.0;
   stream.m_syncError = 0;
   stream.m_syncState = CAESyncInfo::AESyncState::SYNC_OFF;
@@ -124,6 +140,7 @@ void CEngineStats::UpdateStream(CActiveAEStream *stream)
       {
         str.m_resampleRatio = 1.0;
       }
+      str.m_processingTime = delay;
 
       CSingleLock lock(stream->m_statsLock);
       std::deque<CSampleBuffer*>::iterator itBuf;
@@ -214,12 +231,14 @@ float CEngineStats::GetCacheTime(CActiveAEStream *stream)
 
 float CEngineStats::GetCacheTotal()
 {
-  return MAX_CACHE_LEVEL;
+  CSingleLock lock(m_lock);
+  return m_cacheLevel;
 }
 
 float CEngineStats::GetMaxDelay()
 {
-  return MAX_CACHE_LEVEL + MAX_WATER_LEVEL + m_sinkCacheTotal;
+  CSingleLock lock(m_lock);
+  return m_cacheLevel + m_waterLevel + m_sinkCacheTotal;
 }
 
 float CEngineStats::GetWaterLevel()
@@ -231,6 +250,57 @@ float CEngineStats::GetWaterLevel()
     return (float)m_bufferedSamples * m_sinkFormat.m_streamInfo.GetDuration() / 1000;
 }
 
+float CEngineStats::GetMaxWaterLevel()
+{
+  CSingleLock lock(m_lock);
+  return m_waterLevel;
+}
+
+void CEngineStats::SetBufferLevels(float cacheLevel, float waterLevel)
+{
+  CSingleLock lock(m_lock);
+  m_cacheLevel = cacheLevel;
+  m_waterLevel = waterLevel;
+}
+
+void CEngineStats::AddSinkUnderrun()
+{
+  CSingleLock lock(m_lock);
+  m_sinkUnderruns++;
+}
+
+unsigned int CEngineStats::GetSinkUnderruns()
+{
+  CSingleLock lock(m_lock);
+  return m_sinkUnderruns;
+}
+
+void CEngineStats::GetLatency(AELatencyInfo& info, CActiveAEStream *stream)
+{
+  CSingleLock lock(m_lock);
+  info = AELatencyInfo();
+  if (m_pcmOutput)
+    info.engine = (double)m_bufferedSamples / m_sinkSampleRate;
+  else
+    info.engine = (double)m_bufferedSamples * m_sinkFormat.m_streamInfo.GetDuration() / 1000;
+  info.sink = m_sinkDelay.GetDelay();
+  info.device = m_sinkLatency;
+
+  if (!stream)
+    return;
+
+  for (auto &str : m_streamStats)
+  {
+    if (str.m_streamId == stream->m_id)
+    {
+      CSingleLock lock(stream->m_statsLock);
+      info.stream = (str.m_bufferedTime - str.m_processingTime + stream->m_bufferedTime) / str.m_resampleRatio;
+      info.processing = str.m_processingTime / str.m_resampleRatio;
+      return;
+    }
+  }
+}
+
 void CEngineStats::SetSuspended(bool state)
 {
   CSingleLock lock(m_lock);
@@ -276,6 +346,9 @@ CActiveAE::CActiveAE() :
   m_vizInitialized = false;
   m_sinkHasVolume = false;
   m_aeGUISoundForce = false;
+  m_stats.SetBufferLevels(MAX_CACHE_LEVEL, MAX_WATER_LEVEL);
+  int cpus = g_cpuInfo.getCPUCount();
+  m_workerPool.reset(new CActiveAEWorkerPool(std::min(std::max(cpus - 1, 0), MAX_PROCESSING_WORKERS)));
   m_stats.Reset(44100, true);
   m_streamIdGen = 0;
 
@@ -759,21 +832,6 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
           else
             msg->Reply(CActiveAEDataProtocol::ERR);
           return;
-        case CActiveAEDataProtocol::STREAMSAMPLE:
-          MsgStreamSample *msgData;
-          CSampleBuffer *samples;
-          msgData = reinterpret_cast<MsgStreamSample*>(msg->data);
-          samples = msgData->stream->m_processingSamples.front();
-          msgData->stream->m_processingSamples.pop_front();
-          if (samples != msgData->buffer)
-            CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample message");
-          if (msgData->buffer->pkt->nb_samples == 0)
-            msgData->buffer->Return();
-          else
-            msgData->stream->m_processingBuffers->m_inputSamples.push_back(msgData->buffer);
-          m_extTimeout = 0;
-          m_state = AE_TOP_CONFIGURED_PLAY;
-          return;
         case CActiveAEDataProtocol::FREESTREAM:
           stream = *(CActiveAEStream**)msg->data;
           DiscardStream(stream);
@@ -1045,6 +1103,11 @@ void CActiveAE::Process()
         gotMsg = true;
         port = &m_dataPort;
       }
+      // samples of streams, same as a message in the configured states
+      else if (m_state >= AE_TOP_CONFIGURED && ReceiveStreamSamples())
+      {
+        continue;
+      }
       // stream data ports
       else
       {
@@ -1145,7 +1208,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   CAESinkFactory::ParseDevice(device, driver);
   if ((!CompareFormat(m_sinkRequestFormat, m_sinkFormat) && !CompareFormat(m_sinkRequestFormat, oldSinkRequestFormat)) ||
       m_currDevice.compare(device) != 0 ||
-      m_settings.driver.compare(driver) != 0)
+      m_settings.driver.compare(driver) != 0 ||
+      m_settings.lowLatency != m_sinkLowLatency)
   {
     FlushEngine();
     if (!InitSink())
@@ -1159,13 +1223,19 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
     if (m_sinkRequestFormat.m_dataFormat != AE_FMT_RAW)
     {
       // limit buffer size in case of sink returns large buffer
+      double maxbuffertime = m_sinkLowLatency ? LOW_LATENCY_BUFFER_TIME : MAX_BUFFER_TIME;
       double buffertime = (double)m_sinkFormat.m_frames / m_sinkFormat.m_sampleRate;
-      if (buffertime > MAX_BUFFER_TIME)
+      if (buffertime > maxbuffertime)
       {
-        CLog::Log(LOGWARNING, "ActiveAE::%s - sink returned large buffer of %d ms, reducing to %d ms", __FUNCTION__, (int)(buffertime * 1000), (int)(MAX_BUFFER_TIME*1000));
-        m_sinkFormat.m_frames = MAX_BUFFER_TIME * m_sinkFormat.m_sampleRate;
+        CLog::Log(LOGWARNING, "ActiveAE::%s - sink returned large buffer of %d ms, reducing to %d ms", __FUNCTION__, (int)(buffertime * 1000), (int)(maxbuffertime*1000));
+        m_sinkFormat.m_frames = maxbuffertime * m_sinkFormat.m_sampleRate;
       }
     }
+
+    if (m_sinkLowLatency && m_mode == MODE_PCM)
+      SetBufferLevels(LOW_LATENCY_CACHE_LEVEL, LOW_LATENCY_WATER_LEVEL);
+    else
+      SetBufferLevels(MAX_CACHE_LEVEL, MAX_WATER_LEVEL);
   }
 
   if (m_silenceBuffers)
@@ -1502,6 +1572,9 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   }
   stream->m_processingBuffers->Flush();
   stream->m_streamPort->Purge();
+  // the stream is blocked in FlushStream, both queues are idle
+  stream->m_streamBuffers.Clear();
+  stream->m_streamSamples.Clear();
   stream->m_bufferedTime = 0.0;
   stream->m_paused = false;
   stream->m_syncState = CAESyncInfo::AESyncState::SYNC_START;
@@ -1517,6 +1590,34 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   m_stats.UpdateStream(stream);
 }
 
+bool CActiveAE::ReceiveStreamSamples()
+{
+  bool received = false;
+  for (auto stream : m_streams)
+  {
+    CSampleBuffer *buffer;
+    while ((buffer = stream->m_streamSamples.Pop()) != NULL)
+    {
+      CSampleBuffer *samples = stream->m_processingSamples.front();
+      stream->m_processingSamples.pop_front();
+      if (samples != buffer)
+        CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream samples");
+      if (buffer->pkt->nb_samples == 0)
+        buffer->Return();
+      else
+        stream->m_processingBuffers->m_inputSamples.push_back(buffer);
+      received = true;
+    }
+  }
+
+  if (received)
+  {
+    m_extTimeout = 0;
+    m_state = AE_TOP_CONFIGURED_PLAY;
+  }
+  return received;
+}
+
 void CActiveAE::FlushEngine()
 {
   if (m_sinkBuffers)
@@ -1739,7 +1840,8 @@ bool CActiveAE::NeedReconfigureSink()
 
   if (!CompareFormat(newFormat, m_sinkFormat) ||
       m_currDevice.compare(device) != 0 ||
-      m_settings.driver.compare(driver) != 0)
+      m_settings.driver.compare(driver) != 0 ||
+      m_settings.lowLatency != m_sinkLowLatency)
     return true;
 
   return false;
@@ -1749,6 +1851,10 @@ bool CActiveAE::InitSink()
 {
   SinkConfig config;
   config.format = m_sinkRequestFormat;
+  // a period size is only requested in low latency mode, sinks choose their own otherwise
+  config.format.m_frames = 0;
+  if (m_settings.lowLatency && m_sinkRequestFormat.m_dataFormat != AE_FMT_RAW)
+    config.format.m_frames = LOW_LATENCY_BUFFER_TIME * m_sinkRequestFormat.m_sampleRate;
   config.stats = &m_stats;
   config.device = (m_sinkRequestFormat.m_dataFormat == AE_FMT_RAW) ? &m_settings.passthroughdevice :
                                                                      &m_settings.device;
@@ -1782,6 +1888,7 @@ bool CActiveAE::InitSink()
       m_stats.SetCurrentSinkFormat(m_sinkFormat);
     }
     reply->Release();
+    m_sinkLowLatency = m_settings.lowLatency;
   }
   else
   {
@@ -1854,17 +1961,92 @@ void CActiveAE::UnconfigureSink()
 }
 
 
+void CActiveAE::SetBufferLevels(float cacheLevel, float waterLevel)
+{
+  m_stats.SetBufferLevels(cacheLevel, waterLevel);
+  m_latencyRelaxTimer.Set(LOW_LATENCY_RELAX_TIME);
+  CLog::Log(LOGDEBUG, "ActiveAE::%s - cache level %d ms, water level %d ms", __FUNCTION__,
+            (int)(cacheLevel * 1000), (int)(waterLevel * 1000));
+}
+
+void CActiveAE::UpdateLatency()
+{
+  CActiveAEStream *stream = nullptr;
+  for (auto str : m_streams)
+  {
+    if (str->m_started && !str->m_paused && !str->m_drain && !str->m_streamIsBuffering &&
+        str->m_syncState != CAESyncInfo::AESyncState::SYNC_START)
+    {
+      stream = str;
+      break;
+    }
+  }
+
+  // the sink had to fill in silence while a stream was playing
+  unsigned int sinkUnderruns = m_stats.GetSinkUnderruns();
+  if (stream && sinkUnderruns != m_sinkUnderruns)
+  {
+    m_underruns++;
+    float cacheLevel = m_stats.GetCacheTotal();
+    float waterLevel = m_stats.GetMaxWaterLevel();
+    if (m_sinkLowLatency && m_mode == MODE_PCM && waterLevel < MAX_WATER_LEVEL)
+    {
+      CLog::Log(LOGWARNING, "ActiveAE::%s - underrun in low latency mode, increasing buffers", __FUNCTION__);
+      SetBufferLevels(std::min(cacheLevel + LOW_LATENCY_STEP, MAX_CACHE_LEVEL),
+                      std::min(waterLevel + LOW_LATENCY_STEP, MAX_WATER_LEVEL));
+    }
+  }
+  m_sinkUnderruns = sinkUnderruns;
+
+  // give back the latency if we have been running without underruns for a while
+  if (m_sinkLowLatency && m_mode == MODE_PCM && m_latencyRelaxTimer.IsTimePast())
+  {
+    float cacheLevel = m_stats.GetCacheTotal();
+    float waterLevel = m_stats.GetMaxWaterLevel();
+    if (waterLevel > LOW_LATENCY_WATER_LEVEL)
+      SetBufferLevels(std::max(cacheLevel - LOW_LATENCY_STEP, LOW_LATENCY_CACHE_LEVEL),
+                      std::max(waterLevel - LOW_LATENCY_STEP, LOW_LATENCY_WATER_LEVEL));
+    else
+      m_latencyRelaxTimer.Set(LOW_LATENCY_RELAX_TIME);
+  }
+
+  if (!m_latencyUpdateTimer.IsTimePast())
+    return;
+  m_latencyUpdateTimer.Set(LATENCY_UPDATE_INTERVAL);
+
+  AELatencyInfo info;
+  m_stats.GetLatency(info, stream);
+  CDataCacheCore &dataCache = CServiceBroker::GetDataCacheCore();
+  dataCache.SetAudioLatency(info.stream, info.processing, info.engine, info.sink, info.device);
+  dataCache.SetAudioBufferState(m_sinkLowLatency && m_mode == MODE_PCM, m_underruns);
+}
+
 bool CActiveAE::RunStages()
 {
   bool busy = false;
 
+  UpdateLatency();
+  float cacheLevel = m_stats.GetCacheTotal();
+
+  // resample, remap and atempo of the streams are independent of each other,
+  // run them in parallel and only continue once all of them are done
+  m_processingStreams.clear();
+  for (auto stream : m_streams)
+  {
+    if (stream->m_processingBuffers && !stream->m_paused)
+      m_processingStreams.push_back(stream);
+  }
+  m_processingBusy.assign(m_processingStreams.size(), 0);
+  m_workerPool->Process(m_processingStreams.size(), [this](unsigned int i) {
+    m_processingBusy[i] = m_processingStreams[i]->m_processingBuffers->ProcessBuffers();
+  });
+  for (auto streamBusy : m_processingBusy)
+    busy |= (streamBusy != 0);
+
   // serve input streams
   std::list<CActiveAEStream*>::iterator it;
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
   {
-    if ((*it)->m_processingBuffers && !(*it)->m_paused)
-      busy = (*it)->m_processingBuffers->ProcessBuffers();
-
     if ((*it)->m_streamIsBuffering &&
         (*it)->m_processingBuffers &&
         ((*it)->m_processingBuffers->HasInputLevel(50)))
@@ -1881,14 +2063,20 @@ bool CActiveAE::RunStages()
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty())
+      // the queues can hold all buffers in flight
+      bool provided = false;
+      while ((time < cacheLevel || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty() &&
+             (*it)->m_processingSamples.size() < CSampleBufferQueue::CAPACITY)
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
-        (*it)->m_streamPort->SendInMessage(CActiveAEDataProtocol::STREAMBUFFER, &buffer, sizeof(CSampleBuffer*));
         (*it)->IncFreeBuffers();
+        (*it)->m_streamBuffers.Push(buffer);
+        provided = true;
         time += buftime;
       }
+      if (provided)
+        (*it)->m_inMsgEvent.Set();
     }
     else
     {
@@ -1920,7 +2108,7 @@ bool CActiveAE::RunStages()
     }
   }
 
-  if (m_stats.GetWaterLevel() < MAX_WATER_LEVEL &&
+  if (m_stats.GetWaterLevel() < m_stats.GetMaxWaterLevel() &&
      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
   {
     // calculate sync error
@@ -2070,15 +2258,7 @@ bool CActiveAE::RunStages()
 
               for(int j=0; j<out->pkt->planes; j++)
               {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
+                CAEUtil::MulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
               }
             }
           }
@@ -2139,24 +2319,8 @@ bool CActiveAE::RunStages()
               {
                 float *dst = (float*)out->pkt->data[j]+i*nb_floats;
                 float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                if (CAEUtil::MulAddArray(dst, src, volume, nb_floats))
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2535,12 +2699,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEUtil::MulAddArray(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2565,13 +2724,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEUtil::MulArray(buffer, volume, nb_floats);
     }
   }
 }
@@ -2607,6 +2760,7 @@ void CActiveAE::LoadSettings()
   m_settings.atempoThreshold = CServiceBroker::GetSettings().GetInt(CSettings::SETTING_AUDIOOUTPUT_ATEMPOTHRESHOLD) / 100.0;
   m_settings.streamNoise = CServiceBroker::GetSettings().GetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE);
   m_settings.silenceTimeout = CServiceBroker::GetSettings().GetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE) * 60000;
+  m_settings.lowLatency = CServiceBroker::GetSettings().GetBool(CSettings::SETTING_AUDIOOUTPUT_LOWLATENCY);
 }
 
 void CActiveAE::Start()
@@ -49,6 +49,7 @@ namespace ActiveAE
 class CActiveAESound;
 class CActiveAEStream;
 class CActiveAESettings;
+class CActiveAEWorkerPool;
 
 struct AudioSettings
 {
@@ -72,6 +73,7 @@ struct AudioSettings
   double atempoThreshold;
   bool streamNoise;
   int silenceTimeout;
+  bool lowLatency;
 };
 
 class CActiveAEControlProtocol : public Protocol
@@ -123,14 +125,12 @@ public:
     FREESOUND,
     NEWSTREAM,
     FREESTREAM,
-    STREAMSAMPLE,
     DRAINSTREAM,
   };
   enum InSignal
   {
     ACC,
     ERR,
-    STREAMBUFFER,
     STREAMDRAINED,
   };
 };
@@ -142,12 +142,6 @@ struct MsgStreamNew
   IAEClockCallback *clock;
 };
 
-struct MsgStreamSample
-{
-  CSampleBuffer *buffer;
-  CActiveAEStream *stream;
-};
-
 struct MsgStreamParameter
 {
   CActiveAEStream *stream;
@@ -175,6 +169,15 @@ struct MsgStreamFFmpegInfo
   enum AVAudioServiceType audio_service_type;
 };
 
+struct AELatencyInfo
+{
+  double stream = 0.0;      // queued in the stream, waiting for processing
+  double processing = 0.0;  // held by resampler and stream processing
+  double engine = 0.0;      // processed, queued for the sink
+  double sink = 0.0;        // buffered by the sink
+  double device = 0.0;      // reported latency of the output device
+};
+
 class CEngineStats
 {
 public:
@@ -191,15 +194,23 @@ public:
   float GetCacheTotal();
   float GetMaxDelay();
   float GetWaterLevel();
+  float GetMaxWaterLevel();
+  void SetBufferLevels(float cacheLevel, float waterLevel);
+  void GetLatency(AELatencyInfo& info, CActiveAEStream *stream);
   void SetSuspended(bool state);
   void SetCurrentSinkFormat(const AEAudioFormat& SinkFormat);
   void SetSinkCacheTotal(float time) { m_sinkCacheTotal = time; }
   void SetSinkLatency(float time) { m_sinkLatency = time; }
+  void AddSinkUnderrun();
+  unsigned int GetSinkUnderruns();
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
 protected:
   float m_sinkCacheTotal;
   float m_sinkLatency;
+  float m_cacheLevel = 0.0f;
+  float m_waterLevel = 0.0f;
+  unsigned int m_sinkUnderruns = 0;
   int m_bufferedSamples;
   unsigned int m_sinkSampleRate;
   AEDelayStatus m_sinkDelay;
@@ -211,6 +222,7 @@ protected:
   {
     unsigned int m_streamId;
     double m_bufferedTime;
+    double m_processingTime;
     double m_resampleRatio;
     double m_syncError;
     unsigned int m_errorTime;
@@ -304,12 +316,16 @@ protected:
   CActiveAEStream* CreateStream(MsgStreamNew *streamMsg);
   void DiscardStream(CActiveAEStream *stream);
   void SFlushStream(CActiveAEStream *stream);
+  bool ReceiveStreamSamples();
   void FlushEngine();
   void ClearDiscardedBuffers();
   void SStopSound(CActiveAESound *sound);
   void DiscardSound(CActiveAESound *sound);
   void ChangeResamplers();
 
+  void SetBufferLevels(float cacheLevel, float waterLevel);
+  void UpdateLatency();
+
   bool RunStages();
   bool HasWork();
   CSampleBuffer* SyncStream(CActiveAEStream *stream);
@@ -352,6 +368,11 @@ protected:
   AudioSettings m_settings;
   CEngineStats m_stats;
   IAEEncoder *m_encoder;
+  bool m_sinkLowLatency = false;
+  unsigned int m_sinkUnderruns = 0;
+  unsigned int m_underruns = 0;
+  XbmcThreads::EndTime m_latencyUpdateTimer;
+  XbmcThreads::EndTime m_latencyRelaxTimer;
   std::string m_currDevice;
   std::unique_ptr<CActiveAESettings> m_settingsHandler;
 
@@ -364,6 +385,9 @@ protected:
 
   // streams
   std::list<CActiveAEStream*> m_streams;
+  std::unique_ptr<CActiveAEWorkerPool> m_workerPool;
+  std::vector<CActiveAEStream*> m_processingStreams;
+  std::vector<char> m_processingBusy;
   std::list<CActiveAEBufferPool*> m_discardBufferPools;
   unsigned int m_streamIdGen;
 
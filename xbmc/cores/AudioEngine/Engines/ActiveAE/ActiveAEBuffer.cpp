@@ -61,11 +61,34 @@ CSampleBuffer* CSampleBuffer::Acquire()
 
 void CSampleBuffer::Return()
 {
-  refCount--;
-  if (pool && refCount <= 0)
+  if (--refCount <= 0 && pool)
     pool->ReturnBuffer(this);
 }
 
+CSampleBufferQueue::CSampleBufferQueue() : m_buffers(CAPACITY)
+{
+}
+
+bool CSampleBufferQueue::Push(CSampleBuffer *buffer)
+{
+  return m_buffers.Push(buffer);
+}
+
+CSampleBuffer* CSampleBufferQueue::Pop()
+{
+  CSampleBuffer *buffer;
+  if (!m_buffers.Pop(buffer))
+    return NULL;
+  return buffer;
+}
+
+void CSampleBufferQueue::Clear()
+{
+  CSampleBuffer *buffer;
+  while (m_buffers.Pop(buffer))
+    ;
+}
+
 CActiveAEBufferPool::CActiveAEBufferPool(const AEAudioFormat& format)
 {
   m_format = format;
@@ -21,6 +21,8 @@
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
+#include "threads/LockFreeQueue.h"
+#include <atomic>
 #include <deque>
 #include <memory>
 
@@ -73,7 +75,23 @@ public:
   CActiveAEBufferPool *pool;
   int64_t timestamp;
   int pkt_start_offset;
-  int refCount;
+  std::atomic_int refCount;
+};
+
+/**
+ * lock-free queue of sample buffers between a stream and the engine,
+ * hands buffers over without going through messages
+ */
+class CSampleBufferQueue
+{
+public:
+  static const unsigned int CAPACITY = 64;
+  CSampleBufferQueue();
+  bool Push(CSampleBuffer *buffer); // producer, false if full
+  CSampleBuffer *Pop(); // consumer, NULL if empty
+  void Clear(); // neither producer nor consumer must be active
+protected:
+  CLockFreeQueue<CSampleBuffer*> m_buffers;
 };
 
 class CActiveAEBufferPool
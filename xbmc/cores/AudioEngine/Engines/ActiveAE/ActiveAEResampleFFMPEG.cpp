@@ -34,6 +34,7 @@ CActiveAEResampleFFMPEG::CActiveAEResampleFFMPEG()
 {
   m_pContext = NULL;
   m_doesResample = false;
+  m_interleaveOnly = false;
 }
 
 CActiveAEResampleFFMPEG::~CActiveAEResampleFFMPEG()
@@ -175,6 +176,29 @@ bool CActiveAEResampleFFMPEG::Init(uint64_t dst_chan_layout, int dst_channels, i
     CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Init - init resampler failed");
     return false;
   }
+
+  // the sink stage mostly just converts planar float to interleaved float,
+  // this does not need the resampler
+  m_interleaveOnly = false;
+  if (m_src_fmt == AV_SAMPLE_FMT_FLTP && m_dst_fmt == AV_SAMPLE_FMT_FLT &&
+      m_src_rate == m_dst_rate && m_src_channels == m_dst_channels &&
+      !m_doesResample && !force_resample)
+  {
+    if (remapLayout)
+    {
+      m_interleaveOnly = true;
+      for (int out=0; out<m_dst_channels; out++)
+      {
+        for (int in=0; in<m_src_channels; in++)
+        {
+          if (m_rematrix[out][in] != (out == in ? 1.0 : 0.0))
+            m_interleaveOnly = false;
+        }
+      }
+    }
+    else
+      m_interleaveOnly = m_src_chan_layout == m_dst_chan_layout;
+  }
   return true;
 }
 
@@ -189,6 +213,14 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
     m_doesResample = true;
   }
 
+  if (m_interleaveOnly && !m_doesResample && src_buffer && src_samples <= dst_samples &&
+      swr_get_delay(m_pContext, m_src_rate) == 0)
+  {
+    CAEUtil::InterleaveArray(reinterpret_cast<float*>(dst_buffer[0]),
+                             reinterpret_cast<float**>(src_buffer), m_src_channels, src_samples);
+    return src_samples;
+  }
+
   if (m_doesResample)
   {
     if (swr_set_compensation(m_pContext, delta, distance) < 0)
@@ -51,6 +51,7 @@ public:
 protected:
   bool m_loaded;
   bool m_doesResample;
+  bool m_interleaveOnly;
   uint64_t m_src_chan_layout, m_dst_chan_layout;
   int m_src_rate, m_dst_rate;
   int m_src_channels, m_dst_channels;
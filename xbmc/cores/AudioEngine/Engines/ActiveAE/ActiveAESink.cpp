@@ -545,6 +545,9 @@ void CActiveAESink::StateMachine(int signal, Protocol *port, Message *msg)
         case CSinkControlProtocol::TIMEOUT:
           if (!m_extSilenceTimer.IsTimePast())
           {
+            // engine did not deliver in time, silence is played in between
+            if (m_extStreaming)
+              m_stats->AddSinkUnderrun();
             m_state = S_TOP_CONFIGURED_SILENCE;
             m_extTimeout = 0;
           }
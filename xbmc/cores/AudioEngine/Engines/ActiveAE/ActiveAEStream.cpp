@@ -251,6 +251,9 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
   {
     sourceFrames = frames - copied;
 
+    // retry samples the engine had no room for yet
+    PushPendingSamples();
+
     if (m_currentBuffer)
     {
       int start = m_currentBuffer->pkt->nb_samples *
@@ -309,33 +312,25 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
 
       if (m_currentBuffer->pkt->nb_samples == m_currentBuffer->pkt->max_nb_samples || rawPktComplete)
       {
-        MsgStreamSample msgData;
-        msgData.buffer = m_currentBuffer;
-        msgData.stream = this;
         RemapBuffer();
-        m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+        PushSamples(m_currentBuffer);
         m_currentBuffer = NULL;
       }
       continue;
     }
+    else if ((m_currentBuffer = m_streamBuffers.Pop()) != NULL)
+    {
+      m_currentBuffer->timestamp = 0;
+      m_currentBuffer->pkt->nb_samples = 0;
+      m_currentBuffer->pkt->pause_burst_ms = 0;
+      DecFreeBuffers();
+      continue;
+    }
     else if (m_streamPort->ReceiveInMessage(&msg))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        m_currentBuffer = *((CSampleBuffer**)msg->data);
-        m_currentBuffer->timestamp = 0;
-        m_currentBuffer->pkt->nb_samples = 0;
-        m_currentBuffer->pkt->pause_burst_ms = 0;
-        msg->Release();
-        DecFreeBuffers();
-        continue;
-      }
-      else
-      {
-        CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
-        msg->Release();
-        break;
-      }
+      CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
+      msg->Release();
+      break;
     }
     if (!m_inMsgEvent.WaitMSec(200))
       break;
@@ -343,6 +338,26 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
   return copied;
 }
 
+void CActiveAEStream::PushSamples(CSampleBuffer *buffer)
+{
+  // buffers are kept in order, the engine expects them in the order it provided them
+  m_pendingSamples.push_back(buffer);
+  if (!PushPendingSamples())
+    CLog::Log(LOGDEBUG, "CActiveAEStream::PushSamples - sample queue full, %d buffers pending", (int)m_pendingSamples.size());
+  m_activeAE->m_outMsgEvent.Set();
+}
+
+bool CActiveAEStream::PushPendingSamples()
+{
+  while (!m_pendingSamples.empty())
+  {
+    if (!m_streamSamples.Push(m_pendingSamples.front()))
+      return false;
+    m_pendingSamples.pop_front();
+  }
+  return true;
+}
+
 double CActiveAEStream::GetDelay()
 {
   AEDelayStatus status;
@@ -411,38 +426,41 @@ void CActiveAEStream::Drain(bool wait)
 
   if (m_currentBuffer)
   {
-    MsgStreamSample msgData;
-    msgData.buffer = m_currentBuffer;
-    msgData.stream = this;
     RemapBuffer();
-    m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+    PushSamples(m_currentBuffer);
     m_currentBuffer = NULL;
   }
 
   XbmcThreads::EndTime timer(2000);
   while (!timer.IsTimePast())
   {
-    if (m_streamPort->ReceiveInMessage(&msg))
+    if (!PushPendingSamples())
+      m_activeAE->m_outMsgEvent.Set();
+
+    // hand back empty buffers the engine provides while draining
+    CSampleBuffer *buffer = m_streamBuffers.Pop();
+    if (buffer)
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        MsgStreamSample msgData;
-        msgData.stream = this;
-        msgData.buffer = *((CSampleBuffer**)msg->data);
-        msg->Reply(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-        DecFreeBuffers();
-        continue;
-      }
-      else if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
-      {
-        msg->Release();
+      PushSamples(buffer);
+      DecFreeBuffers();
+      continue;
+    }
+    else if (m_streamPort->ReceiveInMessage(&msg))
+    {
+      bool drained = msg->signal == CActiveAEDataProtocol::STREAMDRAINED;
+      msg->Release();
+      if (drained)
         return;
-      }
+      continue;
     }
-    else if (!wait)
+    else if (!wait && m_pendingSamples.empty())
       return;
 
-    m_inMsgEvent.WaitMSec(timer.MillisLeft());
+    // the engine doesn't signal when it takes samples
+    if (m_pendingSamples.empty())
+      m_inMsgEvent.WaitMSec(timer.MillisLeft());
+    else
+      m_inMsgEvent.WaitMSec(std::min(timer.MillisLeft(), 10u));
   }
   CLog::Log(LOGERROR, "CActiveAEStream::Drain - timeout out");
 }
@@ -463,7 +481,9 @@ void CActiveAEStream::Flush()
 {
   if (!m_streamIsFlushed)
   {
+    // the engine returns all buffers it provided to the stream
     m_currentBuffer = NULL;
+    m_pendingSamples.clear();
     m_leftoverBytes = 0;
     m_activeAE->FlushStream(this);
     m_streamIsFlushed = true;
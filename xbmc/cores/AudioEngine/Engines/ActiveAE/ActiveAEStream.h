@@ -22,6 +22,7 @@
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Utils/AELimiter.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 #include <atomic>
 
 namespace ActiveAE
@@ -146,6 +147,8 @@ protected:
   void ResetFreeBuffers();
   void InitRemapper();
   void RemapBuffer();
+  void PushSamples(CSampleBuffer *buffer);
+  bool PushPendingSamples();
   double CalcResampleRatio(double error);
   int GetErrorInterval();
 
@@ -218,6 +221,12 @@ protected:
   double m_lastPtsJump;
   std::atomic_int m_errorInterval;
 
+  // empty buffers from engine to stream and filled ones back
+  CSampleBufferQueue m_streamBuffers;
+  CSampleBufferQueue m_streamSamples;
+  // filled buffers which didn't fit into m_streamSamples, only accessed by the stream
+  std::deque<CSampleBuffer*> m_pendingSamples;
+
   // only accessed by engine
   CActiveAEBufferPool *m_inputBuffers;
   CActiveAEStreamBuffers *m_processingBuffers;
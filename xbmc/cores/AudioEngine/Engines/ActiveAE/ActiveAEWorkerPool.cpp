@@ -0,0 +1,111 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ActiveAEWorkerPool.h"
+
+#include <algorithm>
+
+#include "threads/SingleLock.h"
+
+using namespace ActiveAE;
+
+CActiveAEWorkerPool::CActiveAEWorkerPool(unsigned int maxWorkers) : m_maxWorkers(maxWorkers)
+{
+}
+
+CActiveAEWorkerPool::~CActiveAEWorkerPool()
+{
+  {
+    CSingleLock lock(m_section);
+    m_stop = true;
+    m_jobCondition.notifyAll();
+  }
+
+  for (auto &worker : m_workers)
+    worker->StopThread(true);
+}
+
+void CActiveAEWorkerPool::Process(unsigned int count, const std::function<void(unsigned int)> &job)
+{
+  if (count == 0)
+    return;
+
+  if (count == 1 || m_maxWorkers == 0)
+  {
+    for (unsigned int i = 0; i < count; i++)
+      job(i);
+    return;
+  }
+
+  CSingleLock lock(m_section);
+
+  // the calling thread takes one share of the work itself
+  size_t workers = std::min<size_t>(m_maxWorkers, count - 1);
+  while (m_workers.size() < workers)
+  {
+    std::unique_ptr<CThread> worker(new CThread(this, "ActiveAEWorker"));
+    worker->Create();
+    m_workers.push_back(std::move(worker));
+  }
+
+  m_job = &job;
+  m_count = count;
+  m_next = 0;
+  m_pending = count;
+  m_jobCondition.notifyAll();
+
+  while (RunNextJob(lock))
+    ;
+
+  while (m_pending > 0)
+    m_doneCondition.wait(lock);
+
+  m_job = nullptr;
+  m_count = 0;
+  m_next = 0;
+}
+
+void CActiveAEWorkerPool::Run()
+{
+  CSingleLock lock(m_section);
+  while (!m_stop)
+  {
+    if (!RunNextJob(lock))
+      m_jobCondition.wait(lock);
+  }
+}
+
+bool CActiveAEWorkerPool::RunNextJob(CSingleLock &lock)
+{
+  if (m_next >= m_count)
+    return false;
+
+  unsigned int index = m_next++;
+  const std::function<void(unsigned int)> &job = *m_job;
+
+  lock.Leave();
+  job(index);
+  lock.Enter();
+
+  if (--m_pending == 0)
+    m_doneCondition.notifyAll();
+
+  return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+namespace ActiveAE
+{
+
+/*!
+ \brief Small pool of threads the engine hands independent work to.
+
+ Process() runs a batch of jobs on the workers and the calling thread and
+ only returns when all of them are done, so the caller can rely on the
+ results right after the call. Workers are started on first use. A pool
+ without workers runs everything on the calling thread.
+ */
+class CActiveAEWorkerPool : private IRunnable
+{
+public:
+  explicit CActiveAEWorkerPool(unsigned int maxWorkers);
+  ~CActiveAEWorkerPool() override;
+
+  /*!
+   \brief Call job(i) for every i in [0, count) and wait for all calls to finish
+   Jobs must not depend on each other, the order they run in is not defined.
+   */
+  void Process(unsigned int count, const std::function<void(unsigned int)> &job);
+
+private:
+  CActiveAEWorkerPool(const CActiveAEWorkerPool&) = delete;
+  CActiveAEWorkerPool& operator=(const CActiveAEWorkerPool&) = delete;
+
+  // implementation of IRunnable
+  void Run() override;
+
+  bool RunNextJob(CSingleLock &lock);
+
+  const unsigned int m_maxWorkers;
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_jobCondition;
+  XbmcThreads::ConditionVariable m_doneCondition;
+  const std::function<void(unsigned int)> *m_job = nullptr;
+  unsigned int m_count = 0;
+  unsigned int m_next = 0;
+  unsigned int m_pending = 0;
+  bool m_stop = false;
+  std::vector<std::unique_ptr<CThread>> m_workers;
+};
+
+}
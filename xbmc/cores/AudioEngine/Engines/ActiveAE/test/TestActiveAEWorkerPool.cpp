@@ -0,0 +1,67 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEWorkerPool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ActiveAE;
+
+TEST(TestActiveAEWorkerPool, RunsEveryJobOnce)
+{
+  CActiveAEWorkerPool pool(3);
+  for (unsigned int count = 0; count < 10; count++)
+  {
+    std::vector<int> calls(count, 0);
+    pool.Process(count, [&calls](unsigned int i) { calls[i]++; });
+    for (unsigned int i = 0; i < count; i++)
+      EXPECT_EQ(1, calls[i]);
+  }
+}
+
+TEST(TestActiveAEWorkerPool, WaitsForAllJobs)
+{
+  CActiveAEWorkerPool pool(2);
+  std::atomic<int> done(0);
+  for (int round = 0; round < 100; round++)
+  {
+    done = 0;
+    pool.Process(8, [&done](unsigned int i) {
+      volatile int spin = 0;
+      for (unsigned int j = 0; j < 1000 * (i + 1); j++)
+        spin = spin + 1;
+      done++;
+    });
+    EXPECT_EQ(8, done);
+  }
+}
+
+TEST(TestActiveAEWorkerPool, NoWorkers)
+{
+  CActiveAEWorkerPool pool(0);
+  std::vector<unsigned int> order;
+  pool.Process(4, [&order](unsigned int i) { order.push_back(i); });
+  ASSERT_EQ(4u, order.size());
+  for (unsigned int i = 0; i < 4; i++)
+    EXPECT_EQ(i, order[i]);
+}
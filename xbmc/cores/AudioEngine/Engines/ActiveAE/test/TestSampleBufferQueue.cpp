@@ -0,0 +1,102 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ActiveAE;
+
+TEST(TestSampleBufferQueue, FifoOrder)
+{
+  CSampleBufferQueue queue;
+  std::vector<CSampleBuffer> buffers(3);
+  EXPECT_EQ(nullptr, queue.Pop());
+
+  for (auto &buffer : buffers)
+    EXPECT_TRUE(queue.Push(&buffer));
+  for (auto &buffer : buffers)
+    EXPECT_EQ(&buffer, queue.Pop());
+  EXPECT_EQ(nullptr, queue.Pop());
+}
+
+TEST(TestSampleBufferQueue, FullAtCapacity)
+{
+  CSampleBufferQueue queue;
+  std::vector<CSampleBuffer> buffers(CSampleBufferQueue::CAPACITY + 1);
+
+  for (unsigned int i = 0; i < CSampleBufferQueue::CAPACITY; i++)
+    EXPECT_TRUE(queue.Push(&buffers[i]));
+  EXPECT_FALSE(queue.Push(&buffers[CSampleBufferQueue::CAPACITY]));
+
+  EXPECT_EQ(&buffers[0], queue.Pop());
+  EXPECT_TRUE(queue.Push(&buffers[CSampleBufferQueue::CAPACITY]));
+}
+
+TEST(TestSampleBufferQueue, Clear)
+{
+  CSampleBufferQueue queue;
+  std::vector<CSampleBuffer> buffers(4);
+  for (auto &buffer : buffers)
+    queue.Push(&buffer);
+
+  queue.Clear();
+  EXPECT_EQ(nullptr, queue.Pop());
+  EXPECT_TRUE(queue.Push(&buffers[0]));
+  EXPECT_EQ(&buffers[0], queue.Pop());
+}
+
+TEST(TestSampleBufferQueue, ProducerConsumer)
+{
+  const unsigned int count = 100000;
+  CSampleBufferQueue queue;
+  std::vector<CSampleBuffer> buffers(CSampleBufferQueue::CAPACITY);
+
+  std::thread producer([&queue, &buffers, count]()
+  {
+    for (unsigned int i = 0; i < count; i++)
+    {
+      while (!queue.Push(&buffers[i % buffers.size()]))
+        std::this_thread::yield();
+    }
+  });
+
+  unsigned int received = 0;
+  bool ordered = true;
+  while (received < count)
+  {
+    CSampleBuffer *buffer = queue.Pop();
+    if (!buffer)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    if (buffer != &buffers[received % buffers.size()])
+      ordered = false;
+    received++;
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(nullptr, queue.Pop());
+}
@@ -38,6 +38,7 @@ public:
     The sink does NOT have to honour anything in the format struct or the device
     if however it does not honour what is requested, it MUST update device/format
     with what it does support.
+    A non zero m_frames is a request for a smaller period size, e.g. for low latency.
   */
   virtual bool Initialize  (AEAudioFormat &format, std::string &device) = 0;
 
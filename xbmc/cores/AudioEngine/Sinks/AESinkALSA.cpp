@@ -500,6 +500,7 @@ bool CAESinkALSA::Initialize(AEAudioFormat &format, std::string &device)
   ALSAConfig inconfig, outconfig;
   inconfig.format = format.m_dataFormat;
   inconfig.sampleRate = format.m_sampleRate;
+  inconfig.periodSize = format.m_frames;
 
   /*
    * We can't use the better GetChannelLayout() at this point as the device
@@ -746,7 +747,14 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
   */
   periodSize  = std::min(periodSize, (snd_pcm_uframes_t) sampleRate / 20);
   bufferSize  = std::min(bufferSize, (snd_pcm_uframes_t) sampleRate / 5);
-  
+
+  /* low latency: AE asks for a smaller period, keep 4 of them in the buffer */
+  if (inconfig.periodSize > 0 && !m_passthrough)
+  {
+    periodSize = std::min(periodSize, (snd_pcm_uframes_t) std::max(inconfig.periodSize, (unsigned int) AE_MIN_PERIODSIZE));
+    bufferSize = std::min(bufferSize, periodSize * 4);
+  }
+
   /* 
    According to upstream we should set buffer size first - so make sure it is always at least
    4x period size to not get underruns (some systems seem to have issues with only 2 periods)
@@ -756,6 +756,17 @@ bool CAESinkPULSE::Initialize(AEAudioFormat &format, std::string &device)
     process_time = latency / 4;
   }
 
+  // low latency: AE asks for a smaller packet size, keep 4 of them in the buffer
+  if (format.m_frames > 0 && !m_passthrough)
+  {
+    unsigned int requested = format.m_frames * frameSize;
+    if (requested < process_time)
+    {
+      process_time = requested;
+      latency = process_time * 4;
+    }
+  }
+
   pa_buffer_attr buffer_attr;
   buffer_attr.fragsize = latency;
   buffer_attr.maxlength = (uint32_t) -1;
@@ -22,11 +22,28 @@
 #endif
 
 #include "AEUtil.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "utils/TimeUtils.h"
 
+#include <atomic>
 #include <cassert>
 
+#if defined(HAVE_SSE) && defined(__SSE__) && defined(__GNUC__)
+  /* the AVX2 kernels are built with a function level target, dispatch keeps them off older cpus */
+  #define HAS_AE_AVX2
+  #define AE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(HAS_AE_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define HAS_AE_NEON
+  #include <arm_neon.h>
+#endif
+
 extern "C" {
 #include "libavutil/channel_layout.h"
 }
@@ -231,8 +248,75 @@ const char* CAEUtil::DataFormatToStr(const enum AEDataFormat dataFormat)
   return formats[dataFormat];
 }
 
+namespace
+{
+/*
+   This is a rational function to approximate a tanh-like soft clipper.
+   It is based on the pade-approximation of the tanh function with tweaked coefficients.
+   See: http://www.musicdsp.org/showone.php?id=238
+   The function reaches exactly +-1 at +-3, so the vector kernels clamp the input to
+   that range instead of branching.
+*/
+inline float SoftClamp(const float x)
+{
+  if (x < -3.0f)
+    return -1.0f;
+  else if (x >  3.0f)
+    return 1.0f;
+  float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+struct AEKernels
+{
+  AEKernelSet set;
+  const char *name;
+  void (*mul)(float *data, const float mul, uint32_t count);
+  bool (*mulAdd)(float *data, const float *add, const float mul, uint32_t count);
+  void (*clamp)(float *data, uint32_t count);
+  void (*interleave)(float *dst, const float * const *src, unsigned int planes, uint32_t samples);
+};
+
+// generic kernels, plain loops the compiler is free to vectorize
+
+void MulGeneric(float *data, const float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+bool MulAddGeneric(float *data, const float *add, const float mul, uint32_t count)
+{
+  bool clip = false;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    data[i] += add[i] * mul;
+    clip |= fabs(data[i]) > 1.0f;
+  }
+  return clip;
+}
+
+void ClampGeneric(float *data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] = SoftClamp(data[i]);
+}
+
+void InterleaveGeneric(float *dst, const float * const *src, unsigned int planes, uint32_t samples)
+{
+  for (unsigned int p = 0; p < planes; ++p)
+  {
+    const float *in = src[p];
+    float *out = dst + p;
+    for (uint32_t i = 0; i < samples; ++i, out += planes)
+      *out = in[i];
+  }
+}
+
+const AEKernels kernelsGeneric = { AE_KERNELS_GENERIC, "generic", MulGeneric, MulAddGeneric, ClampGeneric, InterleaveGeneric };
+
 #if defined(HAVE_SSE) && defined(__SSE__)
-void CAEUtil::SSEMulArray(float *data, const float mul, uint32_t count)
+void MulSSE(float *data, const float mul, uint32_t count)
 {
   const __m128 m = _mm_set_ps1(mul);
 
@@ -251,41 +335,21 @@ void CAEUtil::SSEMulArray(float *data, const float mul, uint32_t count)
     *(__m128*)data = _mm_mul_ps (to, m);
   }
 
-  if (even != count)
-  {
-    uint32_t odd = count - even;
-    if (odd == 1)
-      data[0] *= mul;
-    else
-    {
-      __m128 to;
-      if (odd == 2)
-      {
-        to = _mm_setr_ps(data[0], data[1], 0, 0);
-        __m128 ou = _mm_mul_ps(to, m);
-        data[0] = ((float*)&ou)[0];
-        data[1] = ((float*)&ou)[1];
-      }
-      else
-      {
-        to = _mm_setr_ps(data[0], data[1], data[2], 0);
-        __m128 ou = _mm_mul_ps(to, m);
-        data[0] = ((float*)&ou)[0];
-        data[1] = ((float*)&ou)[1];
-        data[2] = ((float*)&ou)[2];
-      }
-    }
-  }
+  MulGeneric(data, mul, count - even);
 }
 
-void CAEUtil::SSEMulAddArray(float *data, float *add, const float mul, uint32_t count)
+bool MulAddSSE(float *data, const float *add, const float mul, uint32_t count)
 {
   const __m128 m = _mm_set_ps1(mul);
+  const __m128 sign = _mm_set_ps1(-0.0f);
+  const __m128 one = _mm_set_ps1(1.0f);
+  __m128 clip = _mm_setzero_ps();
+  bool clipTail = false;
 
   /* work around invalid alignment */
-  while ((((uintptr_t)data & 0xF) || ((uintptr_t)add & 0xF)) && count > 0)
+  while (((uintptr_t)data & 0xF) && count > 0)
   {
-    data[0] += add[0] * mul;
+    clipTail |= MulAddGeneric(data, add, mul, 1);
     ++add;
     ++data;
     --count;
@@ -294,86 +358,22 @@ void CAEUtil::SSEMulAddArray(float *data, float *add, const float mul, uint32_t
   uint32_t even = count & ~0x3;
   for (uint32_t i = 0; i < even; i+=4, data+=4, add+=4)
   {
-    __m128 ad      = _mm_load_ps(add );
-    __m128 to      = _mm_load_ps(data);
-    *(__m128*)data = _mm_add_ps (to, _mm_mul_ps(ad, m));
+    __m128 ad = _mm_loadu_ps(add);
+    __m128 to = _mm_add_ps(_mm_load_ps(data), _mm_mul_ps(ad, m));
+    _mm_store_ps(data, to);
+    clip = _mm_or_ps(clip, _mm_cmpgt_ps(_mm_andnot_ps(sign, to), one));
   }
 
-  if (even != count)
-  {
-    uint32_t odd = count - even;
-    if (odd == 1)
-      data[0] += add[0] * mul;
-    else
-    {
-      __m128 ad;
-      __m128 to;
-      if (odd == 2)
-      {
-        ad = _mm_setr_ps(add [0], add [1], 0, 0);
-        to = _mm_setr_ps(data[0], data[1], 0, 0);
-        __m128 ou = _mm_add_ps(to, _mm_mul_ps(ad, m));
-        data[0] = ((float*)&ou)[0];
-        data[1] = ((float*)&ou)[1];
-      }
-      else
-      {
-        ad = _mm_setr_ps(add [0], add [1], add [2], 0);
-        to = _mm_setr_ps(data[0], data[1], data[2], 0);
-        __m128 ou = _mm_add_ps(to, _mm_mul_ps(ad, m));
-        data[0] = ((float*)&ou)[0];
-        data[1] = ((float*)&ou)[1];
-        data[2] = ((float*)&ou)[2];
-      }
-    }
-  }
+  clipTail |= MulAddGeneric(data, add, mul, count - even);
+  return clipTail || _mm_movemask_ps(clip) != 0;
 }
-#endif
 
-inline float CAEUtil::SoftClamp(const float x)
-{
-#if 1
-    /*
-       This is a rational function to approximate a tanh-like soft clipper.
-       It is based on the pade-approximation of the tanh function with tweaked coefficients.
-       See: http://www.musicdsp.org/showone.php?id=238
-    */
-    if (x < -3.0f)
-      return -1.0f;
-    else if (x >  3.0f)
-      return 1.0f;
-    float y = x * x;
-    return x * (27.0f + y) / (27.0f + 9.0f * y);
-#else
-    /* slower method using tanh, but more accurate */
-
-    static const double k = 0.9f;
-    /* perform a soft clamp */
-    if (x >  k)
-      x = (float) (tanh((x - k) / (1 - k)) * (1 - k) + k);
-    else if (x < -k)
-      x = (float) (tanh((x + k) / (1 - k)) * (1 - k) - k);
-
-    /* hard clamp anything still outside the bounds */
-    if (x >  1.0f)
-      return  1.0f;
-    if (x < -1.0f)
-      return -1.0f;
-
-    /* return the final sample */
-    return x;
-#endif
-}
-
-void CAEUtil::ClampArray(float *data, uint32_t count)
+void ClampSSE(float *data, uint32_t count)
 {
-#if !defined(HAVE_SSE) || !defined(__SSE__)
-  for (uint32_t i = 0; i < count; ++i)
-    data[i] = SoftClamp(data[i]);
-
-#else
   const __m128 c1 = _mm_set_ps1(27.0f);
-  const __m128 c2 = _mm_set_ps1(27.0f + 9.0f);
+  const __m128 c2 = _mm_set_ps1(9.0f);
+  const __m128 hi = _mm_set_ps1(3.0f);
+  const __m128 lo = _mm_set_ps1(-3.0f);
 
   /* work around invalid alignment */
   while (((uintptr_t)data & 0xF) && count > 0)
@@ -387,63 +387,389 @@ void CAEUtil::ClampArray(float *data, uint32_t count)
   for (uint32_t i = 0; i < even; i+=4, data+=4)
   {
     /* tanh approx clamp */
-    __m128 dt = _mm_load_ps(data);
-    __m128 tmp     = _mm_mul_ps(dt, dt);
+    __m128 dt  = _mm_min_ps(_mm_max_ps(_mm_load_ps(data), lo), hi);
+    __m128 tmp = _mm_mul_ps(dt, dt);
     *(__m128*)data = _mm_div_ps(
       _mm_mul_ps(
         dt,
         _mm_add_ps(c1, tmp)
       ),
-      _mm_add_ps(c2, tmp)
+      _mm_add_ps(c1, _mm_mul_ps(c2, tmp))
     );
   }
 
-  if (even != count)
+  ClampGeneric(data, count - even);
+}
+
+/* transposes 4 samples of 4 planes at a time */
+void InterleaveSSE(float *dst, const float * const *src, unsigned int planes, uint32_t samples)
+{
+  uint32_t even = samples & ~0x3;
+
+  if (planes == 2)
   {
-    uint32_t odd = count - even;
-    if (odd == 1)
-      data[0] = SoftClamp(data[0]);
-    else
+    const float *l = src[0];
+    const float *r = src[1];
+    for (uint32_t i = 0; i < even; i+=4, dst+=8)
     {
-      __m128 dt;
-      __m128 tmp;
-      __m128 out;
-      if (odd == 2)
+      __m128 a = _mm_loadu_ps(l + i);
+      __m128 b = _mm_loadu_ps(r + i);
+      _mm_storeu_ps(dst    , _mm_unpacklo_ps(a, b));
+      _mm_storeu_ps(dst + 4, _mm_unpackhi_ps(a, b));
+    }
+  }
+  else if ((planes & 0x3) == 0)
+  {
+    for (unsigned int p = 0; p < planes; p+=4)
+    {
+      float *out = dst + p;
+      for (uint32_t i = 0; i < even; i+=4, out+=4*planes)
       {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], 0, 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
+        __m128 a = _mm_loadu_ps(src[p    ] + i);
+        __m128 b = _mm_loadu_ps(src[p + 1] + i);
+        __m128 c = _mm_loadu_ps(src[p + 2] + i);
+        __m128 d = _mm_loadu_ps(src[p + 3] + i);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(out           , a);
+        _mm_storeu_ps(out +   planes, b);
+        _mm_storeu_ps(out + 2*planes, c);
+        _mm_storeu_ps(out + 3*planes, d);
       }
-      else
+    }
+    dst += even * planes;
+  }
+  else
+  {
+    InterleaveGeneric(dst, src, planes, samples);
+    return;
+  }
+
+  const float *tail[AE_CH_MAX];
+  for (unsigned int p = 0; p < planes; ++p)
+    tail[p] = src[p] + even;
+  InterleaveGeneric(dst, tail, planes, samples - even);
+}
+
+const AEKernels kernelsSSE = { AE_KERNELS_SSE, "SSE", MulSSE, MulAddSSE, ClampSSE, InterleaveSSE };
+#endif
+
+#if defined(HAS_AE_AVX2)
+AE_TARGET_AVX2 void MulAVX2(float *data, const float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i+=8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+
+  MulGeneric(data + even, mul, count - even);
+}
+
+AE_TARGET_AVX2 bool MulAddAVX2(float *data, const float *add, const float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256 clip = _mm256_setzero_ps();
+
+  // no fused multiply-add, the result has to match the other kernel sets
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i+=8)
+  {
+    __m256 to = _mm256_add_ps(_mm256_loadu_ps(data + i), _mm256_mul_ps(_mm256_loadu_ps(add + i), m));
+    _mm256_storeu_ps(data + i, to);
+    clip = _mm256_or_ps(clip, _mm256_cmp_ps(_mm256_andnot_ps(sign, to), one, _CMP_GT_OQ));
+  }
+
+  bool clipTail = MulAddGeneric(data + even, add + even, mul, count - even);
+  return clipTail || _mm256_movemask_ps(clip) != 0;
+}
+
+AE_TARGET_AVX2 void ClampAVX2(float *data, uint32_t count)
+{
+  const __m256 c1 = _mm256_set1_ps(27.0f);
+  const __m256 c2 = _mm256_set1_ps(9.0f);
+  const __m256 hi = _mm256_set1_ps(3.0f);
+  const __m256 lo = _mm256_set1_ps(-3.0f);
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i+=8)
+  {
+    __m256 dt  = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lo), hi);
+    __m256 tmp = _mm256_mul_ps(dt, dt);
+    _mm256_storeu_ps(data + i, _mm256_div_ps(_mm256_mul_ps(dt, _mm256_add_ps(c1, tmp)),
+                                             _mm256_add_ps(c1, _mm256_mul_ps(c2, tmp))));
+  }
+
+  ClampGeneric(data + even, count - even);
+}
+
+/* transposes 8 samples of 8 planes at a time, other layouts use the SSE kernel */
+AE_TARGET_AVX2 void InterleaveAVX2(float *dst, const float * const *src, unsigned int planes, uint32_t samples)
+{
+  if ((planes & 0x7) != 0)
+  {
+    InterleaveSSE(dst, src, planes, samples);
+    return;
+  }
+
+  uint32_t even = samples & ~0x7;
+  for (unsigned int p = 0; p < planes; p+=8)
+  {
+    float *out = dst + p;
+    for (uint32_t i = 0; i < even; i+=8, out+=8*planes)
+    {
+      __m256 r0 = _mm256_loadu_ps(src[p    ] + i);
+      __m256 r1 = _mm256_loadu_ps(src[p + 1] + i);
+      __m256 r2 = _mm256_loadu_ps(src[p + 2] + i);
+      __m256 r3 = _mm256_loadu_ps(src[p + 3] + i);
+      __m256 r4 = _mm256_loadu_ps(src[p + 4] + i);
+      __m256 r5 = _mm256_loadu_ps(src[p + 5] + i);
+      __m256 r6 = _mm256_loadu_ps(src[p + 6] + i);
+      __m256 r7 = _mm256_loadu_ps(src[p + 7] + i);
+
+      __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+      __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+      __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+      __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+      __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+      __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+      __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+      __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+      __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+      __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+      __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+      __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+      _mm256_storeu_ps(out           , _mm256_permute2f128_ps(s0, s4, 0x20));
+      _mm256_storeu_ps(out +   planes, _mm256_permute2f128_ps(s1, s5, 0x20));
+      _mm256_storeu_ps(out + 2*planes, _mm256_permute2f128_ps(s2, s6, 0x20));
+      _mm256_storeu_ps(out + 3*planes, _mm256_permute2f128_ps(s3, s7, 0x20));
+      _mm256_storeu_ps(out + 4*planes, _mm256_permute2f128_ps(s0, s4, 0x31));
+      _mm256_storeu_ps(out + 5*planes, _mm256_permute2f128_ps(s1, s5, 0x31));
+      _mm256_storeu_ps(out + 6*planes, _mm256_permute2f128_ps(s2, s6, 0x31));
+      _mm256_storeu_ps(out + 7*planes, _mm256_permute2f128_ps(s3, s7, 0x31));
+    }
+  }
+
+  const float *tail[AE_CH_MAX];
+  for (unsigned int p = 0; p < planes; ++p)
+    tail[p] = src[p] + even;
+  InterleaveGeneric(dst + even * planes, tail, planes, samples - even);
+}
+
+const AEKernels kernelsAVX2 = { AE_KERNELS_AVX2, "AVX2", MulAVX2, MulAddAVX2, ClampAVX2, InterleaveAVX2 };
+#endif
+
+#if defined(HAS_AE_NEON)
+void MulNEON(float *data, const float mul, uint32_t count)
+{
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i+=4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), mul));
+
+  MulGeneric(data + even, mul, count - even);
+}
+
+bool MulAddNEON(float *data, const float *add, const float mul, uint32_t count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  uint32x4_t clip = vdupq_n_u32(0);
+
+  // no vmlaq_f32, it may be fused on some cores and the result has to match the other kernel sets
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i+=4)
+  {
+    float32x4_t to = vaddq_f32(vld1q_f32(data + i), vmulq_f32(vld1q_f32(add + i), m));
+    vst1q_f32(data + i, to);
+    clip = vorrq_u32(clip, vcagtq_f32(to, one));
+  }
+
+  bool clipTail = MulAddGeneric(data + even, add + even, mul, count - even);
+  uint32x2_t clip2 = vorr_u32(vget_low_u32(clip), vget_high_u32(clip));
+  return clipTail || (vget_lane_u32(clip2, 0) | vget_lane_u32(clip2, 1)) != 0;
+}
+
+void ClampNEON(float *data, uint32_t count)
+{
+  const float32x4_t c1 = vdupq_n_f32(27.0f);
+  const float32x4_t hi = vdupq_n_f32(3.0f);
+  const float32x4_t lo = vdupq_n_f32(-3.0f);
+
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i+=4)
+  {
+    float32x4_t dt  = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+    float32x4_t tmp = vmulq_f32(dt, dt);
+    float32x4_t num = vmulq_f32(dt, vaddq_f32(c1, tmp));
+    float32x4_t den = vaddq_f32(c1, vmulq_n_f32(tmp, 9.0f));
+#if defined(__aarch64__)
+    vst1q_f32(data + i, vdivq_f32(num, den));
+#else
+    // armv7 has no vector division, refine the reciprocal estimate twice
+    float32x4_t rcp = vrecpeq_f32(den);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    vst1q_f32(data + i, vmulq_f32(num, rcp));
+#endif
+  }
+
+  ClampGeneric(data + even, count - even);
+}
+
+/* stores 4 samples of 2 or 4 planes with the structured stores, transposes 4 planes at a time otherwise */
+void InterleaveNEON(float *dst, const float * const *src, unsigned int planes, uint32_t samples)
+{
+  uint32_t even = samples & ~0x3;
+
+  if (planes == 2)
+  {
+    for (uint32_t i = 0; i < even; i+=4)
+    {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(src[0] + i);
+      v.val[1] = vld1q_f32(src[1] + i);
+      vst2q_f32(dst + i * 2, v);
+    }
+  }
+  else if (planes == 4)
+  {
+    for (uint32_t i = 0; i < even; i+=4)
+    {
+      float32x4x4_t v;
+      v.val[0] = vld1q_f32(src[0] + i);
+      v.val[1] = vld1q_f32(src[1] + i);
+      v.val[2] = vld1q_f32(src[2] + i);
+      v.val[3] = vld1q_f32(src[3] + i);
+      vst4q_f32(dst + i * 4, v);
+    }
+  }
+  else if ((planes & 0x3) == 0)
+  {
+    for (unsigned int p = 0; p < planes; p+=4)
+    {
+      float *out = dst + p;
+      for (uint32_t i = 0; i < even; i+=4, out+=4*planes)
       {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], data[2], 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
-        data[2] = ((float*)&out)[2];
+        float32x4x2_t ab = vzipq_f32(vld1q_f32(src[p    ] + i), vld1q_f32(src[p + 1] + i));
+        float32x4x2_t cd = vzipq_f32(vld1q_f32(src[p + 2] + i), vld1q_f32(src[p + 3] + i));
+        vst1q_f32(out           , vcombine_f32(vget_low_f32 (ab.val[0]), vget_low_f32 (cd.val[0])));
+        vst1q_f32(out +   planes, vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])));
+        vst1q_f32(out + 2*planes, vcombine_f32(vget_low_f32 (ab.val[1]), vget_low_f32 (cd.val[1])));
+        vst1q_f32(out + 3*planes, vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])));
       }
     }
   }
+  else
+  {
+    InterleaveGeneric(dst, src, planes, samples);
+    return;
+  }
+
+  const float *tail[AE_CH_MAX];
+  for (unsigned int p = 0; p < planes; ++p)
+    tail[p] = src[p] + even;
+  InterleaveGeneric(dst + even * planes, tail, planes, samples - even);
+}
+
+const AEKernels kernelsNEON = { AE_KERNELS_NEON, "NEON", MulNEON, MulAddNEON, ClampNEON, InterleaveNEON };
+#endif
+
+const AEKernels* FindKernels(AEKernelSet set)
+{
+  switch (set)
+  {
+#if defined(HAVE_SSE) && defined(__SSE__)
+    case AE_KERNELS_SSE:
+      if (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_SSE)
+        return &kernelsSSE;
+      break;
 #endif
+#if defined(HAS_AE_AVX2)
+    case AE_KERNELS_AVX2:
+      if (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_AVX2)
+        return &kernelsAVX2;
+      break;
+#endif
+#if defined(HAS_AE_NEON)
+    case AE_KERNELS_NEON:
+      if (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_NEON)
+        return &kernelsNEON;
+      break;
+#endif
+    case AE_KERNELS_GENERIC:
+      return &kernelsGeneric;
+    default:
+      break;
+  }
+  return nullptr;
+}
+
+std::atomic<const AEKernels*> currentKernels(nullptr);
+
+const AEKernels& GetKernels()
+{
+  const AEKernels *kernels = currentKernels.load(std::memory_order_acquire);
+  if (!kernels)
+  {
+    // pick the best kernel set the cpu supports
+    for (AEKernelSet set : { AE_KERNELS_AVX2, AE_KERNELS_NEON, AE_KERNELS_SSE, AE_KERNELS_GENERIC })
+    {
+      kernels = FindKernels(set);
+      if (kernels)
+        break;
+    }
+    currentKernels.store(kernels, std::memory_order_release);
+    CLog::Log(LOGDEBUG, "CAEUtil - using %s kernels", kernels->name);
+  }
+  return *kernels;
+}
+}
+
+bool CAEUtil::SetKernelSet(AEKernelSet set)
+{
+  const AEKernels *kernels = FindKernels(set);
+  if (!kernels)
+    return false;
+
+  currentKernels.store(kernels, std::memory_order_release);
+  return true;
+}
+
+AEKernelSet CAEUtil::GetKernelSet()
+{
+  return GetKernels().set;
+}
+
+bool CAEUtil::HasKernelSet(AEKernelSet set)
+{
+  return FindKernels(set) != nullptr;
+}
+
+void CAEUtil::MulArray(float *data, const float mul, uint32_t count)
+{
+  GetKernels().mul(data, mul, count);
+}
+
+bool CAEUtil::MulAddArray(float *data, const float *add, const float mul, uint32_t count)
+{
+  return GetKernels().mulAdd(data, add, mul, count);
+}
+
+void CAEUtil::ClampArray(float *data, uint32_t count)
+{
+  GetKernels().clamp(data, count);
+}
+
+void CAEUtil::InterleaveArray(float *dst, const float * const *src, unsigned int planes, uint32_t samples)
+{
+  GetKernels().interleave(dst, src, planes, samples);
 }
 
 bool CAEUtil::S16NeedsByteSwap(AEDataFormat in, AEDataFormat out)
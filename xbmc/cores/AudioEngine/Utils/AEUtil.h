@@ -43,6 +43,15 @@ extern "C" {
   #define MEMALIGN(b, x) __declspec(align(b)) x
 #endif
 
+// kernel sets for the sample array functions of CAEUtil
+enum AEKernelSet
+{
+  AE_KERNELS_GENERIC = 0,
+  AE_KERNELS_SSE,
+  AE_KERNELS_AVX2,
+  AE_KERNELS_NEON
+};
+
 // AV sync options
 enum AVSync
 {
@@ -133,8 +142,6 @@ private:
     static __m128i m_sseSeed;
   #endif
 
-  static float SoftClamp(const float x);
-
 public:
   static CAEChannelInfo          GuessChLayout     (const unsigned int channels);
   static const char*             GetStdChLayoutName(const enum AEStdChLayout layout);
@@ -202,12 +209,30 @@ public:
     return 20*log10(scale);
   }
 
-  #if defined(HAVE_SSE) && defined(__SSE__)
-  static void SSEMulArray     (float *data, const float mul, uint32_t count);
-  static void SSEMulAddArray  (float *data, float *add, const float mul, uint32_t count);
-  #endif
+  /*! \brief multiply every sample by a factor, data[i] *= mul */
+  static void MulArray(float *data, const float mul, uint32_t count);
+
+  /*! \brief add scaled samples, data[i] += add[i] * mul
+   \return true if a resulting sample is outside the range -1..1 and needs to be clamped
+   */
+  static bool MulAddArray(float *data, const float *add, const float mul, uint32_t count);
+
+  /*! \brief soft clamp the samples to the range -1..1 */
   static void ClampArray(float *data, uint32_t count);
 
+  /*! \brief convert planar samples to interleaved ones, dst[i * planes + p] = src[p][i]
+   \param dst buffer for samples * planes floats
+   \param src one buffer of samples floats per plane
+   */
+  static void InterleaveArray(float *dst, const float * const *src, unsigned int planes, uint32_t samples);
+
+  /*! \brief the array functions above dispatch to the fastest kernel set the cpu supports,
+   these allow to check and override the choice, e.g. for tests and benchmarks
+   */
+  static bool HasKernelSet(AEKernelSet set);
+  static bool SetKernelSet(AEKernelSet set);
+  static AEKernelSet GetKernelSet();
+
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
 
   static uint64_t GetAVChannelLayout(const CAEChannelInfo &info);
@@ -0,0 +1,168 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+std::vector<float> CreateSamples(size_t count, float scale)
+{
+  std::vector<float> samples(count);
+  for (size_t i = 0; i < count; ++i)
+    samples[i] = scale * std::sin(i * 0.37f);
+  return samples;
+}
+
+class TestAEUtil : public testing::TestWithParam<AEKernelSet>
+{
+protected:
+  void SetUp() override
+  {
+    m_kernels = CAEUtil::GetKernelSet();
+    if (!CAEUtil::HasKernelSet(GetParam()))
+      m_skip = true;
+  }
+
+  void TearDown() override
+  {
+    CAEUtil::SetKernelSet(m_kernels);
+  }
+
+  AEKernelSet m_kernels;
+  bool m_skip = false;
+};
+
+// odd counts and offsets to cover the unaligned heads and the tails of the vector kernels
+const uint32_t counts[] = { 0, 1, 3, 7, 8, 17, 1021 };
+const unsigned int offsets[] = { 0, 1, 3 };
+}
+
+TEST_P(TestAEUtil, MulArray)
+{
+  if (m_skip)
+    return;
+
+  for (uint32_t count : counts)
+  {
+    for (unsigned int offset : offsets)
+    {
+      std::vector<float> ref = CreateSamples(count + offset, 2.0f);
+      std::vector<float> var = ref;
+
+      CAEUtil::SetKernelSet(AE_KERNELS_GENERIC);
+      CAEUtil::MulArray(ref.data() + offset, 0.7f, count);
+      CAEUtil::SetKernelSet(GetParam());
+      CAEUtil::MulArray(var.data() + offset, 0.7f, count);
+      EXPECT_EQ(ref, var);
+    }
+  }
+}
+
+TEST_P(TestAEUtil, MulAddArray)
+{
+  if (m_skip)
+    return;
+
+  for (uint32_t count : counts)
+  {
+    for (unsigned int offset : offsets)
+    {
+      std::vector<float> add = CreateSamples(count, 1.0f);
+      std::vector<float> ref = CreateSamples(count + offset, 0.5f);
+      std::vector<float> var = ref;
+
+      CAEUtil::SetKernelSet(AE_KERNELS_GENERIC);
+      bool refClip = CAEUtil::MulAddArray(ref.data() + offset, add.data(), 0.8f, count);
+      CAEUtil::SetKernelSet(GetParam());
+      bool varClip = CAEUtil::MulAddArray(var.data() + offset, add.data(), 0.8f, count);
+      EXPECT_EQ(ref, var);
+      EXPECT_EQ(refClip, varClip);
+    }
+  }
+
+  std::vector<float> data(33, 0.0f);
+  std::vector<float> add(33, 0.5f);
+  CAEUtil::SetKernelSet(GetParam());
+  EXPECT_FALSE(CAEUtil::MulAddArray(data.data(), add.data(), 1.0f, data.size()));
+  add[20] = 1.0f;
+  EXPECT_TRUE(CAEUtil::MulAddArray(data.data(), add.data(), 1.0f, data.size()));
+}
+
+TEST_P(TestAEUtil, ClampArray)
+{
+  if (m_skip)
+    return;
+
+  for (uint32_t count : counts)
+  {
+    for (unsigned int offset : offsets)
+    {
+      std::vector<float> ref = CreateSamples(count + offset, 5.0f);
+      std::vector<float> var = ref;
+
+      CAEUtil::SetKernelSet(AE_KERNELS_GENERIC);
+      CAEUtil::ClampArray(ref.data() + offset, count);
+      CAEUtil::SetKernelSet(GetParam());
+      CAEUtil::ClampArray(var.data() + offset, count);
+      for (size_t i = offset; i < ref.size(); ++i)
+      {
+        EXPECT_NEAR(ref[i], var[i], 1e-6f);
+        EXPECT_LE(std::fabs(var[i]), 1.0f);
+      }
+    }
+  }
+}
+
+TEST_P(TestAEUtil, InterleaveArray)
+{
+  if (m_skip)
+    return;
+
+  for (uint32_t count : counts)
+  {
+    for (unsigned int planes = 1; planes <= 8; ++planes)
+    {
+      std::vector<std::vector<float>> data;
+      std::vector<const float*> src;
+      for (unsigned int p = 0; p < planes; ++p)
+      {
+        data.push_back(CreateSamples(count, p + 1.0f));
+        src.push_back(data.back().data());
+      }
+      std::vector<float> dst(count * planes);
+
+      CAEUtil::SetKernelSet(GetParam());
+      CAEUtil::InterleaveArray(dst.data(), src.data(), planes, count);
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        for (unsigned int p = 0; p < planes; ++p)
+          EXPECT_EQ(data[p][i], dst[i * planes + p]);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(KernelSets, TestAEUtil,
+                        testing::Values(AE_KERNELS_GENERIC, AE_KERNELS_SSE, AE_KERNELS_AVX2, AE_KERNELS_NEON));
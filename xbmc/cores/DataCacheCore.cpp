@@ -271,6 +271,9 @@ void CDataCacheCore::SetSpeed(float tempo, float speed)
 {
   CSingleLock lock(m_stateSection);
 
+  if (speed != m_stateInfo.m_speed)
+    m_playerStateChanged = true;
+
   m_stateInfo.m_tempo = tempo;
   m_stateInfo.m_speed = speed;
 }
@@ -361,3 +364,151 @@ int64_t CDataCacheCore::GetMaxTime()
   CSingleLock lock(m_stateSection);
   return m_timeInfo.m_timeMax;
 }
+
+void CDataCacheCore::SetPacketPoolStats(uint64_t allocations, uint64_t reused, int64_t bytesInUse, int64_t bytesCached)
+{
+  CSingleLock lock(m_packetPoolSection);
+  m_packetPoolInfo.m_allocations = allocations;
+  m_packetPoolInfo.m_reused = reused;
+  m_packetPoolInfo.m_bytesInUse = bytesInUse;
+  m_packetPoolInfo.m_bytesCached = bytesCached;
+}
+
+uint64_t CDataCacheCore::GetPacketPoolAllocations()
+{
+  CSingleLock lock(m_packetPoolSection);
+  return m_packetPoolInfo.m_allocations;
+}
+
+uint64_t CDataCacheCore::GetPacketPoolReused()
+{
+  CSingleLock lock(m_packetPoolSection);
+  return m_packetPoolInfo.m_reused;
+}
+
+int64_t CDataCacheCore::GetPacketPoolBytesInUse()
+{
+  CSingleLock lock(m_packetPoolSection);
+  return m_packetPoolInfo.m_bytesInUse;
+}
+
+int64_t CDataCacheCore::GetPacketPoolBytesCached()
+{
+  CSingleLock lock(m_packetPoolSection);
+  return m_packetPoolInfo.m_bytesCached;
+}
+
+void CDataCacheCore::SetAudioLatency(double stream, double processing, double engine, double sink, double device)
+{
+  CSingleLock lock(m_audioLatencySection);
+  m_audioLatencyInfo.m_stream = stream;
+  m_audioLatencyInfo.m_processing = processing;
+  m_audioLatencyInfo.m_engine = engine;
+  m_audioLatencyInfo.m_sink = sink;
+  m_audioLatencyInfo.m_device = device;
+}
+
+void CDataCacheCore::SetAudioBufferState(bool lowLatency, unsigned int underruns)
+{
+  CSingleLock lock(m_audioLatencySection);
+  m_audioLatencyInfo.m_lowLatency = lowLatency;
+  m_audioLatencyInfo.m_underruns = underruns;
+}
+
+double CDataCacheCore::GetAudioLatencyStream()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_stream;
+}
+
+double CDataCacheCore::GetAudioLatencyProcessing()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_processing;
+}
+
+double CDataCacheCore::GetAudioLatencyEngine()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_engine;
+}
+
+double CDataCacheCore::GetAudioLatencySink()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_sink;
+}
+
+double CDataCacheCore::GetAudioLatencyDevice()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_device;
+}
+
+double CDataCacheCore::GetAudioLatency()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_stream + m_audioLatencyInfo.m_processing + m_audioLatencyInfo.m_engine +
+         m_audioLatencyInfo.m_sink + m_audioLatencyInfo.m_device;
+}
+
+bool CDataCacheCore::IsAudioLowLatency()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_lowLatency;
+}
+
+unsigned int CDataCacheCore::GetAudioUnderruns()
+{
+  CSingleLock lock(m_audioLatencySection);
+  return m_audioLatencyInfo.m_underruns;
+}
+
+void CDataCacheCore::SetReadAheadState(const void *owner, int64_t forward, int64_t back, unsigned int fillRate, unsigned int linkRate, unsigned int consumeRate)
+{
+  CSingleLock lock(m_readAheadSection);
+  m_readAheadInfo.m_owner = owner;
+  m_readAheadInfo.m_forward = forward;
+  m_readAheadInfo.m_back = back;
+  m_readAheadInfo.m_fillRate = fillRate;
+  m_readAheadInfo.m_linkRate = linkRate;
+  m_readAheadInfo.m_consumeRate = consumeRate;
+}
+
+void CDataCacheCore::ResetReadAheadState(const void *owner)
+{
+  CSingleLock lock(m_readAheadSection);
+  // another file cache, e.g. of the next item, may have published its state meanwhile
+  if (m_readAheadInfo.m_owner == owner)
+    m_readAheadInfo = {};
+}
+
+int64_t CDataCacheCore::GetReadAheadForward()
+{
+  CSingleLock lock(m_readAheadSection);
+  return m_readAheadInfo.m_forward;
+}
+
+int64_t CDataCacheCore::GetReadAheadBack()
+{
+  CSingleLock lock(m_readAheadSection);
+  return m_readAheadInfo.m_back;
+}
+
+unsigned int CDataCacheCore::GetReadAheadFillRate()
+{
+  CSingleLock lock(m_readAheadSection);
+  return m_readAheadInfo.m_fillRate;
+}
+
+unsigned int CDataCacheCore::GetReadAheadLinkRate()
+{
+  CSingleLock lock(m_readAheadSection);
+  return m_readAheadInfo.m_linkRate;
+}
+
+unsigned int CDataCacheCore::GetReadAheadConsumeRate()
+{
+  CSingleLock lock(m_readAheadSection);
+  return m_readAheadInfo.m_consumeRate;
+}
@@ -113,6 +113,112 @@ public:
    */
   int64_t GetMaxTime();
 
+  // demux packet pool
+  void SetPacketPoolStats(uint64_t allocations, uint64_t reused, int64_t bytesInUse, int64_t bytesCached);
+
+  /*!
+   * \brief Get the number of demux packet buffers allocated so far
+   */
+  uint64_t GetPacketPoolAllocations();
+
+  /*!
+   * \brief Get the number of demux packet buffers that were recycled instead of allocated
+   */
+  uint64_t GetPacketPoolReused();
+
+  /*!
+   * \brief Get the memory, in bytes, held by demux packets in flight
+   */
+  int64_t GetPacketPoolBytesInUse();
+
+  /*!
+   * \brief Get the memory, in bytes, kept in unused demux packet buffers
+   */
+  int64_t GetPacketPoolBytesCached();
+
+  // audio engine latency
+  void SetAudioLatency(double stream, double processing, double engine, double sink, double device);
+  void SetAudioBufferState(bool lowLatency, unsigned int underruns);
+
+  /*!
+   * \brief Get the time, in seconds, audio waits in the stream before it is processed
+   */
+  double GetAudioLatencyStream();
+
+  /*!
+   * \brief Get the time, in seconds, audio spends in resampling and stream processing
+   */
+  double GetAudioLatencyProcessing();
+
+  /*!
+   * \brief Get the time, in seconds, of processed audio queued for the sink
+   */
+  double GetAudioLatencyEngine();
+
+  /*!
+   * \brief Get the time, in seconds, of audio buffered by the sink
+   */
+  double GetAudioLatencySink();
+
+  /*!
+   * \brief Get the latency, in seconds, reported by the output device
+   */
+  double GetAudioLatencyDevice();
+
+  /*!
+   * \brief Get the sum of all audio latency stages in seconds
+   */
+  double GetAudioLatency();
+
+  /*!
+   * \brief Check if the audio engine runs with low latency buffers
+   */
+  bool IsAudioLowLatency();
+
+  /*!
+   * \brief Get the number of times the audio sink ran out of data during playback
+   */
+  unsigned int GetAudioUnderruns();
+
+  // file cache read-ahead
+  /*!
+   * \brief Publish the read-ahead state of a file cache
+   * \param owner the file cache the state belongs to, the last one to publish owns the state
+   */
+  void SetReadAheadState(const void *owner, int64_t forward, int64_t back, unsigned int fillRate, unsigned int linkRate, unsigned int consumeRate);
+
+  /*!
+   * \brief Reset the read-ahead state if it was last published by the given file cache
+   */
+  void ResetReadAheadState(const void *owner);
+
+  /*!
+   * \brief Get the size, in bytes, of the forward buffer chosen by the adaptive file cache
+   */
+  int64_t GetReadAheadForward();
+
+  /*!
+   * \brief Get the size, in bytes, of the back buffer chosen by the adaptive file cache
+   */
+  int64_t GetReadAheadBack();
+
+  /*!
+   * \brief Get the rate, in bytes per second, the file cache may currently fill at
+   *
+   * This is zero while the forward buffer is full.
+   */
+  unsigned int GetReadAheadFillRate();
+
+  /*!
+   * \brief Get the measured throughput, in bytes per second, of the source
+   */
+  unsigned int GetReadAheadLinkRate();
+
+  /*!
+   * \brief Get the measured rate, in bytes per second, the demuxer reads from the file cache
+   */
+  unsigned int GetReadAheadConsumeRate();
+
 protected:
   std::atomic_bool m_hasAVInfoChanges;
 
@@ -163,4 +269,36 @@ protected:
     int64_t m_timeMax;
     int64_t m_timeMin;
   } m_timeInfo = {};
+
+  CCriticalSection m_packetPoolSection;
+  struct SPacketPoolInfo
+  {
+    uint64_t m_allocations;
+    uint64_t m_reused;
+    int64_t m_bytesInUse;
+    int64_t m_bytesCached;
+  } m_packetPoolInfo = {};
+
+  CCriticalSection m_audioLatencySection;
+  struct SAudioLatencyInfo
+  {
+    double m_stream;
+    double m_processing;
+    double m_engine;
+    double m_sink;
+    double m_device;
+    bool m_lowLatency;
+    unsigned int m_underruns;
+  } m_audioLatencyInfo = {};
+
+  CCriticalSection m_readAheadSection;
+  struct SReadAheadInfo
+  {
+    const void *m_owner;
+    int64_t m_forward;
+    int64_t m_back;
+    unsigned int m_fillRate;
+    unsigned int m_linkRate;
+    unsigned int m_consumeRate;
+  } m_readAheadInfo = {};
 };
@@ -568,6 +568,16 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
   m_startTime = 0;
 
+  // keep the keyframe index of local recordings so later seeks don't have to
+  // bisect or scan the file. matroska indexes keyframes itself, mpegts is fed from Read()
+  bool isMpegTs = strcmp(m_pFormatContext->iformat->name, "mpegts") == 0;
+  if (g_advancedSettings.m_videoSeekIndex && (m_bMatroska || isMpegTs) && !fileinfo &&
+      pInput->IsStreamType(DVDSTREAM_TYPE_FILE) && !pInput->IsRealtime() &&
+      m_ioContext && m_ioContext->seekable)
+  {
+    m_seekIndex.Attach(m_pFormatContext, pInput->GetFileName(), isMpegTs);
+  }
+
   // seems to be a bug in ffmpeg, hls jumps back to start after a couple of seconds
   // this cures the issue
   if (m_pFormatContext->iformat && strcmp(m_pFormatContext->iformat->name, "hls,applehttp") == 0)
@@ -585,6 +595,8 @@ void CDVDDemuxFFmpeg::Dispose()
 
   if (m_pFormatContext)
   {
+    m_seekIndex.Detach();
+
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
     {
       CLog::Log(LOGWARNING, "CDVDDemuxFFmpeg::Dispose - demuxer changed our byte context behind our back, possible memleak");
@@ -956,6 +968,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
 
       AVStream *stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
+      if (m_seekIndex.IsAttached())
+        m_seekIndex.Add(m_pkt.pkt);
+
       if (IsVideoReady())
       {
         if (m_program != UINT_MAX)
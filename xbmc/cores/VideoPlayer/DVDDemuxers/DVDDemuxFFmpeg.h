@@ -21,6 +21,7 @@
  */
 
 #include "DVDDemux.h"
+#include "DVDDemuxSeekIndex.h"
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
@@ -171,6 +172,7 @@ protected:
 
   bool m_streaminfo;
   bool m_checkvideo;
+  CDVDDemuxSeekIndex m_seekIndex;
   int m_displayTime = 0;
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
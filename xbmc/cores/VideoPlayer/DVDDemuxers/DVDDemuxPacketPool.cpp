@@ -0,0 +1,186 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDDemuxPacketPool.h"
+
+#include <algorithm>
+
+#include "threads/SingleLock.h"
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XMemUtils.h"
+#endif
+
+// size classes go from 1k up to 7M in steps of a quarter power of two
+#define POOL_MIN_SHIFT    10
+#define POOL_MAX_SHIFT    22
+#define POOL_HEADER_SIZE  16
+#define POOL_NO_CLASS     -1
+
+namespace
+{
+// stored in front of every buffer
+struct BufferHeader
+{
+  int sizeClass;
+  size_t capacity;
+};
+static_assert(sizeof(BufferHeader) <= POOL_HEADER_SIZE, "buffer header doesn't fit");
+
+BufferHeader* GetHeader(uint8_t *data)
+{
+  return reinterpret_cast<BufferHeader*>(data - POOL_HEADER_SIZE);
+}
+}
+
+CDVDDemuxPacketPool& CDVDDemuxPacketPool::GetInstance()
+{
+  // never destroyed, packets may still be freed by other static objects or
+  // threads during shutdown
+  static CDVDDemuxPacketPool *pool = new CDVDDemuxPacketPool();
+  return *pool;
+}
+
+CDVDDemuxPacketPool::CDVDDemuxPacketPool()
+  : m_allocations(0),
+    m_reused(0),
+    m_bytesInUse(0),
+    m_bytesCached(0)
+{
+  for (int shift = POOL_MIN_SHIFT; shift <= POOL_MAX_SHIFT; shift++)
+  {
+    for (size_t quarter = 4; quarter < 8; quarter++)
+    {
+      std::unique_ptr<SizeClass> sizeClass(new SizeClass());
+      sizeClass->capacity = quarter << (shift - 2);
+      m_classes.push_back(std::move(sizeClass));
+    }
+  }
+}
+
+CDVDDemuxPacketPool::~CDVDDemuxPacketPool()
+{
+  Trim();
+}
+
+int CDVDDemuxPacketPool::GetSizeClass(size_t size) const
+{
+  auto it = std::lower_bound(m_classes.begin(), m_classes.end(), size,
+                             [](const std::unique_ptr<SizeClass> &sizeClass, size_t size){
+                               return sizeClass->capacity < size;
+                             });
+  if (it == m_classes.end())
+    return POOL_NO_CLASS;
+
+  return static_cast<int>(it - m_classes.begin());
+}
+
+uint8_t* CDVDDemuxPacketPool::Allocate(size_t size)
+{
+  m_allocations++;
+
+  int index = GetSizeClass(size);
+  size_t capacity = size;
+  if (index != POOL_NO_CLASS)
+  {
+    SizeClass &sizeClass = *m_classes[index];
+    capacity = sizeClass.capacity;
+
+    uint8_t *data = nullptr;
+    {
+      CSingleLock lock(sizeClass.section);
+      if (!sizeClass.buffers.empty())
+      {
+        data = sizeClass.buffers.back();
+        sizeClass.buffers.pop_back();
+      }
+    }
+
+    if (data)
+    {
+      m_reused++;
+      m_bytesCached -= capacity;
+      m_bytesInUse += capacity;
+      return data;
+    }
+  }
+
+  uint8_t *block = static_cast<uint8_t*>(_aligned_malloc(capacity + POOL_HEADER_SIZE, 16));
+  if (!block)
+    return nullptr;
+
+  BufferHeader *header = reinterpret_cast<BufferHeader*>(block);
+  header->sizeClass = index;
+  header->capacity = capacity;
+
+  m_bytesInUse += capacity;
+  return block + POOL_HEADER_SIZE;
+}
+
+void CDVDDemuxPacketPool::Free(uint8_t *data)
+{
+  if (!data)
+    return;
+
+  BufferHeader *header = GetHeader(data);
+  m_bytesInUse -= header->capacity;
+
+  if (header->sizeClass != POOL_NO_CLASS && ReserveCached(header->capacity))
+  {
+    SizeClass &sizeClass = *m_classes[header->sizeClass];
+
+    CSingleLock lock(sizeClass.section);
+    sizeClass.buffers.push_back(data);
+    return;
+  }
+
+  _aligned_free(header);
+}
+
+bool CDVDDemuxPacketPool::ReserveCached(size_t capacity)
+{
+  // check and add in one step, so concurrent frees can't exceed the limit together
+  int64_t cached = m_bytesCached;
+  do
+  {
+    if (cached + static_cast<int64_t>(capacity) > DVD_PACKET_POOL_MAX_CACHED)
+      return false;
+  } while (!m_bytesCached.compare_exchange_weak(cached, cached + static_cast<int64_t>(capacity)));
+
+  return true;
+}
+
+void CDVDDemuxPacketPool::Trim()
+{
+  for (auto &sizeClass : m_classes)
+  {
+    std::vector<uint8_t*> buffers;
+    {
+      CSingleLock lock(sizeClass->section);
+      buffers.swap(sizeClass->buffers);
+    }
+
+    for (auto data : buffers)
+    {
+      m_bytesCached -= sizeClass->capacity;
+      _aligned_free(GetHeader(data));
+    }
+  }
+}
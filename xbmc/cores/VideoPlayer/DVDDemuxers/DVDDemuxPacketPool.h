@@ -0,0 +1,83 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+
+// upper limit of the memory kept around in unused buffers
+#define DVD_PACKET_POOL_MAX_CACHED (32 * 1024 * 1024)
+
+/*!
+ \brief Recycles the data buffers of demux packets.
+
+ Buffers are grouped into size classes (four per power of two, starting at
+ 1k) and returned to a free list of their class instead of the heap, so a
+ running stream reuses the same few buffers. Buffers larger than the
+ biggest class are allocated directly. Every buffer is 16 byte aligned and
+ can be freed from any thread.
+ */
+class CDVDDemuxPacketPool
+{
+public:
+  static CDVDDemuxPacketPool& GetInstance();
+
+  uint8_t* Allocate(size_t size);
+  void Free(uint8_t *data);
+
+  /*!
+   \brief Releases all buffers which are currently unused.
+   */
+  void Trim();
+
+  uint64_t GetAllocations() const { return m_allocations; }
+  uint64_t GetReused() const { return m_reused; }
+  int64_t GetBytesInUse() const { return m_bytesInUse; }
+  int64_t GetBytesCached() const { return m_bytesCached; }
+
+private:
+  CDVDDemuxPacketPool();
+  ~CDVDDemuxPacketPool();
+  CDVDDemuxPacketPool(const CDVDDemuxPacketPool&) = delete;
+  CDVDDemuxPacketPool& operator=(const CDVDDemuxPacketPool&) = delete;
+
+  struct SizeClass
+  {
+    size_t capacity;
+    CCriticalSection section;
+    std::vector<uint8_t*> buffers;
+  };
+
+  int GetSizeClass(size_t size) const;
+  bool ReserveCached(size_t capacity);
+
+  std::vector<std::unique_ptr<SizeClass>> m_classes;
+
+  std::atomic<uint64_t> m_allocations;
+  std::atomic<uint64_t> m_reused;
+  std::atomic<int64_t> m_bytesInUse;
+  std::atomic<int64_t> m_bytesCached;
+};
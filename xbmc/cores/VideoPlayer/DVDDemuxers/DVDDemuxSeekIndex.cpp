@@ -0,0 +1,271 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDDemuxSeekIndex.h"
+
+#include <vector>
+
+#include "FileItem.h"
+#include "XBDateTime.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Crc32.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+
+namespace
+{
+const uint32_t SEEKINDEX_MAGIC = 0x4B534958; // "KSIX"
+const uint32_t SEEKINDEX_VERSION = 2;
+const uint32_t SEEKINDEX_MAX_ENTRIES = 1 << 20;
+
+struct SeekIndexHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  int64_t fileSize;
+  int64_t fileTime;
+  int32_t codecId;
+  int32_t timeBaseNum;
+  int32_t timeBaseDen;
+  uint32_t count;
+};
+
+struct SeekIndexEntry
+{
+  int64_t pos;
+  int64_t timestamp;
+};
+}
+
+const char* const CDVDDemuxSeekIndex::DEFAULT_FOLDER = "special://thumbnails/seekindex/";
+
+CDVDDemuxSeekIndex::CDVDDemuxSeekIndex(const std::string& folder) : m_folder(folder)
+{
+}
+
+CDVDDemuxSeekIndex::~CDVDDemuxSeekIndex()
+{
+  Detach();
+}
+
+std::string CDVDDemuxSeekIndex::GetIndexFile(const std::string& path) const
+{
+  return StringUtils::Format("%s%08x.idx", m_folder.c_str(), Crc32::ComputeFromLowerCase(path));
+}
+
+void CDVDDemuxSeekIndex::Prune(int maxAgeDays, const std::string& folder)
+{
+  if (!XFILE::CDirectory::Exists(folder))
+    return;
+
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(folder, items, ".idx", XFILE::DIR_FLAG_NO_FILE_DIRS | XFILE::DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  CDateTime oldest = CDateTime::GetCurrentDateTime() - CDateTimeSpan(maxAgeDays, 0, 0, 0);
+  int removed = 0;
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    const CFileItemPtr item = items[i];
+    if (item->m_bIsFolder)
+      continue;
+    if (!item->m_dateTime.IsValid() || item->m_dateTime < oldest)
+    {
+      if (XFILE::CFile::Delete(item->GetPath()))
+        removed++;
+    }
+  }
+  CLog::Log(LOGDEBUG, "CDVDDemuxSeekIndex::%s - removed %i of %i index files", __FUNCTION__, removed, items.Size());
+}
+
+void CDVDDemuxSeekIndex::Attach(AVFormatContext* context, const std::string& path, bool collect)
+{
+  Detach();
+
+  if (!context || path.empty())
+    return;
+
+  struct __stat64 buffer;
+  if (XFILE::CFile::Stat(path, &buffer) != 0 || buffer.st_size <= 0 || !buffer.st_mtime)
+    return;
+
+  m_context = context;
+  m_indexFile = GetIndexFile(path);
+  m_fileSize = buffer.st_size;
+  m_fileTime = buffer.st_mtime;
+  m_collect = collect;
+
+  // mpegts may only create its streams once the first packets are read,
+  // in that case the sidecar is loaded from Add()
+  GetStream();
+}
+
+void CDVDDemuxSeekIndex::Detach()
+{
+  if (!m_context)
+    return;
+
+  AVStream* stream = GetStream();
+  if (stream && stream->nb_index_entries > m_loadedEntries)
+    Save();
+
+  m_context = nullptr;
+  m_indexFile.clear();
+  m_fileSize = -1;
+  m_fileTime = 0;
+  m_streamIndex = -1;
+  m_loadedEntries = 0;
+  m_collect = false;
+}
+
+void CDVDDemuxSeekIndex::Add(const AVPacket& pkt)
+{
+  if (!m_collect || !(pkt.flags & AV_PKT_FLAG_KEY))
+    return;
+
+  if (pkt.pos < 0 || pkt.dts == AV_NOPTS_VALUE)
+    return;
+
+  AVStream* stream = GetStream();
+  if (stream && pkt.stream_index == m_streamIndex)
+    av_add_index_entry(stream, pkt.pos, pkt.dts, 0, 0, AVINDEX_KEYFRAME);
+}
+
+AVStream* CDVDDemuxSeekIndex::GetStream()
+{
+  if (!m_context)
+    return nullptr;
+
+  if (m_streamIndex < 0)
+  {
+    if (m_context->nb_streams == 0)
+      return nullptr;
+
+    // av_seek_frame() with stream -1 converts the target to this stream,
+    // so it is the only one whose entries matter
+    m_streamIndex = av_find_default_stream_index(m_context);
+    if (m_streamIndex < 0 || m_streamIndex >= static_cast<int>(m_context->nb_streams))
+    {
+      m_streamIndex = -1;
+      return nullptr;
+    }
+
+    Load();
+  }
+
+  return m_context->streams[m_streamIndex];
+}
+
+void CDVDDemuxSeekIndex::Load()
+{
+  AVStream* stream = m_context->streams[m_streamIndex];
+  m_loadedEntries = stream->nb_index_entries;
+
+  XFILE::CFile file;
+  if (!file.Open(m_indexFile))
+    return;
+
+  SeekIndexHeader header;
+  if (file.Read(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      header.magic != SEEKINDEX_MAGIC ||
+      header.version != SEEKINDEX_VERSION ||
+      header.count > SEEKINDEX_MAX_ENTRIES)
+  {
+    CLog::Log(LOGWARNING, "CDVDDemuxSeekIndex::%s - invalid index file %s", __FUNCTION__, m_indexFile.c_str());
+    return;
+  }
+
+  // positions are only trustworthy for exactly the file they were collected from,
+  // a recording that grew or a file that was replaced gets a fresh index
+  if (header.fileSize != m_fileSize ||
+      header.fileTime != m_fileTime ||
+      header.codecId != stream->codecpar->codec_id ||
+      header.timeBaseNum != stream->time_base.num ||
+      header.timeBaseDen != stream->time_base.den)
+  {
+    CLog::Log(LOGDEBUG, "CDVDDemuxSeekIndex::%s - index file %s is stale", __FUNCTION__, m_indexFile.c_str());
+    file.Close();
+    XFILE::CFile::Delete(m_indexFile);
+    return;
+  }
+
+  std::vector<SeekIndexEntry> entries(header.count);
+  const ssize_t size = sizeof(SeekIndexEntry) * entries.size();
+  if (size > 0 && file.Read(entries.data(), size) != size)
+    return;
+
+  for (const auto& entry : entries)
+  {
+    if (entry.pos >= 0 && entry.pos < m_fileSize)
+      av_add_index_entry(stream, entry.pos, entry.timestamp, 0, 0, AVINDEX_KEYFRAME);
+  }
+  m_loadedEntries = stream->nb_index_entries;
+
+  CLog::Log(LOGDEBUG, "CDVDDemuxSeekIndex::%s - seeded %d index entries from %s", __FUNCTION__, m_loadedEntries, m_indexFile.c_str());
+}
+
+void CDVDDemuxSeekIndex::Save()
+{
+  AVStream* stream = m_context->streams[m_streamIndex];
+
+  std::vector<SeekIndexEntry> entries;
+  entries.reserve(stream->nb_index_entries);
+  for (int i = 0; i < stream->nb_index_entries; i++)
+  {
+    const AVIndexEntry& entry = stream->index_entries[i];
+    if ((entry.flags & AVINDEX_KEYFRAME) && entry.pos >= 0 && entry.timestamp != AV_NOPTS_VALUE)
+      entries.push_back({ entry.pos, entry.timestamp });
+  }
+
+  if (entries.empty() || entries.size() > SEEKINDEX_MAX_ENTRIES)
+    return;
+
+  if (!XFILE::CDirectory::Exists(m_folder) && !XFILE::CDirectory::Create(m_folder))
+    return;
+
+  SeekIndexHeader header;
+  header.magic = SEEKINDEX_MAGIC;
+  header.version = SEEKINDEX_VERSION;
+  header.fileSize = m_fileSize;
+  header.fileTime = m_fileTime;
+  header.codecId = stream->codecpar->codec_id;
+  header.timeBaseNum = stream->time_base.num;
+  header.timeBaseDen = stream->time_base.den;
+  header.count = static_cast<uint32_t>(entries.size());
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(m_indexFile, true))
+  {
+    CLog::Log(LOGERROR, "CDVDDemuxSeekIndex::%s - unable to write %s", __FUNCTION__, m_indexFile.c_str());
+    return;
+  }
+
+  const ssize_t size = sizeof(SeekIndexEntry) * entries.size();
+  if (file.Write(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      file.Write(entries.data(), size) != size)
+  {
+    file.Close();
+    XFILE::CFile::Delete(m_indexFile);
+    return;
+  }
+
+  CLog::Log(LOGDEBUG, "CDVDDemuxSeekIndex::%s - stored %u index entries in %s", __FUNCTION__, header.count, m_indexFile.c_str());
+}
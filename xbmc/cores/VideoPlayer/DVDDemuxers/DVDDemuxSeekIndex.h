@@ -0,0 +1,91 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string>
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+/*!
+ * \brief Keeps libavformat's keyframe index of a local recording across playbacks.
+ *
+ * MPEG-TS has no seek table and Matroska files written by recorders often
+ * lack cues, so libavformat has to bisect or scan the file on every seek.
+ * The index entries it collects while playing are stored in a sidecar file
+ * in the thumbnail cache and fed back into the default stream on the next
+ * open, which turns most seeks into a lookup plus a short read. A sidecar is
+ * only used while size and modification time of the media file are unchanged.
+ */
+class CDVDDemuxSeekIndex
+{
+public:
+  /*!
+   * \param folder folder the sidecar files are stored in
+   */
+  explicit CDVDDemuxSeekIndex(const std::string& folder = DEFAULT_FOLDER);
+  ~CDVDDemuxSeekIndex();
+
+  /*!
+   * \brief Attaches to an opened format context and seeds it from the sidecar file
+   * \param context format context owned by the demuxer
+   * \param path path of the media file, used to name the sidecar file and to
+   *        check that the file hasn't changed since the sidecar was written
+   * \param collect true if the demuxer does not index keyframes itself and Add() should be used
+   */
+  void Attach(AVFormatContext* context, const std::string& path, bool collect);
+
+  /*!
+   * \brief Stores the index if it grew since Attach() and releases the format context
+   */
+  void Detach();
+
+  /*!
+   * \brief Records the position of a keyframe read by the demuxer
+   */
+  void Add(const AVPacket& pkt);
+
+  bool IsAttached() const { return m_context != nullptr; }
+
+  std::string GetIndexFile(const std::string& path) const;
+
+  /*!
+   * \brief Removes sidecar files that haven't been written for the given number of days
+   */
+  static void Prune(int maxAgeDays, const std::string& folder = DEFAULT_FOLDER);
+
+  static const char* const DEFAULT_FOLDER;
+
+private:
+  AVStream* GetStream();
+  void Load();
+  void Save();
+
+  const std::string m_folder;
+  AVFormatContext* m_context = nullptr;
+  std::string m_indexFile;
+  int64_t m_fileSize = -1;
+  int64_t m_fileTime = 0;
+  int m_streamIndex = -1;
+  int m_loadedEntries = 0;
+  bool m_collect = false;
+};
@@ -0,0 +1,107 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxPacketPool.h"
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <thread>
+#include <vector>
+
+class TestDVDDemuxPacketPool : public ::testing::Test
+{
+protected:
+  CDVDDemuxPacketPool &pool = CDVDDemuxPacketPool::GetInstance();
+
+  void SetUp() override
+  {
+    pool.Trim();
+  }
+
+  void TearDown() override
+  {
+    pool.Trim();
+  }
+};
+
+TEST_F(TestDVDDemuxPacketPool, Reuse)
+{
+  uint64_t reused = pool.GetReused();
+
+  uint8_t *data = pool.Allocate(3000);
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(data) % 16);
+  memset(data, 0xff, 3000);
+  pool.Free(data);
+  EXPECT_LT(0, pool.GetBytesCached());
+
+  // a smaller packet of the same size class gets the same buffer
+  uint8_t *again = pool.Allocate(2900);
+  EXPECT_EQ(data, again);
+  EXPECT_EQ(reused + 1, pool.GetReused());
+  pool.Free(again);
+}
+
+TEST_F(TestDVDDemuxPacketPool, Oversized)
+{
+  int64_t cached = pool.GetBytesCached();
+
+  // larger than the biggest size class, goes straight back to the heap
+  uint8_t *data = pool.Allocate(16 * 1024 * 1024);
+  ASSERT_NE(nullptr, data);
+  pool.Free(data);
+  EXPECT_EQ(cached, pool.GetBytesCached());
+}
+
+TEST_F(TestDVDDemuxPacketPool, CacheLimit)
+{
+  const int threads = 8;
+  const int buffers = 8;
+  const size_t size = 4 * 1024 * 1024;
+
+  // hold more than the cache limit and free it from several threads at once
+  std::vector<std::vector<uint8_t*>> data(threads);
+  for (auto &list : data)
+  {
+    for (int i = 0; i < buffers; i++)
+      list.push_back(pool.Allocate(size));
+  }
+
+  int64_t inUse = pool.GetBytesInUse();
+  EXPECT_GE(inUse, static_cast<int64_t>(threads * buffers * size));
+
+  std::vector<std::thread> workers;
+  for (auto &list : data)
+  {
+    workers.emplace_back([this, &list]() {
+      for (auto buffer : list)
+        pool.Free(buffer);
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  EXPECT_LE(pool.GetBytesCached(), DVD_PACKET_POOL_MAX_CACHED);
+  EXPECT_GT(pool.GetBytesCached(), DVD_PACKET_POOL_MAX_CACHED - static_cast<int64_t>(2 * size));
+  EXPECT_EQ(inUse - static_cast<int64_t>(threads * buffers * size), pool.GetBytesInUse());
+
+  pool.Trim();
+  EXPECT_EQ(0, pool.GetBytesCached());
+}
@@ -0,0 +1,153 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxSeekIndex.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+const char* const INDEX_FOLDER = "special://temp/seekindex/";
+const char* const MEDIA_FILE = "special://temp/seekindex_media.ts";
+const int ENTRIES = 10;
+}
+
+class TestDVDDemuxSeekIndex : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    WriteMedia(4096);
+  }
+
+  void TearDown() override
+  {
+    for (auto context : m_contexts)
+      avformat_free_context(context);
+    XFILE::CFile::Delete(MEDIA_FILE);
+    XFILE::CDirectory::RemoveRecursive(INDEX_FOLDER);
+  }
+
+  void WriteMedia(size_t size)
+  {
+    std::vector<char> data(size, 0x47);
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(MEDIA_FILE, true));
+    ASSERT_EQ(static_cast<ssize_t>(size), file.Write(data.data(), size));
+  }
+
+  AVFormatContext* CreateContext()
+  {
+    AVFormatContext* context = avformat_alloc_context();
+    AVStream* stream = avformat_new_stream(context, nullptr);
+    stream->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+    stream->codecpar->codec_id = AV_CODEC_ID_H264;
+    stream->time_base = { 1, 90000 };
+    m_contexts.push_back(context);
+    return context;
+  }
+
+  // plays the file once and lets the index collect keyframes
+  void Play()
+  {
+    CDVDDemuxSeekIndex index(INDEX_FOLDER);
+    index.Attach(CreateContext(), MEDIA_FILE, true);
+    ASSERT_TRUE(index.IsAttached());
+
+    AVPacket pkt;
+    av_init_packet(&pkt);
+    pkt.flags = AV_PKT_FLAG_KEY;
+    pkt.stream_index = 0;
+    for (int i = 0; i < ENTRIES; i++)
+    {
+      pkt.pos = i * 188;
+      pkt.dts = i * 90000;
+      index.Add(pkt);
+    }
+  }
+
+  // opens the file again and returns the number of entries seeded from the sidecar
+  int Reopen()
+  {
+    CDVDDemuxSeekIndex index(INDEX_FOLDER);
+    AVFormatContext* context = CreateContext();
+    index.Attach(context, MEDIA_FILE, false);
+    return context->streams[0]->nb_index_entries;
+  }
+
+  std::vector<AVFormatContext*> m_contexts;
+};
+
+TEST_F(TestDVDDemuxSeekIndex, Roundtrip)
+{
+  Play();
+  CDVDDemuxSeekIndex index(INDEX_FOLDER);
+  EXPECT_TRUE(XFILE::CFile::Exists(index.GetIndexFile(MEDIA_FILE)));
+
+  AVFormatContext* context = CreateContext();
+  index.Attach(context, MEDIA_FILE, false);
+  AVStream* stream = context->streams[0];
+  ASSERT_EQ(ENTRIES, stream->nb_index_entries);
+  for (int i = 0; i < ENTRIES; i++)
+  {
+    EXPECT_EQ(i * 188, stream->index_entries[i].pos);
+    EXPECT_EQ(i * 90000, stream->index_entries[i].timestamp);
+  }
+}
+
+TEST_F(TestDVDDemuxSeekIndex, ChangedFileIsStale)
+{
+  Play();
+
+  // a recording that kept growing after the index was stored
+  WriteMedia(8192);
+  EXPECT_EQ(0, Reopen());
+
+  // the stale sidecar is dropped right away
+  CDVDDemuxSeekIndex index(INDEX_FOLDER);
+  EXPECT_FALSE(XFILE::CFile::Exists(index.GetIndexFile(MEDIA_FILE)));
+}
+
+TEST_F(TestDVDDemuxSeekIndex, DifferentStreamIsStale)
+{
+  Play();
+
+  CDVDDemuxSeekIndex index(INDEX_FOLDER);
+  AVFormatContext* context = CreateContext();
+  context->streams[0]->time_base = { 1, 1000 };
+  index.Attach(context, MEDIA_FILE, false);
+  EXPECT_EQ(0, context->streams[0]->nb_index_entries);
+}
+
+TEST_F(TestDVDDemuxSeekIndex, Prune)
+{
+  Play();
+  CDVDDemuxSeekIndex index(INDEX_FOLDER);
+  const std::string indexFile = index.GetIndexFile(MEDIA_FILE);
+
+  CDVDDemuxSeekIndex::Prune(30, INDEX_FOLDER);
+  EXPECT_TRUE(XFILE::CFile::Exists(indexFile));
+
+  CDVDDemuxSeekIndex::Prune(-1, INDEX_FOLDER);
+  EXPECT_FALSE(XFILE::CFile::Exists(indexFile));
+}
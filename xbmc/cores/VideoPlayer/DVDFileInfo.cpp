@@ -23,6 +23,10 @@
 #include "FileItem.h"
 #include "settings/AdvancedSettings.h"
 #include "pictures/Picture.h"
+#include "pictures/PictureScaler.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
 #include "video/VideoInfoTag.h"
 #include "filesystem/StackDirectory.h"
 #include "utils/log.h"
@@ -54,6 +58,7 @@
 #include "utils/LangCodeExpander.h"
 
 #include <cstdlib>
+#include <deque>
 #include <memory>
 
 extern "C" {
@@ -98,34 +103,74 @@ int DegreeToOrientation(int degrees)
   }
 }
 
-bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
-                                CTextureDetails &details,
-                                CStreamDetails *pStreamDetails, int pos)
+namespace
 {
-  std::string redactPath = CURL::GetRedacted(strPath);
-  unsigned int nTime = XbmcThreads::SystemClockMillis();
-  CFileItem item(strPath, false);
+
+// decoded frames waiting for the encoder, each one is a scaled BGRA image
+const size_t MAX_PENDING_THUMBS = 2;
+
+/* the input stream, demuxer and software decoder of a file, kept open while
+   thumbs are taken at several positions */
+class CThumbSource
+{
+public:
+  explicit CThumbSource(const std::string &path)
+  : m_path(path), m_redactPath(CURL::GetRedacted(path))
+  {
+  }
+
+  ~CThumbSource()
+  {
+    m_codec.reset();
+    delete m_demuxer;
+  }
+
+  /* false if the file could not be opened at all, which is not worth remembering as a failed thumb */
+  bool Open(CStreamDetails *pStreamDetails);
+
+  /* seeks to pos in ms, -1 for a third into the file, and returns the decoded
+     frame scaled to an av_malloc'ed BGRA buffer */
+  uint8_t* Extract(int pos, unsigned int &width, unsigned int &height, int &orientation);
+
+  const std::string& GetRedactedPath() const { return m_redactPath; }
+  int GetPacketsTried() const { return m_packetsTried; }
+
+private:
+  std::string m_path;
+  std::string m_redactPath;
+  std::shared_ptr<CDVDInputStream> m_inputStream;
+  CDVDDemux *m_demuxer = nullptr;
+  std::unique_ptr<CProcessInfo> m_processInfo;
+  std::unique_ptr<CDVDVideoCodec> m_codec;
+  std::unique_ptr<CDVDStreamInfo> m_hint;
+  VideoPicture m_picture = {};
+  int m_videoStream = -1;
+  int m_packetsTried = 0;
+  bool m_decoded = false;
+};
+
+bool CThumbSource::Open(CStreamDetails *pStreamDetails)
+{
+  CFileItem item(m_path, false);
 
   item.SetMimeTypeForInternetFile();
-  auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
-  if (!pInputStream)
+  m_inputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
+  if (!m_inputStream)
   {
-    CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", redactPath.c_str());
+    CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", m_redactPath.c_str());
     return false;
   }
 
-  if (!pInputStream->Open())
+  if (!m_inputStream->Open())
   {
-    CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
+    CLog::Log(LOGERROR, "InputStream: Error opening, %s", m_redactPath.c_str());
     return false;
   }
 
-  CDVDDemux *pDemuxer = NULL;
-
   try
   {
-    pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
-    if(!pDemuxer)
+    m_demuxer = CDVDFactoryDemuxer::CreateDemuxer(m_inputStream, true);
+    if(!m_demuxer)
     {
       CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
       return false;
@@ -134,8 +179,9 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
   catch(...)
   {
     CLog::Log(LOGERROR, "%s - Exception thrown when opening demuxer", __FUNCTION__);
-    if (pDemuxer)
-      delete pDemuxer;
+    if (m_demuxer)
+      delete m_demuxer;
+    m_demuxer = nullptr;
 
     return false;
   }
@@ -143,15 +189,15 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
   if (pStreamDetails)
   {
 
-    DemuxerToStreamDetails(pInputStream, pDemuxer, *pStreamDetails, strPath);
+    CDVDFileInfo::DemuxerToStreamDetails(m_inputStream, m_demuxer, *pStreamDetails, m_path);
 
     //extern subtitles
     std::vector<std::string> filenames;
     std::string video_path;
-    if (strPath.empty())
-      video_path = pInputStream->GetFileName();
+    if (m_path.empty())
+      video_path = m_inputStream->GetFileName();
     else
-      video_path = strPath;
+      video_path = m_path;
 
     CUtil::ScanForExternalSubtitles(video_path, filenames);
 
@@ -162,151 +208,320 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
       {
         std::string strSubFile;
         if ( CUtil::FindVobSubPair(filenames, filenames[i], strSubFile) )
-          AddExternalSubtitleToDetails(video_path, *pStreamDetails, filenames[i], strSubFile);
+          CDVDFileInfo::AddExternalSubtitleToDetails(video_path, *pStreamDetails, filenames[i], strSubFile);
       }
       else
       {
         if ( !CUtil::IsVobSub(filenames, filenames[i]) )
         {
-          AddExternalSubtitleToDetails(video_path, *pStreamDetails, filenames[i]);
+          CDVDFileInfo::AddExternalSubtitleToDetails(video_path, *pStreamDetails, filenames[i]);
         }
       }
     }
   }
 
-  int nVideoStream = -1;
   int64_t demuxerId = -1;
-  for (CDemuxStream* pStream : pDemuxer->GetStreams())
+  for (CDemuxStream* pStream : m_demuxer->GetStreams())
   {
     if (pStream)
     {
       // ignore if it's a picture attachment (e.g. jpeg artwork)
       if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
       {
-        nVideoStream = pStream->uniqueId;
+        m_videoStream = pStream->uniqueId;
         demuxerId = pStream->demuxerId;
       }
       else
-        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+        m_demuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
     }
   }
 
-  bool bOk = false;
-  int packetsTried = 0;
+  // a file without video is still open, there is just nothing to extract
+  if (m_videoStream == -1)
+    return true;
+
+  m_processInfo.reset(CProcessInfo::CreateInstance());
+  std::vector<AVPixelFormat> pixFmts;
+  pixFmts.push_back(AV_PIX_FMT_YUV420P);
+  m_processInfo->SetPixFormats(pixFmts);
+
+  m_hint.reset(new CDVDStreamInfo(*m_demuxer->GetStream(demuxerId, m_videoStream), true));
+  m_hint->codecOptions = CODEC_FORCE_SOFTWARE;
+
+  m_codec.reset(CDVDFactoryCodec::CreateVideoCodec(*m_hint, *m_processInfo));
+  return true;
+}
+
+uint8_t* CThumbSource::Extract(int pos, unsigned int &width, unsigned int &height, int &orientation)
+{
+  if (!m_codec)
+    return nullptr;
+
+  int nTotalLen = m_demuxer->GetStreamLength();
+  int nSeekTo = (pos==-1) ? nTotalLen / 3 : pos;
 
-  if (nVideoStream != -1)
+  CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, m_redactPath.c_str());
+  if (!m_demuxer->SeekTime(nSeekTo, true))
+    return nullptr;
+
+  // frames of the previous position must not leak into this one
+  if (m_decoded)
+    m_codec->Reset();
+  m_decoded = true;
+
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = m_demuxer->GetNrOfStreams() * 160;
+  do
   {
-    CDVDVideoCodec *pVideoCodec;
-    std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
-    std::vector<AVPixelFormat> pixFmts;
-    pixFmts.push_back(AV_PIX_FMT_YUV420P);
-    pProcessInfo->SetPixFormats(pixFmts);
+    DemuxPacket* pPacket = m_demuxer->Read();
+    m_packetsTried++;
 
-    CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+    if (!pPacket)
+      break;
 
-    pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
+    if (pPacket->iStreamId != m_videoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    m_codec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
 
-    if (pVideoCodec)
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int nSeekTo = (pos==-1) ? nTotalLen / 3 : pos;
+      iDecoderState = m_codec->GetPicture(&m_picture);
+    }
 
-      CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(nSeekTo, true))
-      {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if(!(m_picture.iFlags & DVP_FLAG_DROPPED))
+        break;
+    }
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
+  } while (abort_index--);
 
-          if (!pPacket)
-            break;
+  if (iDecoderState != CDVDVideoCodec::VC_PICTURE || (m_picture.iFlags & DVP_FLAG_DROPPED))
+  {
+    CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, m_redactPath.c_str(), m_packetsTried);
+    return nullptr;
+  }
 
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
+  unsigned int nWidth = std::min(m_picture.iDisplayWidth, g_advancedSettings.m_imageRes);
+  double aspect = (double)m_picture.iDisplayWidth / (double)m_picture.iDisplayHeight;
+  if(m_hint->forced_aspect && m_hint->aspect != 0)
+    aspect = m_hint->aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
+  uint8_t *planes[YuvImage::MAX_PLANES];
+  int stride[YuvImage::MAX_PLANES];
+  m_picture.videoBuffer->GetPlanes(planes);
+  m_picture.videoBuffer->GetStrides(stride);
+  uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+  int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+  uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+  int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+
+  if (!CPictureScaler::Scale(m_picture.videoBuffer->GetFormat(), src, srcStride, m_picture.iWidth, m_picture.iHeight,
+                             AV_PIX_FMT_BGRA, dst, dstStride, nWidth, nHeight, SWS_FAST_BILINEAR))
+  {
+    av_free(pOutBuf);
+    return nullptr;
+  }
 
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+  width = nWidth;
+  height = nHeight;
+  orientation = DegreeToOrientation(m_hint->orientation);
+  return pOutBuf;
+}
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+/* encodes and writes the thumbs on its own thread, so the source can seek and
+   decode the next position meanwhile */
+class CThumbEncoder : private IRunnable
+{
+public:
+  CThumbEncoder() : m_thread(this, "ThumbEncoder")
+  {
+    m_thread.Create();
+  }
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
-          {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
-          }
+  ~CThumbEncoder() override
+  {
+    Finish();
+  }
 
-        } while (abort_index--);
+  /* takes the av_malloc'ed pixels, blocks while the encoder is behind */
+  void Add(unsigned int index, uint8_t *pixels, unsigned int width, unsigned int height,
+           int orientation, const std::string &file)
+  {
+    CSingleLock lock(m_section);
+    while (m_queue.size() >= MAX_PENDING_THUMBS)
+      m_condition.wait(lock);
+    m_queue.push_back({ index, pixels, width, height, orientation, file });
+    m_condition.notifyAll();
+  }
 
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, g_advancedSettings.m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
-        }
-      }
-      delete pVideoCodec;
+  /* positions encoded since the last call and whether they succeeded */
+  std::vector<std::pair<unsigned int, bool>> TakeCompleted()
+  {
+    CSingleLock lock(m_section);
+    std::vector<std::pair<unsigned int, bool>> completed;
+    completed.swap(m_completed);
+    return completed;
+  }
+
+  /* encodes what is queued and stops the thread */
+  void Finish()
+  {
+    {
+      CSingleLock lock(m_section);
+      m_finish = true;
+      m_condition.notifyAll();
     }
+    m_thread.StopThread(true);
   }
 
-  if (pDemuxer)
-    delete pDemuxer;
+private:
+  struct Frame
+  {
+    unsigned int index;
+    uint8_t *pixels;
+    unsigned int width;
+    unsigned int height;
+    int orientation;
+    std::string file;
+  };
+
+  void Run() override
+  {
+    CSingleLock lock(m_section);
+    while (true)
+    {
+      while (m_queue.empty() && !m_finish)
+        m_condition.wait(lock);
+      if (m_queue.empty())
+        break;
+
+      Frame frame = m_queue.front();
+      m_queue.pop_front();
+      m_condition.notifyAll();
+
+      lock.Leave();
+      unsigned int width = frame.width;
+      unsigned int height = frame.height;
+      bool success = CPicture::CacheTexture(frame.pixels, frame.width, frame.height, frame.width * 4,
+                                            frame.orientation, width, height,
+                                            CTextureCache::GetCachedPath(frame.file));
+      av_free(frame.pixels);
+      lock.Enter();
+
+      m_completed.push_back(std::make_pair(frame.index, success));
+    }
+  }
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_condition;
+  std::deque<Frame> m_queue;
+  std::vector<std::pair<unsigned int, bool>> m_completed;
+  bool m_finish = false;
+  CThread m_thread;
+};
+
+void MarkThumbFailed(const CTextureDetails &details)
+{
+  // an empty cache file keeps us from trying this file again
+  XFILE::CFile file;
+  if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
+    file.Close();
+}
+
+}
+
+bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
+                                CTextureDetails &details,
+                                CStreamDetails *pStreamDetails, int pos)
+{
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
+  CThumbSource source(strPath);
+  bool bOk = false;
+
+  if (!source.Open(pStreamDetails))
+    return false;
+
+  unsigned int nWidth, nHeight;
+  int orientation;
+  uint8_t *pOutBuf = source.Extract(pos, nWidth, nHeight, orientation);
+  if (pOutBuf)
+  {
+    details.width = nWidth;
+    details.height = nHeight;
+    CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+    av_free(pOutBuf);
+    bOk = true;
+  }
 
   if(!bOk)
+    MarkThumbFailed(details);
+
+  unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, source.GetRedactedPath().c_str(), source.GetPacketsTried());
+  return bOk;
+}
+
+bool CDVDFileInfo::ExtractThumbs(const std::string &strPath,
+                                 const std::vector<int> &positions,
+                                 std::vector<CTextureDetails> &details,
+                                 const std::function<bool(unsigned int, bool)> &completed)
+{
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
+  CThumbSource source(strPath);
+  bool bOk = false;
+  bool abort = false;
+
+  auto report = [&](unsigned int index, bool success)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    if (success)
+      bOk = true;
+    else
+      MarkThumbFailed(details[index]);
+    if (completed && completed(index, success))
+      abort = true;
+  };
+
+  if (!source.Open(nullptr))
+    return false;
+
+  {
+    CThumbEncoder encoder;
+    for (unsigned int i = 0; i < positions.size() && !abort; i++)
+    {
+      unsigned int nWidth, nHeight;
+      int orientation;
+      uint8_t *pOutBuf = source.Extract(positions[i], nWidth, nHeight, orientation);
+      if (pOutBuf)
+      {
+        details[i].width = nWidth;
+        details[i].height = nHeight;
+        encoder.Add(i, pOutBuf, nWidth, nHeight, orientation, details[i].file);
+      }
+      else
+        report(i, false);
+
+      for (auto &result : encoder.TakeCompleted())
+        report(result.first, result.second);
+    }
+
+    encoder.Finish();
+    for (auto &result : encoder.TakeCompleted())
+      report(result.first, result.second);
   }
 
   unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract %u thumbs from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, (unsigned int)positions.size(), source.GetRedactedPath().c_str(), source.GetPacketsTried());
   return bOk;
 }
 
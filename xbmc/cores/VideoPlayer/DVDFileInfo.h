@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,19 @@ public:
                            CTextureDetails &details,
                            CStreamDetails *pStreamDetails, int pos=-1);
 
+  /** \brief Extract thumbnails at several positions of the media at strPath, e.g. for chapters.
+  *   The demuxer and decoder stay open across the seeks and each thumb is encoded on a
+  *   separate thread while the next position decodes.
+  *   \param positions The positions in ms to extract thumbs from.
+  *   \param[in,out] details The texture details of each position, file has to be set by the caller.
+  *   \param completed Called on the calling thread for every finished position, returning true aborts.
+  *   \return true if at least one thumb was extracted.
+  */
+  static bool ExtractThumbs(const std::string &strPath,
+                            const std::vector<int> &positions,
+                            std::vector<CTextureDetails> &details,
+                            const std::function<bool(unsigned int index, bool extracted)> &completed);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(std::shared_ptr<CDVDInputStream> pInputStream, CDVDDemux *pDemux, CStreamDetails &details, const std::string &path = "");
@@ -17,7 +17,6 @@
  *  <http://www.gnu.org/licenses/>.
  *
  */
-
 #include "DVDMessageQueue.h"
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 #include "utils/log.h"
@@ -25,11 +24,16 @@
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "math.h"
 
-CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner)
+// number of messages which can be put without locking before the consumer
+// has to catch up, if it is full Put() falls back to taking the lock
+#define MSGQ_INBOX_SIZE 1024
+
+CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner), m_inbox(MSGQ_INBOX_SIZE)
 {
   m_iDataSize     = 0;
   m_bAbortRequest = false;
   m_bInitialized = false;
+  m_waiting = false;
 
   m_TimeBack = DVD_NOPTS_VALUE;
   m_TimeFront = DVD_NOPTS_VALUE;
@@ -45,6 +49,11 @@ CDVDMessageQueue::~CDVDMessageQueue()
 
 void CDVDMessageQueue::Init()
 {
+  CSingleLock lock(m_section);
+
+  // drop messages which raced with End()
+  DiscardInbox();
+
   m_iDataSize = 0;
   m_bAbortRequest = false;
   m_bInitialized = true;
@@ -57,13 +66,17 @@ void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 {
   CSingleLock lock(m_section);
 
-  m_messages.remove_if([type](const DVDMessageListItem &item){
-    return type == CDVDMsg::NONE || item.message->IsType(type);
-  });
+  DrainInbox();
 
-  m_prioMessages.remove_if([type](const DVDMessageListItem &item){
+  auto matches = [type](const DVDMessageListItem &item){
     return type == CDVDMsg::NONE || item.message->IsType(type);
-  });
+  };
+
+  m_messages.erase(std::remove_if(m_messages.begin(), m_messages.end(), matches),
+                   m_messages.end());
+
+  m_prioMessages.erase(std::remove_if(m_prioMessages.begin(), m_prioMessages.end(), matches),
+                       m_prioMessages.end());
 
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
@@ -87,9 +100,11 @@ void CDVDMessageQueue::End()
 {
   CSingleLock lock(m_section);
 
+  // stop the lock-free path first, so that nothing new gets into the inbox
+  m_bInitialized = false;
+
   Flush(CDVDMsg::NONE);
 
-  m_bInitialized = false;
   m_iDataSize = 0;
   m_bAbortRequest = false;
 }
@@ -106,6 +121,33 @@ MsgQueueReturnCode CDVDMessageQueue::PutBack(CDVDMsg* pMsg, int priority)
 
 MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front)
 {
+  if (!pMsg)
+  {
+    CLog::Log(LOGFATAL, "CDVDMessageQueue(%s)::Put MSGQ_INVALID_MSG", m_owner.c_str());
+    return MSGQ_INVALID_MSG;
+  }
+
+  // the common case of appending a normal message only pushes it into the
+  // inbox, the inbox takes over the reference of the caller. The level is
+  // updated by whoever moves it over to m_messages while holding the lock.
+  if (priority == 0 && front && m_bInitialized && m_inbox.Push(pMsg))
+  {
+    // make sure a consumer going to sleep either sees the message or we see it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiting)
+      m_hEvent.Set();
+
+    // End() may have flushed the queue between our check and the push
+    if (!m_bInitialized)
+    {
+      CSingleLock lock(m_section);
+      if (!m_bInitialized)
+        DiscardInbox();
+    }
+
+    return MSGQ_OK;
+  }
+
   CSingleLock lock(m_section);
 
   if (!m_bInitialized)
@@ -114,11 +156,6 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
     pMsg->Release();
     return MSGQ_NOT_INITIALIZED;
   }
-  if (!pMsg)
-  {
-    CLog::Log(LOGFATAL, "CDVDMessageQueue(%s)::Put MSGQ_INVALID_MSG", m_owner.c_str());
-    return MSGQ_INVALID_MSG;
-  }
 
   if (priority > 0)
   {
@@ -134,30 +171,9 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
   }
   else
   {
-    if (m_messages.empty())
-    {
-      m_iDataSize = 0;
-      m_TimeBack = DVD_NOPTS_VALUE;
-      m_TimeFront = DVD_NOPTS_VALUE;
-    }
-
-    if (front)
-      m_messages.emplace_front(pMsg, priority);
-    else
-      m_messages.emplace_back(pMsg, priority);
-  }
-
-  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
-  {
-    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
-    if (packet)
-    {
-      m_iDataSize += packet->iSize;
-      if (front)
-        UpdateTimeFront();
-      else
-        UpdateTimeBack();
-    }
+    // keep the order with messages that have been put without locking
+    DrainInbox();
+    AddMessage(pMsg, priority, front);
   }
 
   pMsg->Release();
@@ -184,7 +200,9 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
 
   while (!m_bAbortRequest)
   {
-    std::list<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
+    DrainInbox();
+
+    std::deque<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
 
     if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
     {
@@ -214,10 +232,24 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     else
     {
       m_hEvent.Reset();
+      m_waiting = true;
+
+      // a message may have been put without locking before we were seen waiting
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      size_t pending = m_messages.size();
+      DrainInbox();
+      if (m_messages.size() != pending)
+      {
+        m_waiting = false;
+        continue;
+      }
+
       lock.Leave();
 
       // wait for a new message
-      if (!m_hEvent.WaitMSec(iTimeoutInMilliSeconds))
+      bool signaled = m_hEvent.WaitMSec(iTimeoutInMilliSeconds);
+      m_waiting = false;
+      if (!signaled)
         return MSGQ_TIMEOUT;
 
       lock.Enter();
@@ -230,7 +262,53 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
   return (MsgQueueReturnCode)ret;
 }
 
-void CDVDMessageQueue::UpdateTimeFront()
+void CDVDMessageQueue::DrainInbox() const
+{
+  // the inbox is ordered oldest first, the newest message goes to the front
+  CDVDMsg* msg;
+  while (m_inbox.Pop(msg))
+  {
+    AddMessage(msg, 0, true);
+    msg->Release();
+  }
+}
+
+void CDVDMessageQueue::DiscardInbox()
+{
+  CDVDMsg* msg;
+  while (m_inbox.Pop(msg))
+    msg->Release();
+}
+
+void CDVDMessageQueue::AddMessage(CDVDMsg* pMsg, int priority, bool front) const
+{
+  if (m_messages.empty())
+  {
+    m_iDataSize = 0;
+    m_TimeBack = DVD_NOPTS_VALUE;
+    m_TimeFront = DVD_NOPTS_VALUE;
+  }
+
+  if (front)
+    m_messages.emplace_front(pMsg, priority);
+  else
+    m_messages.emplace_back(pMsg, priority);
+
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
+  {
+    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
+    if (packet)
+    {
+      m_iDataSize += packet->iSize;
+      if (front)
+        UpdateTimeFront();
+      else
+        UpdateTimeBack();
+    }
+  }
+}
+
+void CDVDMessageQueue::UpdateTimeFront() const
 {
   if (!m_messages.empty())
   {
@@ -252,7 +330,7 @@ void CDVDMessageQueue::UpdateTimeFront()
   }
 }
 
-void CDVDMessageQueue::UpdateTimeBack()
+void CDVDMessageQueue::UpdateTimeBack() const
 {
   if (!m_messages.empty())
   {
@@ -281,6 +359,8 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
   if (!m_bInitialized)
     return 0;
 
+  DrainInbox();
+
   unsigned count = 0;
   for (const auto &item : m_messages)
   {
@@ -315,10 +395,20 @@ void CDVDMessageQueue::WaitUntilEmpty()
   }
 }
 
+int CDVDMessageQueue::GetDataSize() const
+{
+  CSingleLock lock(m_section);
+
+  DrainInbox();
+  return m_iDataSize;
+}
+
 int CDVDMessageQueue::GetLevel() const
 {
   CSingleLock lock(m_section);
 
+  DrainInbox();
+
   if (m_iDataSize > m_iMaxDataSize)
     return 100;
   if (m_iDataSize == 0)
@@ -345,6 +435,8 @@ int CDVDMessageQueue::GetTimeSize() const
 {
   CSingleLock lock(m_section);
 
+  DrainInbox();
+
   if (IsDataBased())
     return 0;
   else
@@ -353,6 +445,8 @@ int CDVDMessageQueue::GetTimeSize() const
 
 bool CDVDMessageQueue::IsDataBased() const
 {
+  CSingleLock lock(m_section);
+
   return (m_TimeBack == DVD_NOPTS_VALUE  ||
           m_TimeFront == DVD_NOPTS_VALUE ||
           m_TimeFront <= m_TimeBack);
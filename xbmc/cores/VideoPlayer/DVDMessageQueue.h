@@ -23,10 +23,11 @@
 #include "DVDMessage.h"
 #include <atomic>
 #include <string>
-#include <list>
+#include <deque>
 #include <algorithm>
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
+#include "threads/LockFreeQueue.h"
 
 struct DVDMessageListItem
 {
@@ -41,6 +42,12 @@ struct DVDMessageListItem
     priority = 0;
   }
   DVDMessageListItem(const DVDMessageListItem&) = delete;
+  DVDMessageListItem(DVDMessageListItem&& other)
+  {
+    message = other.message;
+    priority = other.priority;
+    other.message = NULL;
+  }
  ~DVDMessageListItem()
   {
     if(message)
@@ -48,6 +55,18 @@ struct DVDMessageListItem
   }
 
   DVDMessageListItem& operator=(const DVDMessageListItem&) = delete;
+  DVDMessageListItem& operator=(DVDMessageListItem&& other)
+  {
+    if (this != &other)
+    {
+      if(message)
+        message->Release();
+      message = other.message;
+      priority = other.priority;
+      other.message = NULL;
+    }
+    return *this;
+  }
 
   CDVDMsg* message;
   int priority;
@@ -91,7 +110,7 @@ public:
     return Get(pMsg, iTimeoutInMilliSeconds, priority);
   }
 
-  int GetDataSize() const { return m_iDataSize; }
+  int GetDataSize() const;
   int GetTimeSize() const;
   unsigned GetPacketCount(CDVDMsg::Message type);
   bool ReceivedAbortRequest() { return m_bAbortRequest; }
@@ -111,25 +130,34 @@ public:
 private:
 
   MsgQueueReturnCode Put(CDVDMsg* pMsg, int priority, bool front);
-  void UpdateTimeFront();
-  void UpdateTimeBack();
+  void AddMessage(CDVDMsg* pMsg, int priority, bool front) const;
+  void UpdateTimeFront() const;
+  void UpdateTimeBack() const;
+  void DrainInbox() const;
+  void DiscardInbox();
 
   CEvent m_hEvent;
   mutable CCriticalSection m_section;
 
   std::atomic<bool> m_bAbortRequest;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized;
   bool m_drain = false;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
+  // the queue and its level are only accessed while holding m_section. They
+  // are mutable because the getters move pending messages out of the inbox.
+  mutable int m_iDataSize;
+  mutable double m_TimeFront;
+  mutable double m_TimeBack;
   double m_TimeSize;
 
   int m_iMaxDataSize;
   std::string m_owner;
 
-  std::list<DVDMessageListItem> m_messages;
-  std::list<DVDMessageListItem> m_prioMessages;
-};
+  // normal messages are put into the inbox without locking, they are moved
+  // over to m_messages while holding m_section
+  mutable CLockFreeQueue<CDVDMsg*> m_inbox;
+  std::atomic<bool> m_waiting;
 
+  mutable std::deque<DVDMessageListItem> m_messages;
+  std::deque<DVDMessageListItem> m_prioMessages;
+};
@@ -32,6 +32,7 @@
 
 #include "DVDDemuxers/DVDDemux.h"
 #include "DVDDemuxers/DVDDemuxUtils.h"
+#include "DVDDemuxers/DVDDemuxPacketPool.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
 #include "DVDDemuxers/DVDDemuxFFmpeg.h"
@@ -2509,6 +2510,9 @@ void CVideoPlayer::OnExit()
   // clean up all selection streams
   m_SelectionStreams.Clear(STREAM_NONE, STREAM_SOURCE_NONE);
 
+  // give the memory of recycled packets back once nothing is played anymore
+  CDVDDemuxPacketPool::GetInstance().Trim();
+
   m_messenger.End();
 
   if (m_omxplayer_mode)
@@ -4746,6 +4750,10 @@ void CVideoPlayer::UpdatePlayState(double timeout)
   state.timestamp = m_clock.GetAbsoluteClock();
 
   m_processInfo->SetPlayTimes(state.startTime, state.time, state.timeMin, state.timeMax);
+
+  CDVDDemuxPacketPool &packetPool = CDVDDemuxPacketPool::GetInstance();
+  CServiceBroker::GetDataCacheCore().SetPacketPoolStats(packetPool.GetAllocations(), packetPool.GetReused(),
+                                                        packetPool.GetBytesInUse(), packetPool.GetBytesCached());
   
   CSingleLock lock(m_StateSection);
   m_State = state;
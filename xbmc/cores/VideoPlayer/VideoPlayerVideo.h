@@ -31,6 +31,7 @@
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/BitstreamStats.h"
 #include <atomic>
+#include <list>
 
 #define DROP_DROPPED 1
 #define DROP_VERYLATE 2
@@ -26,6 +26,7 @@
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
+#include "threads/SystemClock.h"
 #include "sqlitedataset.h"
 #include "DatabaseManager.h"
 #include "DbUrl.h"
@@ -157,6 +158,13 @@ CDatabase::CDatabase() :
   m_sqlite = true;
   m_bMultiWrite = false;
   m_multipleExecute = false;
+  m_batch = false;
+  m_batchOpen = false;
+  m_batchMaxItems = 0;
+  m_batchMaxTime = 0;
+  m_batchItems = 0;
+  m_batchStart = 0;
+  m_batchDepth = 0;
 }
 
 CDatabase::~CDatabase(void)
@@ -286,6 +294,40 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecutePrepared(const std::string &strTemplate, const std::vector<dbiplus::field_value> &params)
+{
+  if (NULL == m_pDB.get()) return false;
+  if (NULL == m_pDS.get()) return false;
+
+  try
+  {
+    if (m_multipleExecute)
+    {
+      m_multipleQueries.push_back(m_pDB->bind_params(strTemplate, params));
+      return true;
+    }
+
+    m_pDS->exec_prepared(strTemplate, params);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strTemplate.c_str());
+  }
+
+  return false;
+}
+
+void CDatabase::GetStatementCacheStats(unsigned int &hits, unsigned int &misses) const
+{
+  hits = misses = 0;
+  if (NULL == m_pDB.get()) return;
+
+  hits = m_pDB->getStatementCacheHits();
+  misses = m_pDB->getStatementCacheMisses();
+}
+
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
   bool bReturn = false;
@@ -531,9 +573,13 @@ void CDatabase::Close()
 
   m_openCount = 0;
   m_multipleExecute = false;
+  EndBatch();
 
   if (NULL == m_pDB.get() ) return ;
   if (NULL != m_pDS.get()) m_pDS->close();
+  CLog::Log(LOGDEBUG, LOGDATABASE, "%s - prepared statement cache: %u hits, %u misses, %u evictions; template cache: %u hits, %u misses, %u evictions",
+            __FUNCTION__, m_pDB->getStatementCacheHits(), m_pDB->getStatementCacheMisses(), m_pDB->getStatementCacheEvictions(),
+            m_pDB->getTemplateCacheHits(), m_pDB->getTemplateCacheMisses(), m_pDB->getTemplateCacheEvictions());
   m_pDB->disconnect();
   m_pDB.reset();
   m_pDS.reset();
@@ -585,12 +631,38 @@ void CDatabase::BeginTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return;
+
+    if (m_batch)
+    {
+      // the batch transaction takes the write lock, so only open it once there is something to write
+      if (!m_batchOpen)
+      {
+        m_pDB->start_transaction();
+        m_batchOpen = true;
+        m_batchStart = XbmcThreads::SystemClockMillis();
+      }
+      m_pDB->start_savepoint(StringUtils::Format("batchitem%u", ++m_batchDepth));
+    }
+    else
       m_pDB->start_transaction();
   }
   catch (...)
   {
     CLog::Log(LOGERROR, "database:begintransaction failed");
+    if (m_batch)
+    {
+      // carry on with a plain transaction for this item
+      AbortBatch();
+      try
+      {
+        m_pDB->start_transaction();
+      }
+      catch (...)
+      {
+      }
+    }
   }
 }
 
@@ -598,12 +670,23 @@ bool CDatabase::CommitTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return true;
+
+    // inside a batch the data is committed by BatchItemDone() and EndBatch()
+    if (m_batch)
+    {
+      if (m_batchDepth > 0)
+        m_pDB->release_savepoint(StringUtils::Format("batchitem%u", m_batchDepth--));
+    }
+    else
       m_pDB->commit_transaction();
   }
   catch (...)
   {
     CLog::Log(LOGERROR, "database:committransaction failed");
+    if (m_batch)
+      AbortBatch();
     return false;
   }
   return true;
@@ -613,13 +696,130 @@ void CDatabase::RollbackTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return;
+
+    if (m_batch && m_batchDepth > 0)
+    {
+      std::string savepoint = StringUtils::Format("batchitem%u", m_batchDepth--);
+      m_pDB->rollback_savepoint(savepoint);
+      m_pDB->release_savepoint(savepoint);
+    }
+    else if (m_batch)
+    {
+      CLog::Log(LOGWARNING, "database:rollbacktransaction outside of an item, discarding %u batched items", m_batchItems);
+      if (m_batchOpen)
+        m_pDB->rollback_transaction();
+      m_batchOpen = false;
+      m_batchItems = 0;
+    }
+    else
       m_pDB->rollback_transaction();
   }
   catch (...)
   {
     CLog::Log(LOGERROR, "database:rollbacktransaction failed");
+    if (m_batch)
+      AbortBatch();
+  }
+}
+
+void CDatabase::BeginBatch(unsigned int maxItems, unsigned int maxTime)
+{
+  if (m_batch || maxItems == 0 || NULL == m_pDB.get())
+    return;
+
+  // don't take over a transaction somebody else is running
+  if (m_pDB->in_transaction())
+    return;
+
+  m_batch = true;
+  m_batchOpen = false;
+  m_batchMaxItems = maxItems;
+  m_batchMaxTime = maxTime;
+  m_batchItems = 0;
+  m_batchDepth = 0;
+}
+
+bool CDatabase::BatchItemDone()
+{
+  if (!m_batch)
+    return true;
+
+  m_batchItems++;
+
+  // never commit while an item transaction is still open
+  if (m_batchDepth > 0 || !m_batchOpen)
+    return true;
+
+  unsigned int elapsed = XbmcThreads::SystemClockMillis() - m_batchStart;
+  if (m_batchItems < m_batchMaxItems && elapsed < m_batchMaxTime)
+    return true;
+
+  return CommitBatch();
+}
+
+bool CDatabase::CommitBatch()
+{
+  if (!m_batch || m_batchDepth > 0)
+    return true;
+
+  if (!m_batchOpen)
+  {
+    m_batchItems = 0;
+    return true;
+  }
+
+  bool ret = true;
+  try
+  {
+    m_pDB->commit_transaction();
+    CLog::Log(LOGDEBUG, LOGDATABASE, "%s - committed %u items after %u ms",
+              __FUNCTION__, m_batchItems, XbmcThreads::SystemClockMillis() - m_batchStart);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "database:commitbatch failed to commit %u items", m_batchItems);
+    ret = false;
+  }
+  m_batchOpen = false;
+  m_batchItems = 0;
+  return ret;
+}
+
+bool CDatabase::EndBatch()
+{
+  if (!m_batch)
+    return true;
+
+  if (m_batchDepth > 0)
+    CLog::Log(LOGWARNING, "database:endbatch with %u open transactions", m_batchDepth);
+
+  m_batchDepth = 0;
+  bool ret = CommitBatch();
+  m_batch = false;
+  return ret;
+}
+
+void CDatabase::AbortBatch()
+{
+  // a savepoint failed, so the batch can't tell which writes belong to which item anymore
+  CLog::Log(LOGERROR, "database:abortbatch discarding %u batched items", m_batchItems);
+  if (m_batchOpen)
+  {
+    try
+    {
+      m_pDB->rollback_transaction();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "database:abortbatch failed to roll back");
+    }
   }
+  m_batchOpen = false;
+  m_batchItems = 0;
+  m_batchDepth = 0;
+  m_batch = false;
 }
 
 bool CDatabase::InTransaction()
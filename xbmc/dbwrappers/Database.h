@@ -23,6 +23,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class field_value;
 }
 
 #include <memory>
@@ -31,6 +32,7 @@ namespace dbiplus {
 
 class DatabaseSettings; // forward
 class CDbUrl;
+class CFileItem;
 class CProfilesManager;
 struct SortDescription;
 
@@ -73,6 +75,27 @@ public:
     std::string where;
   };
 
+  /*!
+   * @brief Receives the items of a listing one by one while they are being read.
+   */
+  class IItemCallback
+  {
+  public:
+    virtual ~IItemCallback() = default;
+
+    /*!
+     * @brief Called with the total number of matching items before the first item.
+     * @return False to stop the listing.
+     */
+    virtual bool OnTotal(int total) = 0;
+
+    /*!
+     * @brief Called for every item of the listing in its final order.
+     * @return False to stop the listing.
+     */
+    virtual bool OnItem(const std::shared_ptr<CFileItem> &item) = 0;
+  };
+
 
   CDatabase();
   virtual ~CDatabase(void);
@@ -87,6 +110,40 @@ public:
   virtual bool CommitTransaction();
   void RollbackTransaction();
   bool InTransaction();
+
+  /*!
+   * @brief Start batching writes into long running transactions.
+   *        Until EndBatch() is called, transactions started by BeginTransaction()
+   *        become savepoints of a batch transaction, which is opened by the first
+   *        of them and committed by BatchItemDone() once maxItems items were
+   *        completed or it was open for maxTime ms. A failing item is rolled back
+   *        alone and every commit leaves the database in a consistent state. If a
+   *        savepoint can't be created, released or rolled back, the uncommitted
+   *        items are rolled back and batching ends.
+   * @param maxItems The number of items after which the batch is committed, 0 disables batching.
+   * @param maxTime The time in ms the batch transaction may stay open.
+   * @sa BatchItemDone, CommitBatch, EndBatch
+   */
+  void BeginBatch(unsigned int maxItems, unsigned int maxTime);
+
+  /*!
+   * @brief Mark an item of the current batch as complete, committing the batch if it is due.
+   * @return True if no commit was needed or it succeeded, false otherwise.
+   */
+  bool BatchItemDone();
+
+  /*!
+   * @brief Commit the current batch now, e.g. before blocking on network I/O, so other
+   *        connections aren't locked out while nothing is written. The next item opens a new one.
+   * @return True if nothing needed to be committed or the commit succeeded, false otherwise.
+   */
+  bool CommitBatch();
+
+  /*!
+   * @brief Commit the current batch and return to per-call transactions.
+   * @return True if the commit succeeded, false otherwise.
+   */
+  bool EndBatch();
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -129,6 +186,27 @@ public:
    */
   bool ExecuteQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a parameterised query that does not return any result.
+   *        The '?' placeholders of the template are bound to the given values
+   *        and the parsed statement is cached per connection, keyed by the template.
+   *        Note that if BeginMultipleExecute() has been called, the bound
+   *        query will be queued until CommitMultipleExecute() is called.
+   * @param strTemplate The query template to execute.
+   * @param params The values for the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ExecuteQuery, GetStatementCacheStats
+   */
+  bool ExecutePrepared(const std::string &strTemplate, const std::vector<dbiplus::field_value> &params);
+
+  /*!
+   * @brief Get the hit and miss counters of the native prepared statement cache.
+   * Backends without native parameter binding count their template cache separately.
+   * @param hits The number of statements served from the cache.
+   * @param misses The number of statements that had to be parsed.
+   */
+  void GetStatementCacheStats(unsigned int &hits, unsigned int &misses) const;
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -230,10 +308,20 @@ protected:
 private:
   void InitSettings(DatabaseSettings &dbSettings);
   void UpdateVersionNumber();
+  /*! \brief Roll back the batch transaction after a savepoint failed and return to per-call transactions. */
+  void AbortBatch();
 
   bool m_bMultiWrite; /*!< True if there are any queries in the queue, false otherwise */
   unsigned int m_openCount;
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  bool m_batch;                /*!< True while writes are batched, see BeginBatch() */
+  bool m_batchOpen;            /*!< True while the batch transaction is open */
+  unsigned int m_batchMaxItems;
+  unsigned int m_batchMaxTime;
+  unsigned int m_batchItems;   /*!< Items completed since the last batch commit */
+  unsigned int m_batchStart;   /*!< Time the batch transaction was opened */
+  unsigned int m_batchDepth;   /*!< Number of open savepoints inside the batch */
 };
@@ -49,6 +49,8 @@ Database::Database():
 {
   active = false;	// No connection yet
   compression = false;
+  stmt_cache_hits = stmt_cache_misses = stmt_cache_evictions = 0;
+  template_cache_hits = template_cache_misses = template_cache_evictions = 0;
 }
 
 Database::~Database() {
@@ -82,6 +84,66 @@ std::string Database::prepare(const char *format, ...)
   return result;
 }
 
+std::string Database::bind_params(const std::string &sqlTemplate, const ParamValues &params)
+{
+  std::map<std::string, std::vector<std::string> >::const_iterator it = template_cache.find(sqlTemplate);
+  if (it == template_cache.end())
+  {
+    template_cache_misses++;
+    if (template_cache.size() >= DB_STATEMENT_CACHE_MAX)
+    {
+      template_cache_evictions += template_cache.size();
+      template_cache.clear();
+    }
+
+    // split the template at every placeholder outside of quoted literals
+    std::vector<std::string> parts(1);
+    char quote = 0;
+    for (std::string::const_iterator c = sqlTemplate.begin(); c != sqlTemplate.end(); ++c)
+    {
+      if (quote)
+      {
+        if (*c == quote)
+          quote = 0;
+      }
+      else if (*c == '\'' || *c == '"')
+        quote = *c;
+      else if (*c == '?')
+      {
+        parts.push_back("");
+        continue;
+      }
+      parts.back() += *c;
+    }
+    // only the SQL text is translated, never the values bound into it
+    for (std::vector<std::string>::iterator part = parts.begin(); part != parts.end(); ++part)
+      *part = translate_sql(*part);
+    it = template_cache.insert(std::make_pair(sqlTemplate, parts)).first;
+  }
+  else
+    template_cache_hits++;
+
+  const std::vector<std::string> &parts = it->second;
+  if (parts.size() != params.size() + 1)
+    throw DbErrors("Wrong number of parameters (%u) for statement: %s", (unsigned int)params.size(), sqlTemplate.c_str());
+
+  std::string result = parts[0];
+  for (unsigned int i = 0; i < params.size(); i++)
+  {
+    const field_value &param = params[i];
+    if (param.get_isNull())
+      result += "NULL";
+    else if (param.get_fType() == ft_String)
+      result += quote_string(param.get_asString());
+    else if (param.get_fType() == ft_Boolean)
+      result += param.get_asBool() ? "1" : "0";
+    else
+      result += param.get_asString();
+    result += parts[i + 1];
+  }
+  return result;
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset():
@@ -202,6 +264,18 @@ void Dataset::parse_sql(std::string &sql) {
 }
 
 
+bool Dataset::query_prepared(const std::string &sqlTemplate, const ParamValues &params) {
+  if (db == NULL) throw DbErrors("No Database Connection");
+  return query(db->bind_params(sqlTemplate, params));
+}
+
+
+int Dataset::exec_prepared(const std::string &sqlTemplate, const ParamValues &params) {
+  if (db == NULL) throw DbErrors("No Database Connection");
+  return exec(db->bind_params(sqlTemplate, params));
+}
+
+
 void Dataset::close(void) {
   haveError  = false;
   frecno = 0;
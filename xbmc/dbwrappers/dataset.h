@@ -56,6 +56,10 @@ class Dataset;		// forward declaration of class Dataset
 #define DB_UNEXPECTED		7	// This shouldn't ever happen
 #define DB_UNEXPECTED_RESULT   -1       //For integer functions
 
+#define DB_STATEMENT_CACHE_MAX  256     // Maximum number of cached prepared statements
+
+typedef std::vector<field_value> ParamValues; // values bound to '?' placeholders
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -70,6 +74,9 @@ protected:
     sequence_table, //Sequence table for nextid
     default_charset, //Default character set
     key, cert, ca, capath, ciphers; //SSL - Encryption info
+  unsigned int stmt_cache_hits, stmt_cache_misses, stmt_cache_evictions; // native prepared statement cache statistics
+  unsigned int template_cache_hits, template_cache_misses, template_cache_evictions; // textual template cache statistics
+  std::map<std::string, std::vector<std::string> > template_cache; // statement templates split at placeholders
 
 public:
 /* constructor */
@@ -147,6 +154,12 @@ public:
   virtual void commit_transaction() {};
   virtual void rollback_transaction() {};
 
+/* virtual methods for savepoints, used to nest transactions */
+
+  virtual void start_savepoint(const std::string &name) {};
+  virtual void release_savepoint(const std::string &name) {};
+  virtual void rollback_savepoint(const std::string &name) {};
+
 /* virtual methods for formatting */
 
   /*! \brief Prepare a SQL statement for execution or querying using C printf nomenclature.
@@ -165,6 +178,38 @@ public:
 
   virtual bool in_transaction() {return false;};
 
+  /*! \brief Rewrite backend neutral SQL, e.g. RANDOM(), into the dialect of this backend.
+   \param sql - SQL text outside of any bound value
+   \return the translated SQL.
+   */
+  virtual std::string translate_sql(const std::string &sql) { return sql; }
+
+  /*! \brief Quote and escape a string value for use as a literal, without any dialect translation.
+   \param value - the unescaped value
+   \return the quoted literal.
+   */
+  virtual std::string quote_string(const std::string &value) { return prepare("'%s'", value.c_str()); }
+
+/* prepared statements */
+
+  /*! \brief Substitute the '?' placeholders of a statement template with the escaped parameter values.
+   Used by backends without native parameter binding. The split template is cached, keyed by the template.
+   \param sqlTemplate - statement with '?' placeholders outside of quoted literals
+   \param params - values for the placeholders, in order
+   \return the statement ready for execution.
+   */
+  virtual std::string bind_params(const std::string &sqlTemplate, const ParamValues &params);
+
+  /* number of statements served from / added to / dropped from the native prepared statement cache */
+  unsigned int getStatementCacheHits() const { return stmt_cache_hits; }
+  unsigned int getStatementCacheMisses() const { return stmt_cache_misses; }
+  unsigned int getStatementCacheEvictions() const { return stmt_cache_evictions; }
+
+  /* number of templates served from / added to / dropped from the bind_params() template cache */
+  unsigned int getTemplateCacheHits() const { return template_cache_hits; }
+  unsigned int getTemplateCacheMisses() const { return template_cache_misses; }
+  unsigned int getTemplateCacheEvictions() const { return template_cache_evictions; }
+
 };
 
 
@@ -308,6 +353,16 @@ public:
   virtual const void* getExecRes()=0;
 /* as open, but with our query exec Sql */
   virtual bool query(const std::string &sql) = 0;
+/* as query, but opens a forward-only cursor: rows are fetched one at a time by
+   next() and only the current row is held in memory. Only eof(), next() and
+   field access are meaningful, num_rows() is 1 while a row is available.
+   Backends without cursor support fall back to a buffered query(). */
+  virtual bool query_forward(const std::string &sql) { return query(sql); }
+/* Prepared statements: the '?' placeholders in sqlTemplate are bound to params
+   in order. The parsed statement is cached per connection keyed by the template,
+   so repeated calls with different values skip parsing. */
+  virtual bool query_prepared(const std::string &sqlTemplate, const ParamValues &params);
+  virtual int  exec_prepared(const std::string &sqlTemplate, const ParamValues &params);
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
@@ -530,6 +530,34 @@ void MysqlDatabase::rollback_transaction() {
   }
 }
 
+void MysqlDatabase::start_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string query = "SAVEPOINT " + name;
+    if (mysql_real_query(conn, query.c_str(), query.size()) != MYSQL_OK)
+      throw DbErrors("Can't start savepoint '%s' (%d)", name.c_str(), mysql_errno(conn));
+  }
+}
+
+void MysqlDatabase::release_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string query = "RELEASE SAVEPOINT " + name;
+    if (mysql_real_query(conn, query.c_str(), query.size()) != MYSQL_OK)
+      throw DbErrors("Can't release savepoint '%s' (%d)", name.c_str(), mysql_errno(conn));
+  }
+}
+
+void MysqlDatabase::rollback_savepoint(const std::string &name) {
+  if (active)
+  {
+    std::string query = "ROLLBACK TO SAVEPOINT " + name;
+    if (mysql_real_query(conn, query.c_str(), query.size()) != MYSQL_OK)
+      throw DbErrors("Can't roll back to savepoint '%s' (%d)", name.c_str(), mysql_errno(conn));
+    CLog::Log(LOGDEBUG,"Mysql rollback to savepoint %s", name.c_str());
+  }
+}
+
 bool MysqlDatabase::exists(void) {
   bool ret = false;
 
@@ -577,6 +605,15 @@ std::string MysqlDatabase::vprepare(const char *format, va_list args)
     strFormat.replace(pos++, 2, "%q");
 
   strResult = mysql_vmprintf(strFormat.c_str(), args);
+
+  return translate_sql(strResult);
+}
+
+std::string MysqlDatabase::translate_sql(const std::string &sql)
+{
+  std::string strResult = sql;
+  size_t pos;
+
   //  RAND() is the mysql form of RANDOM()
   pos = 0;
   while ( (pos = strResult.find("RANDOM()", pos)) != std::string::npos )
@@ -588,6 +625,21 @@ std::string MysqlDatabase::vprepare(const char *format, va_list args)
   return strResult;
 }
 
+std::string MysqlDatabase::quote_string(const std::string &value)
+{
+  return "'" + mysql_mprintf("%q", value.c_str()) + "'";
+}
+
+std::string MysqlDatabase::mysql_mprintf(const char *zFormat, ...)
+{
+  va_list ap;
+  va_start(ap, zFormat);
+  std::string strResult = mysql_vmprintf(zFormat, ap);
+  va_end(ap);
+
+  return strResult;
+}
+
 /* vsprintf() functionality is based on sqlite3.c functions */
 
 /*
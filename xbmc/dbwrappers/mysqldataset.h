@@ -83,8 +83,16 @@ public:
   void commit_transaction() override;
   void rollback_transaction() override;
 
+/* virtual methods for savepoints */
+
+  void start_savepoint(const std::string &name) override;
+  void release_savepoint(const std::string &name) override;
+  void rollback_savepoint(const std::string &name) override;
+
 /* virtual methods for formatting */
   std::string vprepare(const char *format, va_list args) override;
+  std::string translate_sql(const std::string &sql) override;
+  std::string quote_string(const std::string &value) override;
 
   bool in_transaction() override {return _in_transaction;};
   int query_with_reconnect(const char* query);
@@ -102,6 +110,7 @@ private:
   void mysqlStrAccumReset(StrAccum *p);
   void mysqlStrAccumInit(StrAccum *p, char *zBase, int n, int mx);
   std::string mysql_vmprintf(const char *zFormat, va_list ap);
+  std::string mysql_mprintf(const char *zFormat, ...);
 };
 
 
@@ -76,6 +76,30 @@ int callback(void* res_ptr,int ncol, char** result,char** cols)
   return 0;  
 }
 
+static void read_column(sqlite3_stmt *stmt, int col, field_value &v)
+{
+  switch (sqlite3_column_type(stmt, col))
+  {
+  case SQLITE_INTEGER:
+    v.set_asInt64(sqlite3_column_int64(stmt, col));
+    break;
+  case SQLITE_FLOAT:
+    v.set_asDouble(sqlite3_column_double(stmt, col));
+    break;
+  case SQLITE_TEXT:
+    v.set_asString((const char *)sqlite3_column_text(stmt, col));
+    break;
+  case SQLITE_BLOB:
+    v.set_asString((const char *)sqlite3_column_text(stmt, col));
+    break;
+  case SQLITE_NULL:
+  default:
+    v.set_asString("");
+    v.set_isNull();
+    break;
+  }
+}
+
 static int busy_callback(void*, int busyCount)
 {
   Sleep(100);
@@ -256,6 +280,7 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  clear_statements();
   sqlite3_close(conn);
   active = false;
 }
@@ -410,6 +435,72 @@ void SqliteDatabase::rollback_transaction() {
   }  
 }
 
+void SqliteDatabase::start_savepoint(const std::string &name) {
+  if (active) {
+    const std::string query = "SAVEPOINT " + name;
+    if (setErr(sqlite3_exec(conn, query.c_str(), NULL, NULL, NULL), query.c_str()) != SQLITE_OK)
+      throw DbErrors(getErrorMsg());
+  }
+}
+
+void SqliteDatabase::release_savepoint(const std::string &name) {
+  if (active) {
+    const std::string query = "RELEASE SAVEPOINT " + name;
+    if (setErr(sqlite3_exec(conn, query.c_str(), NULL, NULL, NULL), query.c_str()) != SQLITE_OK)
+      throw DbErrors(getErrorMsg());
+  }
+}
+
+void SqliteDatabase::rollback_savepoint(const std::string &name) {
+  if (active) {
+    const std::string query = "ROLLBACK TO SAVEPOINT " + name;
+    if (setErr(sqlite3_exec(conn, query.c_str(), NULL, NULL, NULL), query.c_str()) != SQLITE_OK)
+      throw DbErrors(getErrorMsg());
+  }
+}
+
+
+// methods for prepared statements
+// ---------------------------------------------
+sqlite3_stmt *SqliteDatabase::get_statement(const std::string &sqlTemplate) {
+  if (!active) throw DbErrors("No Database Connection");
+
+  std::map<std::string, StatementList::iterator>::const_iterator it = stmt_cache.find(sqlTemplate);
+  if (it != stmt_cache.end())
+  {
+    stmt_cache_hits++;
+    stmt_lru.splice(stmt_lru.begin(), stmt_lru, it->second);
+    return it->second->second;
+  }
+
+  stmt_cache_misses++;
+  if (stmt_cache.size() >= DB_STATEMENT_CACHE_MAX)
+  {
+    // drop the least recently used statement only
+    stmt_cache_evictions++;
+    sqlite3_finalize(stmt_lru.back().second);
+    stmt_cache.erase(stmt_lru.back().first);
+    stmt_lru.pop_back();
+  }
+
+  sqlite3_stmt *stmt = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, translate_sql(sqlTemplate).c_str(), -1, &stmt, NULL), sqlTemplate.c_str()) != SQLITE_OK)
+  {
+    sqlite3_finalize(stmt);
+    throw DbErrors(getErrorMsg());
+  }
+  stmt_lru.push_front(std::make_pair(sqlTemplate, stmt));
+  stmt_cache.insert(std::make_pair(sqlTemplate, stmt_lru.begin()));
+  return stmt;
+}
+
+void SqliteDatabase::clear_statements() {
+  for (StatementList::iterator it = stmt_lru.begin(); it != stmt_lru.end(); ++it)
+    sqlite3_finalize(it->second);
+  stmt_lru.clear();
+  stmt_cache.clear();
+}
+
 
 // methods for formatting
 // ---------------------------------------------
@@ -446,6 +537,7 @@ std::string SqliteDatabase::vprepare(const char *format, va_list args)
 //************* SqliteDataset implementation ***************
 
 SqliteDataset::SqliteDataset():Dataset() {
+  cursor = NULL;
   haveError = false;
   db = NULL;
   errmsg = NULL;
@@ -454,6 +546,7 @@ SqliteDataset::SqliteDataset():Dataset() {
 
 
 SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
+  cursor = NULL;
   haveError = false;
   db = newDb;
   errmsg = NULL;
@@ -461,6 +554,7 @@ SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
 }
 
  SqliteDataset::~SqliteDataset(){
+   if (cursor) sqlite3_finalize(cursor);
    if (errmsg) sqlite3_free(errmsg);
  }
 
@@ -649,6 +743,21 @@ bool SqliteDataset::query(const std::string &query) {
   if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
     throw DbErrors(db->getErrorMsg());
 
+  read_rows(stmt);
+  if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
+  {
+    active = true;
+    ds_state = dsSelect;
+    this->first();
+    return true;
+  }
+  else
+  {
+    throw DbErrors(db->getErrorMsg());
+  }  
+}
+
+int SqliteDataset::read_rows(sqlite3_stmt *stmt) {
   // column headers
   const unsigned int numColumns = sqlite3_column_count(stmt);
   result.record_header.resize(numColumns);
@@ -656,47 +765,152 @@ bool SqliteDataset::query(const std::string &query) {
     result.record_header[i].name = sqlite3_column_name(stmt, i);
 
   // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
   { // have a row of data
     sql_record *res = new sql_record;
     res->resize(numColumns);
     for (unsigned int i = 0; i < numColumns; i++)
+      read_column(stmt, i, res->at(i));
+    result.records.push_back(res);
+  }
+  return rc;
+}
+
+void SqliteDataset::bind_values(sqlite3_stmt *stmt, const ParamValues &params, const std::string &sqlTemplate) {
+  if (sqlite3_bind_parameter_count(stmt) != (int)params.size())
+    throw DbErrors("Wrong number of parameters (%u) for statement: %s", (unsigned int)params.size(), sqlTemplate.c_str());
+
+  for (unsigned int i = 0; i < params.size(); i++)
+  {
+    const field_value &param = params[i];
+    int rc;
+    if (param.get_isNull())
+      rc = sqlite3_bind_null(stmt, i + 1);
+    else
     {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
+      switch (param.get_fType())
       {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
+      case ft_Float:
+      case ft_Double:
+      case ft_LongDouble:
+        rc = sqlite3_bind_double(stmt, i + 1, param.get_asDouble());
         break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      case ft_Boolean:
+      case ft_Short:
+      case ft_UShort:
+      case ft_Int:
+      case ft_UInt:
+      case ft_Int64:
+        rc = sqlite3_bind_int64(stmt, i + 1, param.get_asInt64());
         break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
       default:
-        v.set_asString("");
-        v.set_isNull();
+        rc = sqlite3_bind_text(stmt, i + 1, param.get_asString().c_str(), -1, SQLITE_TRANSIENT);
         break;
       }
     }
-    result.records.push_back(res);
+    if (db->setErr(rc, sqlTemplate.c_str()) != SQLITE_OK)
+    {
+      sqlite3_clear_bindings(stmt);
+      throw DbErrors(db->getErrorMsg());
+    }
   }
-  if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
+}
+
+bool SqliteDataset::query_prepared(const std::string &sqlTemplate, const ParamValues &params) {
+  if(!handle()) throw DbErrors("No Database Connection");
+
+  close();
+
+  sql = sqlTemplate;
+  sqlite3_stmt *stmt = static_cast<SqliteDatabase*>(db)->get_statement(sqlTemplate);
+  bind_values(stmt, params, sqlTemplate);
+  const int rc = read_rows(stmt);
+  // the statement stays in the cache, so make it ready for the next caller
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  if (db->setErr(rc == SQLITE_DONE ? SQLITE_OK : rc, sqlTemplate.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+int SqliteDataset::exec_prepared(const std::string &sqlTemplate, const ParamValues &params) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  sqlite3_stmt *stmt = static_cast<SqliteDatabase*>(db)->get_statement(sqlTemplate);
+  bind_values(stmt, params, sqlTemplate);
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    ;
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  if (db->setErr(rc == SQLITE_DONE ? SQLITE_OK : rc, sqlTemplate.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+  return SQLITE_OK;
+}
+
+bool SqliteDataset::query_forward(const std::string &query) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  if (query.find("select") == std::string::npos && query.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&cursor, NULL),query.c_str()) != SQLITE_OK)
   {
-    active = true;
-    ds_state = dsSelect;
-    this->first();
-    return true;
+    cursor = NULL;
+    throw DbErrors(db->getErrorMsg());
   }
-  else
+  sql = query;
+
+  // column headers
+  const unsigned int numColumns = sqlite3_column_count(cursor);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(cursor, i);
+
+  active = true;
+  ds_state = dsSelect;
+  fbof = true;
+  fetch_row();
+  return true;
+}
+
+void SqliteDataset::fetch_row() {
+  const int rc = sqlite3_step(cursor);
+  if (rc == SQLITE_ROW)
   {
+    // a single record is recycled for every row of the cursor
+    if (result.records.empty())
+      result.records.push_back(new sql_record);
+    sql_record *row = result.records[0];
+    const unsigned int numColumns = result.record_header.size();
+    row->resize(numColumns);
+    for (unsigned int i = 0; i < numColumns; i++)
+      read_column(cursor, i, row->at(i));
+    frecno = 0;
+    feof = false;
+    fill_fields();
+    return;
+  }
+
+  for (unsigned int i = 0; i < result.records.size(); i++)
+    delete result.records[i];
+  result.records.clear();
+  frecno = 0;
+  feof = true;
+  if (rc != SQLITE_DONE)
+  {
+    db->setErr(rc, sql.c_str());
     throw DbErrors(db->getErrorMsg());
-  }  
+  }
 }
 
 void SqliteDataset::open(const std::string &sql) {
@@ -715,6 +929,11 @@ void SqliteDataset::open() {
 
 
 void SqliteDataset::close() {
+  if (cursor)
+  {
+    sqlite3_finalize(cursor);
+    cursor = NULL;
+  }
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -750,21 +969,34 @@ bool SqliteDataset::bof() {
 
 
 void SqliteDataset::first() {
+  if (cursor) {
+    if (!fbof) throw DbErrors("Can't rewind a forward-only dataset");
+    return;
+  }
   Dataset::first();
   this->fill_fields();
 }
 
 void SqliteDataset::last() {
+  if (cursor) throw DbErrors("Can't move to the last row of a forward-only dataset");
   Dataset::last();
   fill_fields();
 }
 
 void SqliteDataset::prev(void) {
+  if (cursor) throw DbErrors("Can't move backwards in a forward-only dataset");
   Dataset::prev();
   fill_fields();
 }
 
 void SqliteDataset::next(void) {
+  if (cursor) {
+    if (ds_state == dsSelect && !feof) {
+      fbof = false;
+      fetch_row();
+    }
+    return;
+  }
   Dataset::next();
   if (!eof()) 
       fill_fields();
@@ -784,6 +1016,7 @@ void SqliteDataset::free_row(void)
 }
 
 bool SqliteDataset::seek(int pos) {
+  if (cursor) throw DbErrors("Can't seek in a forward-only dataset");
   if (ds_state == dsSelect) {
     Dataset::seek(pos);
     fill_fields();
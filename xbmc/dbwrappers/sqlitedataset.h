@@ -44,6 +44,11 @@ protected:
   sqlite3 *conn;
   bool _in_transaction;
   int last_err;
+/* prepared statements, most recently used first */
+  typedef std::list<std::pair<std::string, sqlite3_stmt*> > StatementList;
+  StatementList stmt_lru;
+/* positions in stmt_lru keyed by their template */
+  std::map<std::string, StatementList::iterator> stmt_cache;
 
 public:
 /* default constructor */
@@ -91,11 +96,22 @@ public:
   void commit_transaction() override;
   void rollback_transaction() override;
 
+/* virtual methods for savepoints */
+
+  void start_savepoint(const std::string &name) override;
+  void release_savepoint(const std::string &name) override;
+  void rollback_savepoint(const std::string &name) override;
+
 /* virtual methods for formatting */
   std::string vprepare(const char *format, va_list args) override;
 
   bool in_transaction() override {return _in_transaction;}; 	
 
+/* returns the cached statement for a template, preparing it on first use */
+  sqlite3_stmt *get_statement(const std::string &sqlTemplate);
+/* finalizes all cached statements */
+  void clear_statements();
+
 };
 
 
@@ -127,6 +143,15 @@ protected:
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
 
+/* statement kept open while iterating a forward-only cursor */
+  sqlite3_stmt *cursor;
+/* steps the forward-only cursor and stores the fetched row as current record */
+  void fetch_row();
+/* reads the column headers and all rows of a statement into the result set */
+  int read_rows(sqlite3_stmt *stmt);
+/* binds parameter values to the placeholders of a cached statement */
+  void bind_values(sqlite3_stmt *stmt, const ParamValues &params, const std::string &sqlTemplate);
+
 public:
 /* constructor */
   SqliteDataset();
@@ -148,6 +173,11 @@ or insert() operations default = false) */
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+/* as query, but streams the rows through a forward-only cursor */
+  bool query_forward(const std::string &query) override;
+/* prepared statements, bound natively and cached per connection */
+  bool query_prepared(const std::string &sqlTemplate, const ParamValues &params) override;
+  int  exec_prepared(const std::string &sqlTemplate, const ParamValues &params) override;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
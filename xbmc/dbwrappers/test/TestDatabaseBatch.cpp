@@ -0,0 +1,236 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace dbiplus;
+
+namespace
+{
+class CTestDatabase : public CDatabase
+{
+public:
+  bool AddItem(int id, bool fail = false)
+  {
+    BeginTransaction();
+    if (!ExecuteQuery(PrepareSQL("INSERT INTO item (idItem) VALUES (%i)", id)) || fail)
+    {
+      RollbackTransaction();
+      return false;
+    }
+    return CommitTransaction();
+  }
+
+  // an item writing several rows, like a movie with its cast and streams
+  bool AddItems(int first, int count, bool fail = false)
+  {
+    BeginTransaction();
+    for (int id = first; id < first + count; id++)
+    {
+      if (!ExecuteQuery(PrepareSQL("INSERT INTO item (idItem) VALUES (%i)", id)))
+      {
+        RollbackTransaction();
+        return false;
+      }
+    }
+    if (fail)
+    {
+      RollbackTransaction();
+      return false;
+    }
+    return CommitTransaction();
+  }
+
+  // ends the batch transaction behind the item's back, so its savepoint is gone
+  bool AddItemAndCommit(int id)
+  {
+    BeginTransaction();
+    ExecuteQuery(PrepareSQL("INSERT INTO item (idItem) VALUES (%i)", id));
+    ExecuteQuery("COMMIT");
+    return CommitTransaction();
+  }
+
+protected:
+  void CreateTables() override { m_pDS->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY)"); }
+  void CreateAnalytics() override {}
+  int GetSchemaVersion() const override { return 1; }
+  const char *GetBaseDBName() const override { return "TestBatch"; }
+};
+
+const unsigned int MAX_TIME = 200;
+}
+
+class DatabaseBatchTest : public ::testing::Test
+{
+protected:
+  DatabaseSettings settings;
+  CTestDatabase database;
+  SqliteDatabase other;
+  std::unique_ptr<Dataset> otherDS;
+
+  void SetUp() override
+  {
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    ASSERT_TRUE(database.Connect("TestBatch1", settings, true));
+    ASSERT_TRUE(database.ExecuteQuery("DELETE FROM item"));
+
+    // a second connection, as the GUI would hold while the scanner runs
+    other.setHostName(settings.host.c_str());
+    other.setDatabase("TestBatch1.db");
+    ASSERT_EQ(DB_CONNECTION_OK, other.connect(false));
+    otherDS.reset(other.CreateDataset());
+  }
+
+  void TearDown() override
+  {
+    database.EndBatch();
+    otherDS.reset();
+    other.disconnect();
+    database.Close();
+  }
+
+  // write on the second connection, returns false if it stays blocked for longer than timeout ms
+  bool OtherWrites(int id, unsigned int timeout)
+  {
+    std::future<void> write = std::async(std::launch::async, [this, id]() {
+      otherDS->exec(other.prepare("INSERT INTO item (idItem) VALUES (%i)", id));
+    });
+    bool done = write.wait_for(std::chrono::milliseconds(timeout)) == std::future_status::ready;
+    if (!done)
+      database.EndBatch(); // release the lock so the writer can finish
+    write.get();
+    return done;
+  }
+
+  int CountItems()
+  {
+    otherDS->query("SELECT COUNT(*) FROM item");
+    int count = otherDS->fv(0).get_asInt();
+    otherDS->close();
+    return count;
+  }
+};
+
+
+TEST_F(DatabaseBatchTest, NoLockBeforeFirstWrite)
+{
+  database.BeginBatch(100, 60000);
+  EXPECT_TRUE(OtherWrites(100, MAX_TIME));
+}
+
+TEST_F(DatabaseBatchTest, CommitBatchReleasesLock)
+{
+  database.BeginBatch(100, 60000);
+  EXPECT_TRUE(database.AddItem(1));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_EQ(0, CountItems());
+
+  // what the scanner does before waiting for the network
+  EXPECT_TRUE(database.CommitBatch());
+  EXPECT_EQ(1, CountItems());
+  EXPECT_TRUE(OtherWrites(100, MAX_TIME));
+
+  EXPECT_TRUE(database.AddItem(2));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_TRUE(database.EndBatch());
+  EXPECT_EQ(3, CountItems());
+}
+
+TEST_F(DatabaseBatchTest, CommitAfterMaxItems)
+{
+  database.BeginBatch(2, 60000);
+  EXPECT_TRUE(database.AddItem(1));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_EQ(0, CountItems());
+  EXPECT_TRUE(database.AddItem(2));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_EQ(2, CountItems());
+  EXPECT_TRUE(OtherWrites(100, MAX_TIME));
+}
+
+TEST_F(DatabaseBatchTest, CommitAfterMaxTime)
+{
+  database.BeginBatch(100, MAX_TIME / 4);
+  EXPECT_TRUE(database.AddItem(1));
+  EXPECT_TRUE(database.BatchItemDone());
+  std::this_thread::sleep_for(std::chrono::milliseconds(MAX_TIME / 2));
+  EXPECT_TRUE(database.AddItem(2));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_EQ(2, CountItems());
+  EXPECT_TRUE(OtherWrites(100, MAX_TIME));
+}
+
+TEST_F(DatabaseBatchTest, FailedItemRollsBackAlone)
+{
+  database.BeginBatch(100, 60000);
+  EXPECT_TRUE(database.AddItem(1));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_FALSE(database.AddItem(2, true));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_TRUE(database.EndBatch());
+  EXPECT_EQ(1, CountItems());
+}
+
+TEST_F(DatabaseBatchTest, RollbackDiscardsOnlyItemRows)
+{
+  database.BeginBatch(100, 60000);
+  EXPECT_TRUE(database.AddItems(10, 3));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_FALSE(database.AddItems(20, 3, true));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_TRUE(database.AddItems(30, 2));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_TRUE(database.EndBatch());
+
+  EXPECT_EQ(5, CountItems());
+  otherDS->query("SELECT COUNT(*) FROM item WHERE idItem >= 20 AND idItem < 30");
+  EXPECT_EQ(0, otherDS->fv(0).get_asInt());
+  otherDS->close();
+}
+
+TEST_F(DatabaseBatchTest, SavepointErrorsThrow)
+{
+  EXPECT_THROW(other.release_savepoint("nosuchsavepoint"), DbErrors);
+  EXPECT_THROW(other.rollback_savepoint("nosuchsavepoint"), DbErrors);
+}
+
+TEST_F(DatabaseBatchTest, FailedSavepointEndsBatch)
+{
+  database.BeginBatch(100, 60000);
+  EXPECT_TRUE(database.AddItem(1));
+  EXPECT_TRUE(database.BatchItemDone());
+  EXPECT_FALSE(database.AddItemAndCommit(2));
+  EXPECT_EQ(2, CountItems());
+
+  // batching has ended, so the next item is committed right away
+  EXPECT_TRUE(database.AddItem(3));
+  EXPECT_EQ(3, CountItems());
+  EXPECT_TRUE(OtherWrites(100, MAX_TIME));
+}
@@ -0,0 +1,120 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/SpecialProtocol.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+
+using namespace dbiplus;
+
+
+class SqliteDatasetTest : public ::testing::Test
+{
+protected:
+  SqliteDatabase database;
+  std::unique_ptr<Dataset> dataset;
+
+  void SetUp() override
+  {
+    database.setHostName(CSpecialProtocol::TranslatePath("special://temp/").c_str());
+    database.setDatabase("dbwrappers_test.db");
+    ASSERT_EQ(DB_CONNECTION_OK, database.connect(true));
+
+    dataset.reset(database.CreateDataset());
+    dataset->exec("DROP TABLE IF EXISTS item");
+    dataset->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, strName TEXT, fValue REAL)");
+    dataset->exec("INSERT INTO item VALUES (1, 'one', 1.5)");
+    dataset->exec("INSERT INTO item VALUES (2, 'two', NULL)");
+    dataset->exec("INSERT INTO item VALUES (3, 'three', 3.5)");
+  }
+
+  void TearDown() override
+  {
+    dataset->exec("DROP TABLE IF EXISTS item");
+    dataset.reset();
+    database.disconnect();
+  }
+};
+
+
+TEST_F(SqliteDatasetTest, QueryForwardIteratesAllRows)
+{
+  ASSERT_TRUE(dataset->query_forward("SELECT idItem, strName, fValue FROM item ORDER BY idItem"));
+
+  int count = 0;
+  while (!dataset->eof())
+  {
+    count++;
+    EXPECT_EQ(count, dataset->fv("idItem").get_asInt());
+    dataset->next();
+  }
+  EXPECT_EQ(3, count);
+  dataset->close();
+}
+
+TEST_F(SqliteDatasetTest, QueryForwardReadsColumns)
+{
+  ASSERT_TRUE(dataset->query_forward("SELECT idItem, strName, fValue FROM item ORDER BY idItem"));
+
+  EXPECT_EQ("one", dataset->fv(1).get_asString());
+  EXPECT_DOUBLE_EQ(1.5, dataset->fv(2).get_asDouble());
+  dataset->next();
+  EXPECT_EQ("two", dataset->fv("strName").get_asString());
+  EXPECT_TRUE(dataset->fv("fValue").get_isNull());
+  dataset->close();
+}
+
+TEST_F(SqliteDatasetTest, QueryForwardEmptyResult)
+{
+  ASSERT_TRUE(dataset->query_forward("SELECT idItem FROM item WHERE idItem > 100"));
+  EXPECT_TRUE(dataset->eof());
+  EXPECT_EQ(0, dataset->num_rows());
+  dataset->close();
+}
+
+TEST_F(SqliteDatasetTest, QueryForwardCannotRewind)
+{
+  ASSERT_TRUE(dataset->query_forward("SELECT idItem FROM item ORDER BY idItem"));
+  dataset->next();
+
+  EXPECT_THROW(dataset->first(), DbErrors);
+  EXPECT_THROW(dataset->prev(), DbErrors);
+  EXPECT_THROW(dataset->last(), DbErrors);
+  EXPECT_THROW(dataset->seek(0), DbErrors);
+  EXPECT_EQ(2, dataset->fv("idItem").get_asInt());
+  dataset->close();
+}
+
+TEST_F(SqliteDatasetTest, QueryAfterQueryForward)
+{
+  ASSERT_TRUE(dataset->query_forward("SELECT idItem FROM item ORDER BY idItem"));
+  dataset->close();
+
+  // a buffered query on the same dataset still supports random access
+  ASSERT_TRUE(dataset->query("SELECT idItem FROM item ORDER BY idItem"));
+  EXPECT_EQ(3, dataset->num_rows());
+  dataset->last();
+  EXPECT_EQ(3, dataset->fv("idItem").get_asInt());
+  dataset->first();
+  EXPECT_EQ(1, dataset->fv("idItem").get_asInt());
+  dataset->close();
+}
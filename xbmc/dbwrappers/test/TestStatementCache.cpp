@@ -0,0 +1,150 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/SpecialProtocol.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+
+using namespace dbiplus;
+
+namespace
+{
+// rewrites RANDOM() like a backend with a different SQL dialect would
+class TranslatingDatabase : public SqliteDatabase
+{
+public:
+  std::string translate_sql(const std::string &sql) override
+  {
+    std::string result = sql;
+    size_t pos = 0;
+    while ((pos = result.find("RANDOM()", pos)) != std::string::npos)
+      result.replace(pos, 8, "RAND()");
+    return result;
+  }
+};
+}
+
+class StatementCacheTest : public ::testing::Test
+{
+protected:
+  SqliteDatabase database;
+  std::unique_ptr<Dataset> dataset;
+
+  void SetUp() override
+  {
+    database.setHostName(CSpecialProtocol::TranslatePath("special://temp/").c_str());
+    database.setDatabase("dbwrappers_stmt_test.db");
+    ASSERT_EQ(DB_CONNECTION_OK, database.connect(true));
+
+    dataset.reset(database.CreateDataset());
+    dataset->exec("DROP TABLE IF EXISTS item");
+    dataset->exec("CREATE TABLE item (idItem INTEGER PRIMARY KEY, strName TEXT)");
+  }
+
+  void TearDown() override
+  {
+    dataset->exec("DROP TABLE IF EXISTS item");
+    dataset.reset();
+    database.disconnect();
+  }
+};
+
+
+TEST_F(StatementCacheTest, HitsAndMisses)
+{
+  const std::string insert = "INSERT INTO item (idItem, strName) VALUES (?, ?)";
+  dataset->exec_prepared(insert, ParamValues{ field_value(1), field_value(std::string("one")) });
+  EXPECT_EQ(0U, database.getStatementCacheHits());
+  EXPECT_EQ(1U, database.getStatementCacheMisses());
+
+  dataset->exec_prepared(insert, ParamValues{ field_value(2), field_value(std::string("it's")) });
+  EXPECT_EQ(1U, database.getStatementCacheHits());
+  EXPECT_EQ(1U, database.getStatementCacheMisses());
+
+  ASSERT_TRUE(dataset->query_prepared("SELECT strName FROM item WHERE idItem = ?", ParamValues{ field_value(2) }));
+  EXPECT_EQ("it's", dataset->fv("strName").get_asString());
+  dataset->close();
+  EXPECT_EQ(1U, database.getStatementCacheHits());
+  EXPECT_EQ(2U, database.getStatementCacheMisses());
+  EXPECT_EQ(0U, database.getStatementCacheEvictions());
+
+  // the native cache doesn't touch the template cache counters
+  EXPECT_EQ(0U, database.getTemplateCacheHits());
+  EXPECT_EQ(0U, database.getTemplateCacheMisses());
+}
+
+TEST_F(StatementCacheTest, Eviction)
+{
+  for (int i = 0; i < DB_STATEMENT_CACHE_MAX + 1; i++)
+  {
+    // every statement text is distinct, so each one is a miss
+    std::string insert = "INSERT INTO item (idItem, strName) VALUES (?, '" + std::to_string(i) + "')";
+    dataset->exec_prepared(insert, ParamValues{ field_value(i) });
+  }
+  EXPECT_EQ(0U, database.getStatementCacheHits());
+  EXPECT_EQ(static_cast<unsigned int>(DB_STATEMENT_CACHE_MAX + 1), database.getStatementCacheMisses());
+  EXPECT_EQ(1U, database.getStatementCacheEvictions());
+
+  // only the least recently used statement was dropped
+  dataset->exec_prepared("INSERT INTO item (idItem, strName) VALUES (?, '1')", ParamValues{ field_value(1000) });
+  EXPECT_EQ(1U, database.getStatementCacheHits());
+  EXPECT_EQ(1U, database.getStatementCacheEvictions());
+
+  // the evicted statement is prepared again on demand and pushes out the next oldest one
+  dataset->exec_prepared("INSERT INTO item (idItem, strName) VALUES (?, '0')", ParamValues{ field_value(1001) });
+  EXPECT_EQ(static_cast<unsigned int>(DB_STATEMENT_CACHE_MAX + 2), database.getStatementCacheMisses());
+  EXPECT_EQ(2U, database.getStatementCacheEvictions());
+
+  // statement 1 was used recently, so statement 2 went instead
+  dataset->exec_prepared("INSERT INTO item (idItem, strName) VALUES (?, '1')", ParamValues{ field_value(1002) });
+  EXPECT_EQ(2U, database.getStatementCacheHits());
+  dataset->exec_prepared("INSERT INTO item (idItem, strName) VALUES (?, '2')", ParamValues{ field_value(1003) });
+  EXPECT_EQ(static_cast<unsigned int>(DB_STATEMENT_CACHE_MAX + 3), database.getStatementCacheMisses());
+  EXPECT_EQ(3U, database.getStatementCacheEvictions());
+
+  ASSERT_TRUE(dataset->query("SELECT COUNT(*) FROM item"));
+  EXPECT_EQ(DB_STATEMENT_CACHE_MAX + 5, dataset->fv(0).get_asInt());
+  dataset->close();
+}
+
+TEST_F(StatementCacheTest, BindParams)
+{
+  const std::string select = "SELECT * FROM item WHERE idItem = ? AND strName = ? AND strName <> '?'";
+  EXPECT_EQ("SELECT * FROM item WHERE idItem = 5 AND strName = 'it''s' AND strName <> '?'",
+            database.bind_params(select, ParamValues{ field_value(5), field_value(std::string("it's")) }));
+  field_value null;
+  null.set_isNull();
+  EXPECT_EQ("SELECT * FROM item WHERE idItem = NULL AND strName = 'x' AND strName <> '?'",
+            database.bind_params(select, ParamValues{ null, field_value(std::string("x")) }));
+  EXPECT_EQ(1U, database.getTemplateCacheHits());
+  EXPECT_EQ(1U, database.getTemplateCacheMisses());
+
+  EXPECT_THROW(database.bind_params(select, ParamValues{ field_value(5) }), DbErrors);
+}
+
+TEST_F(StatementCacheTest, BindParamsTranslatesOnlySql)
+{
+  TranslatingDatabase translating;
+  EXPECT_EQ("SELECT * FROM item WHERE strName = 'RANDOM()' ORDER BY RAND()",
+            translating.bind_params("SELECT * FROM item WHERE strName = ? ORDER BY RANDOM()",
+                                    ParamValues{ field_value(std::string("RANDOM()")) }));
+}
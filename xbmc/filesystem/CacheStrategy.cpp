@@ -409,3 +409,9 @@ CCacheStrategy *CDoubleCache::CreateNew()
   return new CDoubleCache(m_pCache->CreateNew());
 }
 
+bool CDoubleCache::Resize(size_t front, size_t back)
+{
+  if (m_pCacheOld)
+    m_pCacheOld->Resize(front, back);
+  return m_pCache->Resize(front, back);
+}
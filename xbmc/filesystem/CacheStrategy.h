@@ -69,6 +69,14 @@ public:
 
   virtual CCacheStrategy *CreateNew() = 0;
 
+  /*!
+   \brief Change the amount of memory the cache may use
+   \param front size of the forward buffer
+   \param back guaranteed size of the back buffer
+   \return false if the strategy can't be resized or the data ahead of the read position doesn't fit
+   */
+  virtual bool Resize(size_t front, size_t back) { return false; }
+
   CEvent m_space;
 protected:
   bool  m_bEndOfInput;
@@ -135,6 +143,7 @@ public:
   bool IsCachedPosition(int64_t iFilePosition) override;
 
   CCacheStrategy *CreateNew() override;
+  bool Resize(size_t front, size_t back) override;
 
 protected:
   CCacheStrategy *m_pCache;
@@ -23,6 +23,7 @@
 #include "threads/SingleLock.h"
 #include "CircularCache.h"
 
+#include <new>
 #include <string.h>
 
 using namespace XFILE;
@@ -269,3 +270,65 @@ CCacheStrategy *CCircularCache::CreateNew()
   return new CCircularCache(m_size - m_size_back, m_size_back);
 }
 
+/**
+ * Moves the cached data into a buffer of a different size.
+ * History beyond the new size is dropped, the data ahead
+ * of the read position has to fit.
+ */
+bool CCircularCache::Resize(size_t front, size_t back)
+{
+  CSingleLock lock(m_sync);
+
+  const size_t size = front + back;
+  if (size == 0 || (int64_t)front < m_end - m_cur)
+    return false;
+
+  if (!m_buf || size == m_size)
+  {
+    m_size = size;
+    m_size_back = back;
+    return true;
+  }
+
+#ifdef TARGET_WINDOWS
+  HANDLE handle = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, size, NULL);
+  if (handle == NULL)
+    return false;
+  uint8_t *buf = (uint8_t*)MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  if (buf == NULL)
+  {
+    CloseHandle(handle);
+    return false;
+  }
+#else
+  uint8_t *buf = new (std::nothrow) uint8_t[size];
+  if (buf == NULL)
+    return false;
+#endif
+
+  int64_t beg = std::max(m_beg, m_end - (int64_t)size);
+  for (int64_t pos = beg; pos < m_end;)
+  {
+    size_t from = pos % m_size;
+    size_t to   = pos % size;
+    size_t len  = std::min((size_t)(m_end - pos), std::min(m_size - from, size - to));
+    memcpy(buf + to, m_buf + from, len);
+    pos += len;
+  }
+
+#ifdef TARGET_WINDOWS
+  UnmapViewOfFile(m_buf);
+  CloseHandle(m_handle);
+  m_handle = handle;
+#else
+  delete[] m_buf;
+#endif
+  m_buf = buf;
+  m_beg = beg;
+  m_size = size;
+  m_size_back = back;
+
+  m_space.Set();
+
+  return true;
+}
@@ -49,6 +49,7 @@ public:
     bool IsCachedPosition(int64_t iFilePosition) override;
 
     CCacheStrategy *CreateNew() override;
+    bool Resize(size_t front, size_t back) override;
 protected:
     int64_t           m_beg;       /**< index in file (not buffer) of beginning of valid data */
     int64_t           m_end;       /**< index in file (not buffer) of end of valid data */
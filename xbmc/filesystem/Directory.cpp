@@ -176,8 +176,16 @@ bool CDirectory::GetDirectory(const CURL& url, std::shared_ptr<IDirectory> pDire
       return false;
 
     // check our cache for this path
+    int64_t folderTime = 0;
     if (g_directoryCache.GetDirectory(realURL.Get(), items, (hints.flags & DIR_FLAG_READ_CACHE) == DIR_FLAG_READ_CACHE))
       items.SetURL(url);
+    else if ((hints.flags & (DIR_FLAG_PERSISTENT_CACHE | DIR_FLAG_BYPASS_CACHE)) == DIR_FLAG_PERSISTENT_CACHE &&
+             g_directoryCache.LoadPersistent(realURL, items, folderTime))
+    {
+      // stored by an earlier session and the folder hasn't changed since
+      items.SetURL(url);
+      g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url));
+    }
     else
     {
       // need to clear the cache (in case the directory fetch fails)
@@ -259,7 +267,12 @@ bool CDirectory::GetDirectory(const CURL& url, std::shared_ptr<IDirectory> pDire
 
       // cache the directory, if necessary
       if (!(hints.flags & DIR_FLAG_BYPASS_CACHE))
+      {
         g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url));
+        // listings without file info are incomplete for other callers
+        if ((hints.flags & DIR_FLAG_PERSISTENT_CACHE) && !(hints.flags & DIR_FLAG_NO_FILE_INFO))
+          g_directoryCache.SavePersistent(realURL, items, folderTime);
+      }
     }
 
     // now filter for allowed files
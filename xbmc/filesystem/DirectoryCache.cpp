@@ -19,8 +19,12 @@
  */
 
 #include "DirectoryCache.h"
+#include "File.h"
 #include "FileItem.h"
+#include "settings/AdvancedSettings.h"
 #include "threads/SingleLock.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
@@ -28,10 +32,15 @@
 #include "climits"
 
 #include <algorithm>
+#include <stdexcept>
 
 // Maximum number of directories to keep in our cache
 #define MAX_CACHED_DIRS 50
 
+// Folder and format version of the on-disk cache
+#define PERSISTENT_CACHE_PATH "special://temp/dircache/"
+#define PERSISTENT_CACHE_VERSION 1
+
 using namespace XFILE;
 
 CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
@@ -126,8 +135,13 @@ void CDirectoryCache::ClearFile(const std::string& strFile)
 {
   // Get rid of any URL options, else the compare may be wrong
   std::string strFile2 = CURL(strFile).GetWithoutOptions();
+  std::string strPath = URIUtils::GetDirectory(strFile2);
+
+  ClearDirectory(strPath);
 
-  ClearDirectory(URIUtils::GetDirectory(strFile2));
+  // the folder time may not have changed if the file was touched right after
+  // the listing was stored, so don't rely on it
+  DeletePersistent(strPath);
 }
 
 void CDirectoryCache::ClearDirectory(const std::string& strPath)
@@ -141,6 +155,8 @@ void CDirectoryCache::ClearDirectory(const std::string& strPath)
   iCache i = m_cache.find(storedPath);
   if (i != m_cache.end())
     Delete(i);
+
+  DeletePersistent(strPath);
 }
 
 void CDirectoryCache::ClearSubPaths(const std::string& strPath)
@@ -176,6 +192,9 @@ void CDirectoryCache::AddFile(const std::string& strFile)
     dir->m_Items->Add(item);
     dir->SetLastAccess(m_accessCounter);
   }
+  lock.Leave();
+
+  DeletePersistent(strPath);
 }
 
 bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
@@ -206,6 +225,152 @@ bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
   return false;
 }
 
+bool CDirectoryCache::LoadPersistent(const CURL& url, CFileItemList &items, int64_t &time)
+{
+  time = 0;
+  if (!CanPersist(url))
+    return false;
+
+  // stat the folder even if nothing is stored, the caller needs the time to store the listing
+  struct __stat64 buffer;
+  if (CFile::Stat(url, &buffer) != 0)
+    return false;
+  time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+  if (!time)
+    return false;
+
+  std::string storedPath = url.GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string cacheFile = GetPersistentFile(storedPath);
+
+  CFile file;
+  if (!file.Open(cacheFile))
+    return false;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+    int version;
+    std::string path;
+    int64_t storedTime;
+    ar >> version;
+    if (version != PERSISTENT_CACHE_VERSION)
+      return false;
+    ar >> path;
+    ar >> storedTime;
+    // different path with the same crc or the folder changed
+    if (path != storedPath || storedTime != time)
+      return false;
+    ar >> items;
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "%s - corrupt cache file %s", __FUNCTION__, cacheFile.c_str());
+    items.Clear();
+    return false;
+  }
+
+#ifdef _DEBUG
+  CSingleLock lock(m_cs);
+  m_cacheHits += items.Size();
+#endif
+  return true;
+}
+
+void CDirectoryCache::SavePersistent(const CURL& url, const CFileItemList &items, int64_t time)
+{
+  if (!time || !CanPersist(url))
+    return;
+
+  std::string storedPath = url.GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string cacheFile = GetPersistentFile(storedPath);
+  std::string tempFile = cacheFile + ".tmp";
+
+  // write to a temporary file first so that readers never see a partial listing
+  CSingleLock lock(m_persistSection);
+  CFile file;
+  if (!file.OpenForWrite(tempFile, true))
+  {
+    CDirectory::Create(PERSISTENT_CACHE_PATH);
+    if (!file.OpenForWrite(tempFile, true))
+      return;
+  }
+
+  CArchive ar(&file, CArchive::store);
+  ar << PERSISTENT_CACHE_VERSION;
+  ar << storedPath;
+  ar << time;
+  // storing doesn't modify the list, CArchive just has no const overload
+  ar << const_cast<CFileItemList&>(items);
+  ar.Close();
+  file.Close();
+
+  if (!CFile::Rename(tempFile, cacheFile))
+  {
+    CFile::Delete(cacheFile);
+    if (!CFile::Rename(tempFile, cacheFile))
+      CFile::Delete(tempFile);
+  }
+}
+
+void CDirectoryCache::PrunePersistent()
+{
+  if (!CDirectory::Exists(PERSISTENT_CACHE_PATH))
+    return;
+
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(PERSISTENT_CACHE_PATH, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE | DIR_FLAG_GET_HIDDEN))
+    return;
+
+  CDateTime oldest = CDateTime::GetCurrentDateTime() - CDateTimeSpan(g_advancedSettings.m_iDirectoryCachePersistDays, 0, 0, 0);
+  int removed = 0;
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    const CFileItemPtr item = items[i];
+    if (item->m_bIsFolder)
+      continue;
+    // drop everything if persisting was disabled
+    if (!g_advancedSettings.m_bDirectoryCachePersist || !item->m_dateTime.IsValid() || item->m_dateTime < oldest)
+    {
+      if (CFile::Delete(item->GetPath()))
+        removed++;
+    }
+  }
+  CLog::Log(LOGDEBUG, "%s - removed %i of %i cached listings", __FUNCTION__, removed, items.Size());
+}
+
+bool CDirectoryCache::CanPersist(const CURL& url)
+{
+  if (!g_advancedSettings.m_bDirectoryCachePersist)
+    return false;
+
+  // only network shares are worth it, and only those report a folder
+  // modification time we can revalidate against
+  return url.IsProtocol("smb") || url.IsProtocol("nfs");
+}
+
+std::string CDirectoryCache::GetPersistentFile(const std::string& strPath)
+{
+  return StringUtils::Format(PERSISTENT_CACHE_PATH "%08x.fi", Crc32::Compute(strPath));
+}
+
+void CDirectoryCache::DeletePersistent(const std::string& strPath)
+{
+  CURL url(strPath);
+  if (!CanPersist(url))
+    return;
+
+  std::string storedPath = url.GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string cacheFile = GetPersistentFile(storedPath);
+
+  CSingleLock lock(m_persistSection);
+  if (CFile::Exists(cacheFile, false))
+    CFile::Delete(cacheFile);
+}
+
 void CDirectoryCache::Clear()
 {
   // this routine clears everything
@@ -25,8 +25,10 @@
 
 #include <map>
 #include <set>
+#include <stdint.h>
 
 class CFileItem;
+class CURL;
 
 namespace XFILE
 {
@@ -59,6 +61,32 @@ namespace XFILE
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
+
+    /*! \brief Get a listing from the on-disk cache, which survives restarts.
+     Only listings of network shares whose folders have a modification time
+     (smb, nfs) are persisted. The stored listing is only returned if the
+     modification time of the folder hasn't changed since it was stored. As
+     files edited in place don't change that time, only interactive browsing
+     (DIR_FLAG_PERSISTENT_CACHE) uses it; scanners and refreshes always fetch.
+     \param url the folder to get the listing of
+     \param items [out] the stored listing
+     \param time [out] the current modification time of the folder or 0 if the folder can't be persisted,
+                  to be passed to SavePersistent() when the listing has to be fetched
+     \return true if the stored listing is still valid
+     */
+    bool LoadPersistent(const CURL& url, CFileItemList &items, int64_t &time);
+
+    /*! \brief Store a listing in the on-disk cache.
+     \param url the folder the listing belongs to
+     \param items the listing
+     \param time the modification time of the folder as returned from LoadPersistent() before the listing was fetched
+     */
+    void SavePersistent(const CURL& url, const CFileItemList &items, int64_t time);
+
+    /*! \brief Remove listings from the on-disk cache that were stored more than
+     \sa CAdvancedSettings::m_iDirectoryCachePersistDays ago.
+     */
+    void PrunePersistent();
 #ifdef _DEBUG
     void PrintStats() const;
 #endif
@@ -72,7 +100,12 @@ namespace XFILE
     typedef std::map<std::string, CDir*>::const_iterator ciCache;
     void Delete(iCache i);
 
+    static bool CanPersist(const CURL& url);
+    static std::string GetPersistentFile(const std::string& strPath);
+    void DeletePersistent(const std::string& strPath);
+
     CCriticalSection m_cs;
+    CCriticalSection m_persistSection;
 
     unsigned int m_accessCounter;
 
@@ -0,0 +1,228 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DirectoryCrawler.h"
+
+#include <algorithm>
+
+#include "Directory.h"
+#include "File.h"
+#include "URL.h"
+#include "Util.h"
+#include "threads/SingleLock.h"
+
+// number of folders fetched concurrently
+#define CRAWLER_MAX_WORKERS   8
+// number of folders fetched concurrently from a single host
+#define CRAWLER_MAX_PER_HOST  4
+// number of folders which may be queued or fetched ahead of the scan
+#define CRAWLER_MAX_ENTRIES   1024
+
+using namespace XFILE;
+
+CDirectoryCrawler::CDirectoryCrawler(const std::string &mask, int flags,
+                                     const std::vector<std::string> &excludes,
+                                     bool statFolders)
+  : m_mask(mask),
+    m_flags(flags),
+    m_excludes(excludes),
+    m_statFolders(statFolders)
+{ }
+
+CDirectoryCrawler::~CDirectoryCrawler()
+{
+  {
+    CSingleLock lock(m_section);
+    m_stop = true;
+    m_queue.clear();
+    m_condition.notifyAll();
+  }
+
+  // wait for the folders which are still being fetched
+  for (auto &worker : m_workers)
+    worker->StopThread(true);
+}
+
+bool CDirectoryCrawler::GetDirectory(const std::string &path, CFileItemList &items)
+{
+  EntryPtr entry;
+  bool result;
+  if (Take(path, entry))
+  {
+    items.Assign(entry->items);
+    result = entry->result;
+  }
+  else
+  {
+    int64_t time;
+    result = Fetch(path, items, time);
+  }
+
+  CSingleLock lock(m_section);
+  Prefetch(items);
+
+  return result;
+}
+
+int64_t CDirectoryCrawler::GetFolderTime(const std::string &path)
+{
+  if (m_statFolders)
+  {
+    CSingleLock lock(m_section);
+    auto it = m_entries.find(path);
+    if (it != m_entries.end() && (it->second->fetching || it->second->done))
+    {
+      EntryPtr entry = it->second;
+      while (!entry->done)
+        m_condition.wait(lock);
+
+      return entry->time;
+    }
+  }
+
+  return StatFolder(path);
+}
+
+void CDirectoryCrawler::Release(const std::string &path)
+{
+  CSingleLock lock(m_section);
+  if (m_entries.erase(path) > 0)
+    m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), path), m_queue.end());
+}
+
+bool CDirectoryCrawler::Take(const std::string &path, EntryPtr &entry)
+{
+  CSingleLock lock(m_section);
+
+  auto it = m_entries.find(path);
+  if (it == m_entries.end())
+    return false;
+
+  entry = it->second;
+  m_entries.erase(it);
+
+  // not picked up by a worker yet, it's quicker to fetch it right away
+  if (!entry->fetching && !entry->done)
+  {
+    m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), path), m_queue.end());
+    return false;
+  }
+
+  while (!entry->done)
+    m_condition.wait(lock);
+
+  return true;
+}
+
+void CDirectoryCrawler::Prefetch(const CFileItemList &items)
+{
+  if (m_stop)
+    return;
+
+  // queue the subfolders in front of anything queued before, so the folders
+  // the scan recurses into next are fetched first
+  std::vector<std::string> paths;
+  for (int i = 0; i < items.Size(); i++)
+  {
+    const CFileItemPtr &item = items[i];
+    if (!item->m_bIsFolder || item->IsParentFolder() || item->IsPlayList())
+      continue;
+
+    const std::string &path = item->GetPath();
+    if (m_entries.size() >= CRAWLER_MAX_ENTRIES)
+      break;
+    if (m_entries.find(path) != m_entries.end() || CUtil::ExcludeFileOrFolder(path, m_excludes))
+      continue;
+
+    EntryPtr entry(new CEntry());
+    entry->host = CURL(path).GetHostName();
+    m_entries.insert(std::make_pair(path, entry));
+    paths.push_back(path);
+  }
+
+  if (paths.empty())
+    return;
+
+  m_queue.insert(m_queue.begin(), paths.begin(), paths.end());
+
+  size_t workers = std::min<size_t>(CRAWLER_MAX_WORKERS, m_queue.size());
+  while (m_workers.size() < workers)
+  {
+    std::unique_ptr<CThread> worker(new CThread(this, "DirectoryCrawler"));
+    worker->Create();
+    m_workers.push_back(std::move(worker));
+  }
+
+  m_condition.notifyAll();
+}
+
+void CDirectoryCrawler::Run()
+{
+  CSingleLock lock(m_section);
+  while (!m_stop)
+  {
+    // take the first folder of a host which isn't busy yet
+    auto it = std::find_if(m_queue.begin(), m_queue.end(), [this](const std::string &path) {
+      return m_activePerHost[m_entries[path]->host] < CRAWLER_MAX_PER_HOST;
+    });
+    if (it == m_queue.end())
+    {
+      m_condition.wait(lock);
+      continue;
+    }
+
+    std::string path = *it;
+    m_queue.erase(it);
+
+    EntryPtr entry = m_entries[path];
+    entry->fetching = true;
+    m_activePerHost[entry->host]++;
+
+    CFileItemList items;
+    int64_t time = 0;
+    lock.Leave();
+    bool result = Fetch(path, items, time);
+    lock.Enter();
+
+    m_activePerHost[entry->host]--;
+    entry->items.Assign(items);
+    entry->time = time;
+    entry->result = result;
+    entry->done = true;
+    m_condition.notifyAll();
+  }
+}
+
+bool CDirectoryCrawler::Fetch(const std::string &path, CFileItemList &items, int64_t &time) const
+{
+  if (m_statFolders)
+    time = StatFolder(path);
+
+  return CDirectory::GetDirectory(path, items, m_mask, m_flags);
+}
+
+int64_t CDirectoryCrawler::StatFolder(const std::string &path)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return 0;
+
+  return buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+}
@@ -0,0 +1,114 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "FileItem.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+namespace XFILE
+{
+  /*!
+   \brief Fetches directory listings ahead of a recursive scan.
+
+   Whenever a listing is handed out by GetDirectory(), the listings of its
+   subfolders are fetched in the background by a small pool of workers, with
+   a limited number of concurrent requests per host. When the scan recurses
+   into one of the subfolders its listing is usually already there, so the
+   round trips to network shares overlap instead of adding up. Listings that
+   haven't been prefetched are fetched directly.
+
+   The crawler must only be used by one thread at a time.
+   */
+  class CDirectoryCrawler : private IRunnable
+  {
+  public:
+    /*!
+     \param mask file mask passed to CDirectory::GetDirectory()
+     \param flags flags passed to CDirectory::GetDirectory()
+     \param excludes regular expressions of folders which should not be prefetched
+     \param statFolders whether to also fetch the modification time of every folder, see GetFolderTime()
+     */
+    CDirectoryCrawler(const std::string &mask, int flags,
+                      const std::vector<std::string> &excludes = std::vector<std::string>(),
+                      bool statFolders = false);
+    ~CDirectoryCrawler() override;
+
+    /*!
+     \brief Get the listing of the given folder and start prefetching its subfolders.
+     */
+    bool GetDirectory(const std::string &path, CFileItemList &items);
+
+    /*!
+     \brief Get the modification time (or creation time if not available) of the given folder.
+     \return The time or 0 if it couldn't be determined
+     */
+    int64_t GetFolderTime(const std::string &path);
+
+    /*!
+     \brief Drop the prefetched listing of the given folder because it won't be needed.
+     */
+    void Release(const std::string &path);
+
+  private:
+    CDirectoryCrawler(const CDirectoryCrawler&) = delete;
+    CDirectoryCrawler& operator=(const CDirectoryCrawler&) = delete;
+
+    struct CEntry
+    {
+      std::string host;
+      bool fetching = false;
+      bool done = false;
+      bool result = false;
+      int64_t time = 0;
+      CFileItemList items;
+    };
+    typedef std::shared_ptr<CEntry> EntryPtr;
+
+    // implementation of IRunnable
+    void Run() override;
+
+    void Prefetch(const CFileItemList &items);
+    bool Fetch(const std::string &path, CFileItemList &items, int64_t &time) const;
+    bool Take(const std::string &path, EntryPtr &entry);
+    static int64_t StatFolder(const std::string &path);
+
+    const std::string m_mask;
+    const int m_flags;
+    const std::vector<std::string> m_excludes;
+    const bool m_statFolders;
+
+    CCriticalSection m_section;
+    XbmcThreads::ConditionVariable m_condition;
+    bool m_stop = false;
+    std::map<std::string, EntryPtr> m_entries;
+    std::deque<std::string> m_queue;
+    std::map<std::string, unsigned int> m_activePerHost;
+    std::vector<std::unique_ptr<CThread>> m_workers;
+  };
+}
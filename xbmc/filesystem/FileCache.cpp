@@ -25,6 +25,8 @@
 #include "URL.h"
 
 #include "CircularCache.h"
+#include "ReadAheadPolicy.h"
+#include "cores/DataCacheCore.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "settings/AdvancedSettings.h"
@@ -106,6 +108,8 @@ CFileCache::CFileCache(const unsigned int flags)
   , m_forwardCacheSize(0)
   , m_fileSize(0)
   , m_flags(flags)
+  , m_readAheadFront(0)
+  , m_readAheadStamp(0)
 {
 }
 
@@ -116,6 +120,8 @@ CFileCache::CFileCache(CCacheStrategy *pCache, bool bDeleteCache /* = true */)
   , m_writeRate(0)
   , m_writeRateActual(0)
   , m_forwardCacheSize(0)
+  , m_readAheadFront(0)
+  , m_readAheadStamp(0)
 {
   m_pCache = pCache;
   m_bDeleteCache = bDeleteCache;
@@ -142,6 +148,7 @@ void CFileCache::SetCacheStrategy(CCacheStrategy *pCache, bool bDeleteCache /* =
 
   m_pCache = pCache;
   m_bDeleteCache = bDeleteCache;
+  m_readAhead.reset();
 }
 
 IFile *CFileCache::GetFileImp()
@@ -207,6 +214,17 @@ bool CFileCache::Open(const CURL& url)
         front /= 2;
         back /= 2;
       }
+
+      if (g_advancedSettings.m_cacheAdaptive && (m_flags & READ_AUDIO_VIDEO))
+      {
+        // start with a small buffer, it grows once the stream rate is known
+        m_readAhead.reset(new CReadAheadPolicy(front + back, g_advancedSettings.m_cacheTargetDuration,
+                                               g_advancedSettings.m_cacheReadFactor));
+        front = m_readAhead->GetForwardSize();
+        back = m_readAhead->GetBackSize();
+        m_readAheadFront = front;
+      }
+
       m_pCache = new CCircularCache(front, back);
       m_forwardCacheSize = front;
     }
@@ -289,12 +307,39 @@ void CFileCache::Process()
         average.Reset(m_writePos, bCompleteReset); // Can only recalculate new average from scratch after a full reset (empty cache)
         limiter.Reset(m_writePos);
         m_nSeekResult = m_seekPos;
+        if (m_readAhead)
+          m_readAhead->Reset(m_readPos, XbmcThreads::SystemClockMillis());
       }
 
       m_seekEnded.Set();
     }
 
-    while (m_writeRate)
+    while (m_readAhead)
+    {
+      UpdateReadAhead();
+
+      unsigned int fillRate = m_readAhead->GetFillRate(m_writePos - m_readPos);
+      if (fillRate == CReadAheadPolicy::FILL_UNLIMITED)
+      {
+        limiter.Reset(m_writePos);
+        break;
+      }
+
+      // forward buffer is full, restart rate measurement once it drained a bit
+      if (fillRate == 0)
+        limiter.Reset(m_writePos);
+      else if (limiter.Rate(m_writePos) < fillRate)
+        break;
+
+      if (m_seekEvent.WaitMSec(100))
+      {
+        if (!m_bStop)
+          m_seekEvent.Set();
+        break;
+      }
+    }
+
+    while (m_writeRate && !m_readAhead)
     {
       if (m_writePos - m_readPos < m_writeRate * g_advancedSettings.m_cacheReadFactor)
       {
@@ -326,7 +371,12 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (!cacheReachEOF)
+    {
+      const unsigned int readStart = XbmcThreads::SystemClockMillis();
       iRead = m_source.Read(buffer.get(), maxWrite);
+      if (m_readAhead && iRead > 0)
+        m_readAhead->AddSourceRead(iRead, XbmcThreads::SystemClockMillis() - readStart);
+    }
     if (iRead == 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -414,6 +464,37 @@ void CFileCache::Process()
   }
 }
 
+void CFileCache::UpdateReadAhead()
+{
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  m_readAhead->AddReadPosition(m_readPos, now);
+
+  if (now - m_readAheadStamp < 1000)
+    return;
+  m_readAheadStamp = now;
+
+  m_readAhead->SetStreamRate(m_writeRate);
+  m_readAhead->Update();
+
+  const size_t front = m_readAhead->GetForwardSize();
+  const size_t back = m_readAhead->GetBackSize();
+  if (front != m_readAheadFront && m_pCache->Resize(front, back))
+  {
+    CLog::Log(LOGDEBUG, "CFileCache::UpdateReadAhead - resized cache to %zu forward, %zu back (stream %u B/s, link %u B/s)",
+              front, back, m_readAhead->GetStreamRate(), m_readAhead->GetLinkRate());
+    m_readAheadFront = front;
+  }
+  m_forwardCacheSize = front;
+
+  unsigned int fillRate = m_readAhead->GetFillRate(m_writePos - m_readPos);
+  if (fillRate == CReadAheadPolicy::FILL_UNLIMITED)
+    fillRate = m_readAhead->GetLinkRate();
+
+  CDataCacheCore::GetInstance().SetReadAheadState(this, front, back, fillRate,
+                                                  m_readAhead->GetLinkRate(),
+                                                  m_readAhead->GetConsumeRate());
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -546,6 +627,9 @@ void CFileCache::Close()
     m_pCache->Close();
 
   m_source.Close();
+
+  if (m_readAhead)
+    CDataCacheCore::GetInstance().ResetReadAheadState(this);
 }
 
 int64_t CFileCache::GetPosition()
@@ -582,7 +666,9 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->forward = m_pCache->WaitForData(0, 0);
     status->level   = (m_forwardCacheSize == 0) ? 0.0 : (float) status->forward / m_forwardCacheSize;
     status->maxrate = m_writeRate;
-    status->currate = m_writeRateActual;
+    // the adaptive cache idles once its buffer is full, which drags the
+    // average write rate below the stream rate. report what the link can do
+    status->currate = m_readAhead ? m_readAhead->GetLinkRate() : m_writeRateActual;
     return 0;
   }
 
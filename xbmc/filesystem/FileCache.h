@@ -25,9 +25,11 @@
 #include "File.h"
 #include "threads/Thread.h"
 #include <atomic>
+#include <memory>
 
 namespace XFILE
 {
+  class CReadAheadPolicy;
 
   class CFileCache : public IFile, public CThread
   {
@@ -67,6 +69,8 @@ namespace XFILE
     }
 
   private:
+    void UpdateReadAhead();
+
     CCacheStrategy *m_pCache;
     bool m_bDeleteCache;
     int m_seekPossible;
@@ -85,6 +89,9 @@ namespace XFILE
     std::atomic<int64_t> m_fileSize;
     unsigned int m_flags;
     CCriticalSection m_sync;
+    std::unique_ptr<CReadAheadPolicy> m_readAhead;
+    size_t m_readAheadFront;
+    unsigned int m_readAheadStamp;
   };
 
 }
@@ -0,0 +1,146 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ReadAheadPolicy.h"
+
+#include <algorithm>
+
+using namespace XFILE;
+
+namespace
+{
+// smallest buffers worth having, even for low bitrate audio
+const size_t MIN_FORWARD_SIZE = 1024 * 1024;
+const size_t MIN_BACK_SIZE = 256 * 1024;
+
+// measurement windows
+const unsigned int LINK_SAMPLE_MILLIS = 250;
+const uint64_t LINK_SAMPLE_BYTES = 8 * 1024 * 1024;
+const unsigned int CONSUME_SAMPLE_MILLIS = 1000;
+
+// link throughput relative to the stream rate below which the link is
+// considered marginal and above which it is considered fast
+const unsigned int MARGINAL_LINK_FACTOR = 2;
+const unsigned int FAST_LINK_FACTOR = 8;
+
+unsigned int Smooth(unsigned int average, uint64_t sample)
+{
+  sample = std::min(sample, (uint64_t)CReadAheadPolicy::FILL_UNLIMITED - 1);
+  if (average == 0)
+    return (unsigned int)sample;
+  return (unsigned int)((3 * (uint64_t)average + sample) / 4);
+}
+}
+
+const unsigned int CReadAheadPolicy::FILL_UNLIMITED;
+
+CReadAheadPolicy::CReadAheadPolicy(size_t maxSize, unsigned int targetDuration, float readFactor)
+  : m_maxSize(maxSize)
+  , m_targetDuration(std::max(1U, targetDuration))
+  , m_readFactor(std::max(1.0f, readFactor))
+  , m_forward(0)
+  , m_back(0)
+{
+  Update();
+}
+
+void CReadAheadPolicy::Reset(int64_t readPos, unsigned int now)
+{
+  m_readPos = readPos;
+  m_readStamp = now;
+}
+
+void CReadAheadPolicy::AddSourceRead(size_t bytes, unsigned int millis)
+{
+  m_linkBytes += bytes;
+  m_linkMillis += millis;
+
+  if (m_linkMillis < LINK_SAMPLE_MILLIS && m_linkBytes < LINK_SAMPLE_BYTES)
+    return;
+
+  m_linkRate = Smooth(m_linkRate, 1000 * m_linkBytes / std::max(1U, m_linkMillis));
+  m_linkBytes = 0;
+  m_linkMillis = 0;
+}
+
+void CReadAheadPolicy::AddReadPosition(int64_t readPos, unsigned int now)
+{
+  const unsigned int elapsed = now - m_readStamp;
+  if (elapsed < CONSUME_SAMPLE_MILLIS)
+    return;
+
+  // a seek backwards is no consumption, just restart the window
+  if (readPos >= m_readPos)
+    m_consumeRate = Smooth(m_consumeRate, 1000 * (uint64_t)(readPos - m_readPos) / elapsed);
+
+  m_readPos = readPos;
+  m_readStamp = now;
+}
+
+unsigned int CReadAheadPolicy::GetStreamRate() const
+{
+  // the player knows the real bitrate, the consumption rate is off while
+  // it fills its queues and only serves as fallback
+  return m_streamRate ? m_streamRate : m_consumeRate;
+}
+
+void CReadAheadPolicy::Update()
+{
+  const size_t maxForward = m_maxSize - m_maxSize / 4;
+  const unsigned int rate = GetStreamRate();
+
+  size_t forward;
+  if (rate == 0)
+    forward = maxForward / 4;
+  else
+  {
+    double duration = m_targetDuration;
+    if (m_linkRate > 0 && m_linkRate < MARGINAL_LINK_FACTOR * (uint64_t)rate)
+      duration *= 2;
+    else if (m_linkRate > FAST_LINK_FACTOR * (uint64_t)rate)
+      duration /= 2;
+
+    forward = (size_t)std::min((double)maxForward, rate * duration);
+  }
+
+  forward = std::min(std::max(forward, MIN_FORWARD_SIZE), maxForward);
+
+  // resizing the cache moves its contents, so only follow larger changes
+  // once the initial guess was replaced
+  const bool first = m_forward == 0 || (rate > 0 && !m_sized);
+  if (first || forward > m_forward + m_forward / 4 || forward < m_forward - m_forward / 4)
+  {
+    m_sized = rate > 0;
+    m_forward = forward;
+    m_back = std::min(std::max(m_forward / 3, MIN_BACK_SIZE), m_maxSize - m_forward);
+  }
+}
+
+unsigned int CReadAheadPolicy::GetFillRate(int64_t ahead) const
+{
+  if (ahead >= (int64_t)m_forward)
+    return 0;
+
+  const unsigned int rate = GetStreamRate();
+  if (rate == 0 || ahead < (int64_t)(m_forward - m_forward / 4))
+    return FILL_UNLIMITED;
+
+  return (unsigned int)std::min((double)FILL_UNLIMITED - 1, (double)rate * m_readFactor);
+}
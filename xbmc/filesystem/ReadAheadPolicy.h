@@ -0,0 +1,111 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace XFILE
+{
+
+/*!
+ * \brief Decides how much a CFileCache reads ahead of the player.
+ *
+ * The policy measures how fast the source delivers data and how fast the
+ * demuxer consumes it, and sizes the forward and back buffers to hold a target
+ * playing duration. Slow links get a longer buffer to ride out dips,
+ * fast links a shorter one since refilling it is cheap.
+ * It never asks for more than the configured cache memory.
+ */
+class CReadAheadPolicy
+{
+public:
+  /*!
+   * \param maxSize upper bound for forward plus back buffer in bytes
+   * \param targetDuration playing time, in seconds, the forward buffer should hold
+   * \param readFactor multiple of the stream rate used to top up a nearly full buffer
+   */
+  CReadAheadPolicy(size_t maxSize, unsigned int targetDuration, float readFactor);
+
+  /*!
+   * \brief Forget the consumption measurement, e.g. after a seek
+   */
+  void Reset(int64_t readPos, unsigned int now);
+
+  /*!
+   * \brief Account a read from the source
+   * \param bytes number of bytes the read returned
+   * \param millis time the read blocked
+   */
+  void AddSourceRead(size_t bytes, unsigned int millis);
+
+  /*!
+   * \brief Sample the read position of the consumer
+   */
+  void AddReadPosition(int64_t readPos, unsigned int now);
+
+  /*!
+   * \brief Set the stream bitrate reported by the player in bytes per second
+   */
+  void SetStreamRate(unsigned int rate) { m_streamRate = rate; }
+
+  /*!
+   * \brief Recompute buffer sizes from the current measurements
+   */
+  void Update();
+
+  size_t GetForwardSize() const { return m_forward; }
+  size_t GetBackSize() const { return m_back; }
+
+  /*!
+   * \brief Get the rate the cache may be filled at
+   * \param ahead number of bytes cached ahead of the read position
+   * \return FILL_UNLIMITED below the low water mark, 0 once the forward buffer
+   *         is full, a rate in bytes per second in between
+   */
+  unsigned int GetFillRate(int64_t ahead) const;
+
+  unsigned int GetLinkRate() const { return m_linkRate; }
+  unsigned int GetConsumeRate() const { return m_consumeRate; }
+  unsigned int GetStreamRate() const;
+
+  static const unsigned int FILL_UNLIMITED = ~0U;
+
+private:
+  size_t m_maxSize;
+  unsigned int m_targetDuration;
+  float m_readFactor;
+
+  size_t m_forward;
+  size_t m_back;
+  bool m_sized = false;
+
+  unsigned int m_streamRate = 0;
+  unsigned int m_linkRate = 0;
+  unsigned int m_consumeRate = 0;
+
+  uint64_t m_linkBytes = 0;
+  unsigned int m_linkMillis = 0;
+
+  int64_t m_readPos = 0;
+  unsigned int m_readStamp = 0;
+};
+
+}
@@ -0,0 +1,111 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/CircularCache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace XFILE;
+
+namespace
+{
+void Fill(CCircularCache& cache, int64_t start, size_t len)
+{
+  std::vector<char> data(len);
+  for (size_t i = 0; i < len; i++)
+    data[i] = (char)((start + i) & 0xff);
+
+  size_t written = 0;
+  while (written < len)
+  {
+    int ret = cache.WriteToCache(data.data() + written, len - written);
+    ASSERT_GT(ret, 0);
+    written += ret;
+  }
+}
+
+void Verify(CCircularCache& cache, int64_t start, size_t len)
+{
+  std::vector<char> data(len);
+  size_t read = 0;
+  while (read < len)
+  {
+    int ret = cache.ReadFromCache(data.data() + read, len - read);
+    ASSERT_GT(ret, 0);
+    read += ret;
+  }
+
+  for (size_t i = 0; i < len; i++)
+    ASSERT_EQ((char)((start + i) & 0xff), data[i]) << "at " << start + i;
+}
+}
+
+TEST(TestCircularCache, GrowKeepsData)
+{
+  CCircularCache cache(1000, 300);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  // wrap around once so the data is split in the buffer
+  Fill(cache, 0, 1000);
+  Verify(cache, 0, 900);
+  Fill(cache, 1000, 900);
+
+  ASSERT_TRUE(cache.Resize(5000, 1000));
+  EXPECT_EQ(1900, cache.CachedDataEndPos());
+  EXPECT_EQ(1000, cache.WaitForData(0, 0));
+  Verify(cache, 900, 1000);
+
+  // back buffer survived the move
+  EXPECT_EQ(1600, cache.Seek(1600));
+  Verify(cache, 1600, 300);
+
+  Fill(cache, 1900, 4000);
+  Verify(cache, 1900, 4000);
+}
+
+TEST(TestCircularCache, ShrinkDropsHistory)
+{
+  CCircularCache cache(4000, 1000);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  Fill(cache, 0, 4000);
+  Verify(cache, 0, 3500);
+
+  ASSERT_TRUE(cache.Resize(600, 200));
+  EXPECT_FALSE(cache.IsCachedPosition(3000));
+  EXPECT_TRUE(cache.IsCachedPosition(3300));
+  Verify(cache, 3500, 500);
+
+  Fill(cache, 4000, 600);
+  Verify(cache, 4000, 600);
+}
+
+TEST(TestCircularCache, ShrinkKeepsForwardData)
+{
+  CCircularCache cache(4000, 1000);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  Fill(cache, 0, 3000);
+  EXPECT_FALSE(cache.Resize(2000, 500));
+  EXPECT_EQ(3000, cache.WaitForData(0, 0));
+  Verify(cache, 0, 3000);
+}
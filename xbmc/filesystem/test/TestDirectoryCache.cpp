@@ -0,0 +1,110 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/DirectoryCache.h"
+#include "filesystem/File.h"
+#include "FileItem.h"
+#include "settings/AdvancedSettings.h"
+#include "URL.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+const char* const FOLDER = "smb://server/share/movies";
+
+class CTestDirectoryCache : public XFILE::CDirectoryCache
+{
+public:
+  using XFILE::CDirectoryCache::GetPersistentFile;
+};
+
+class TestDirectoryCache : public ::testing::Test
+{
+protected:
+  TestDirectoryCache()
+  {
+    m_persist = g_advancedSettings.m_bDirectoryCachePersist;
+    g_advancedSettings.m_bDirectoryCachePersist = true;
+  }
+
+  ~TestDirectoryCache() override
+  {
+    XFILE::CFile::Delete(CTestDirectoryCache::GetPersistentFile(FOLDER));
+    g_advancedSettings.m_bDirectoryCachePersist = m_persist;
+  }
+
+  void Store()
+  {
+    CFileItemList items;
+    items.Add(CFileItemPtr(new CFileItem(std::string(FOLDER) + "/movie.mkv", false)));
+    m_cache.SavePersistent(CURL(FOLDER), items, 1);
+  }
+
+  bool IsStored() const
+  {
+    return XFILE::CFile::Exists(CTestDirectoryCache::GetPersistentFile(FOLDER), false);
+  }
+
+  CTestDirectoryCache m_cache;
+  bool m_persist;
+};
+}
+
+TEST_F(TestDirectoryCache, ClearDirectoryDropsPersistentListing)
+{
+  Store();
+  ASSERT_TRUE(IsStored());
+
+  m_cache.ClearDirectory(std::string(FOLDER) + "/");
+  EXPECT_FALSE(IsStored());
+}
+
+TEST_F(TestDirectoryCache, ClearFileDropsPersistentListing)
+{
+  Store();
+  ASSERT_TRUE(IsStored());
+
+  m_cache.ClearFile(std::string(FOLDER) + "/movie.mkv");
+  EXPECT_FALSE(IsStored());
+}
+
+TEST_F(TestDirectoryCache, AddFileDropsPersistentListing)
+{
+  Store();
+  ASSERT_TRUE(IsStored());
+
+  m_cache.AddFile(std::string(FOLDER) + "/other.mkv");
+  EXPECT_FALSE(IsStored());
+}
+
+TEST_F(TestDirectoryCache, NothingStoredWhenDisabled)
+{
+  g_advancedSettings.m_bDirectoryCachePersist = false;
+  Store();
+  EXPECT_FALSE(IsStored());
+}
+
+TEST_F(TestDirectoryCache, DisabledByDefault)
+{
+  CAdvancedSettings settings;
+  settings.Initialize();
+  EXPECT_FALSE(settings.m_bDirectoryCachePersist);
+}
@@ -0,0 +1,127 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/ReadAheadPolicy.h"
+
+#include "gtest/gtest.h"
+
+using namespace XFILE;
+
+namespace
+{
+const size_t MAX_SIZE = 64 * 1024 * 1024;
+const unsigned int STREAM_RATE = 1000 * 1000;
+}
+
+TEST(TestReadAheadPolicy, StartsSmallWithoutRate)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 30, 4.0f);
+  EXPECT_LT(policy.GetForwardSize() + policy.GetBackSize(), MAX_SIZE / 2);
+  EXPECT_EQ(CReadAheadPolicy::FILL_UNLIMITED, policy.GetFillRate(0));
+  EXPECT_EQ(0U, policy.GetFillRate(policy.GetForwardSize()));
+}
+
+TEST(TestReadAheadPolicy, SizesForTargetDuration)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 30, 4.0f);
+  policy.SetStreamRate(STREAM_RATE);
+  // link four times the stream rate, neither marginal nor fast
+  policy.AddSourceRead(4 * STREAM_RATE, 1000);
+  policy.Update();
+
+  EXPECT_EQ(30U * STREAM_RATE, policy.GetForwardSize());
+  EXPECT_EQ(10U * STREAM_RATE, policy.GetBackSize());
+}
+
+TEST(TestReadAheadPolicy, MarginalLinkBuffersMore)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 10, 4.0f);
+  policy.SetStreamRate(STREAM_RATE);
+  policy.AddSourceRead(STREAM_RATE + STREAM_RATE / 2, 1000);
+  policy.Update();
+
+  EXPECT_EQ(20U * STREAM_RATE, policy.GetForwardSize());
+}
+
+TEST(TestReadAheadPolicy, FastLinkBuffersLess)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 20, 4.0f);
+  policy.SetStreamRate(STREAM_RATE);
+  policy.AddSourceRead(100 * STREAM_RATE, 1000);
+  policy.Update();
+
+  EXPECT_EQ(10U * STREAM_RATE, policy.GetForwardSize());
+}
+
+TEST(TestReadAheadPolicy, NeverExceedsMaxSize)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 600, 4.0f);
+  policy.SetStreamRate(10 * STREAM_RATE);
+  policy.Update();
+
+  EXPECT_LE(policy.GetForwardSize() + policy.GetBackSize(), MAX_SIZE);
+  EXPECT_EQ(MAX_SIZE - MAX_SIZE / 4, policy.GetForwardSize());
+}
+
+TEST(TestReadAheadPolicy, IgnoresSmallChanges)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 10, 4.0f);
+  policy.SetStreamRate(STREAM_RATE);
+  policy.AddSourceRead(4 * STREAM_RATE, 1000);
+  policy.Update();
+  const size_t forward = policy.GetForwardSize();
+
+  policy.SetStreamRate(STREAM_RATE + STREAM_RATE / 10);
+  policy.Update();
+  EXPECT_EQ(forward, policy.GetForwardSize());
+
+  policy.SetStreamRate(2 * STREAM_RATE);
+  policy.Update();
+  EXPECT_EQ(2 * forward, policy.GetForwardSize());
+}
+
+TEST(TestReadAheadPolicy, FillRateZones)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 30, 4.0f);
+  policy.SetStreamRate(STREAM_RATE);
+  policy.AddSourceRead(4 * STREAM_RATE, 1000);
+  policy.Update();
+  const int64_t forward = policy.GetForwardSize();
+
+  EXPECT_EQ(CReadAheadPolicy::FILL_UNLIMITED, policy.GetFillRate(forward / 2));
+  EXPECT_EQ(4 * STREAM_RATE, policy.GetFillRate(forward - forward / 8));
+  EXPECT_EQ(0U, policy.GetFillRate(forward));
+}
+
+TEST(TestReadAheadPolicy, MeasuresConsumption)
+{
+  CReadAheadPolicy policy(MAX_SIZE, 30, 4.0f);
+  policy.Reset(0, 10000);
+  policy.AddReadPosition(STREAM_RATE / 2, 10500);
+  EXPECT_EQ(0U, policy.GetConsumeRate());
+
+  policy.AddReadPosition(2 * STREAM_RATE, 12000);
+  EXPECT_EQ(STREAM_RATE, policy.GetConsumeRate());
+  EXPECT_EQ(STREAM_RATE, policy.GetStreamRate());
+
+  // the rate reported by the player wins
+  policy.SetStreamRate(2 * STREAM_RATE);
+  EXPECT_EQ(2 * STREAM_RATE, policy.GetStreamRate());
+}
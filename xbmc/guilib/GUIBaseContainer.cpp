@@ -33,6 +33,7 @@
 #include "utils/MathUtils.h"
 #include "utils/XBMCTinyXML.h"
 #include "listproviders/IListProvider.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "guilib/guiinfo/GUIInfoLabels.h"
 
@@ -173,6 +174,9 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
       {
         item->GetFocusedLayout()->SetFocusedItem(0);
       }
+      // a skipped focused layout missed any changes of the item while it was hidden
+      if (item != m_lastItem && g_advancedSettings.m_guiSkipHiddenLayouts)
+        item->GetFocusedLayout()->SetInvalid();
       if (item != m_lastItem && HasFocus())
       {
         item->GetFocusedLayout()->ResetAnimation(ANIM_TYPE_UNFOCUS);
@@ -181,7 +185,7 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
           subItem = m_lastItem->GetFocusedLayout()->GetFocusedItem();
         item->GetFocusedLayout()->SetFocusedItem(subItem ? subItem : 1);
       }
-      item->GetFocusedLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
+      ProcessLayout(item->GetFocusedLayout(), item.get(), currentTime, dirtyregions);
     }
     m_lastItem = item;
   }
@@ -195,15 +199,24 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
       layout->SetParentControl(this);
       item->SetLayout(std::move(layout));
     }
-    if (item->GetFocusedLayout())
-      item->GetFocusedLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
+    // the focused layout of an unfocused item is only rendered while it animates out of focus.
+    // otherwise it is skipped (unless <gui><skiphiddenlayouts> is off) and its visibility,
+    // animations and scrolling labels stand still until the item is focused again
+    if (item->GetFocusedLayout() &&
+        (!g_advancedSettings.m_guiSkipHiddenLayouts || item->GetFocusedLayout()->IsAnimating(ANIM_TYPE_UNFOCUS)))
+      ProcessLayout(item->GetFocusedLayout(), item.get(), currentTime, dirtyregions);
     if (item->GetLayout())
-      item->GetLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
+      ProcessLayout(item->GetLayout(), item.get(), currentTime, dirtyregions);
   }
 
   CServiceBroker::GetWinSystem()->GetGfxContext().RestoreOrigin();
 }
 
+void CGUIBaseContainer::ProcessLayout(CGUIListItemLayout *layout, CGUIListItem *item, unsigned int currentTime, CDirtyRegionList &dirtyregions)
+{
+  layout->Process(item, m_parentID, currentTime, dirtyregions);
+}
+
 void CGUIBaseContainer::Render()
 {
   if (!m_layout || !m_focusedLayout) return;
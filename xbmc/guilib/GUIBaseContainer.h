@@ -112,6 +112,7 @@ protected:
   bool OnClick(int actionID);
 
   virtual void ProcessItem(float posX, float posY, CGUIListItemPtr& item, bool focused, unsigned int currentTime, CDirtyRegionList &dirtyregions);
+  virtual void ProcessLayout(CGUIListItemLayout *layout, CGUIListItem *item, unsigned int currentTime, CDirtyRegionList &dirtyregions);
 
   void Render() override;
   virtual void RenderItem(float posX, float posY, CGUIListItem *item, bool focused);
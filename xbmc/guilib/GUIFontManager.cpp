@@ -36,15 +36,91 @@
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
 #include "FileItem.h"
+#include "LangInfo.h"
 #include "URL.h"
 #include "ServiceBroker.h"
+#include "utils/CharsetConverter.h"
 
 #ifdef TARGET_POSIX
 #include "filesystem/SpecialProtocol.h"
 #endif
 
+#include <set>
+
 using namespace ADDON;
 
+namespace
+{
+struct CommonGlyphRange
+{
+  const char *charset;
+  unsigned char leadFirst;
+  unsigned char leadLast;
+  unsigned char trailFirst;
+  unsigned char trailLast;
+};
+
+// the frequently used part of the multi byte charsets, anything else is rasterized on first use
+const CommonGlyphRange CommonGlyphRanges[] =
+{
+  { "GBK",        0xB0, 0xD7, 0xA1, 0xFE }, // GB2312 level 1 hanzi
+  { "BIG5",       0xA4, 0xC6, 0x40, 0xFE }, // Big5 frequently used hanzi
+  { "BIG5-HKSCS", 0xA4, 0xC6, 0x40, 0xFE },
+  { "SHIFT_JIS",  0x82, 0x98, 0x40, 0xFC }, // kana and JIS level 1 kanji
+  { "CP949",      0xB0, 0xC8, 0xA1, 0xFE }, // KS X 1001 hangul
+};
+
+/*!
+ \brief Get the characters commonly shown by the GUI in the given charset.
+ \return ASCII followed by the common characters of the charset
+ */
+std::u32string GetCommonGlyphs(const std::string &charset)
+{
+  std::vector<std::string> sequences;
+  const CommonGlyphRange *range = nullptr;
+  for (const auto &it : CommonGlyphRanges)
+  {
+    if (StringUtils::EqualsNoCase(charset, it.charset))
+      range = &it;
+  }
+
+  if (range)
+  {
+    for (unsigned int lead = range->leadFirst; lead <= range->leadLast; lead++)
+    {
+      for (unsigned int trail = range->trailFirst; trail <= range->trailLast; trail++)
+        sequences.push_back(std::string{ static_cast<char>(lead), static_cast<char>(trail) });
+    }
+  }
+  else
+  {
+    // the upper half of a single byte charset
+    for (unsigned int c = 0x80; c <= 0xFF; c++)
+      sequences.push_back(std::string(1, static_cast<char>(c)));
+  }
+
+  std::u32string glyphs;
+  for (char32_t c = 0x20; c < 0x7F; c++)
+    glyphs.push_back(c);
+
+  std::set<char32_t> seen(glyphs.begin(), glyphs.end());
+  for (const auto &sequence : sequences)
+  {
+    // sequences which aren't valid in the charset are skipped
+    std::string utf8;
+    if (!CCharsetConverter::ToUtf8(charset, sequence, utf8, true) || utf8.empty())
+      continue;
+
+    for (char32_t c : CCharsetConverter::utf8ToUtf32(utf8, true))
+    {
+      if (c >= 0x20 && c <= 0xFFFF && seen.insert(c).second)
+        glyphs.push_back(c);
+    }
+  }
+  return glyphs;
+}
+}
+
 GUIFontManager::GUIFontManager(void)
 {
   m_canReload = true;
@@ -251,6 +327,27 @@ void GUIFontManager::ReloadTTFFonts(void)
 
     font->SetFont(pFontFile);
   }
+
+  PrewarmFonts();
+}
+
+void GUIFontManager::PrewarmFonts()
+{
+  const std::u32string glyphs = GetCommonGlyphs(g_langInfo.GetGuiCharSet());
+
+  for (CGUIFont *font : m_vecFonts)
+  {
+    CGUIFontTTFBase *fontFile = font->GetFont();
+    if (!fontFile)
+      continue;
+
+    vecText text;
+    text.reserve(glyphs.size());
+    character_t style = (font->GetStyle() & FONT_STYLE_MASK) << 24;
+    for (char32_t letter : glyphs)
+      text.push_back(style | letter);
+    fontFile->Prewarm(text);
+  }
 }
 
 void GUIFontManager::Unload(const std::string& strFontName)
@@ -434,6 +531,8 @@ void GUIFontManager::LoadFonts(const TiXmlNode* fontNode)
     }
     fontNode = fontNode->NextSibling("font");
   }
+
+  PrewarmFonts();
 }
 
 void GUIFontManager::GetStyle(const TiXmlNode *fontNode, int &iStyle)
@@ -84,6 +84,9 @@ public:
 
 protected:
   void ReloadTTFFonts();
+  /*! \brief Rasterize the characters of the GUI language on worker threads, ahead of their first use
+   */
+  void PrewarmFonts();
   static void RescaleFontSizeAndAspect(float *size, float *aspect, const RESOLUTION_INFO &sourceRes, bool preserveAspect);
   void LoadFonts(const TiXmlNode* fontNode);
   CGUIFontTTFBase* GetFontFile(const std::string& strFontFile);
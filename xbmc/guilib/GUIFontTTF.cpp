@@ -31,8 +31,11 @@
 #include "windowing/WinSystem.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/JobManager.h"
 
+#include <algorithm>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -61,6 +64,7 @@
 #define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
 #define GLYPH_STRENGTH_BOLD 24
 #define GLYPH_STRENGTH_LIGHT -48
+#define PREWARM_MAX_BYTES (512 * 1024) // memory a font may use for glyphs rasterized ahead of their use
 
 
 class CFreeTypeLibrary
@@ -161,6 +165,40 @@ private:
 XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 #define g_freeTypeLibrary XBMC_GLOBAL_USE(CFreeTypeLibrary)
 
+static FT_Pos GetBorderStrength(FT_Face face)
+{
+  FT_Pos strength = FT_MulFix( face->units_per_EM, face->size->metrics.y_scale) / 12;
+  if (strength < 128)
+    strength = 128;
+  return strength;
+}
+
+class CGUIFontTTFBase::CPrewarmJob : public CJob
+{
+public:
+  explicit CPrewarmJob(CGUIFontTTFBase &font) : m_font(font) {}
+
+  // also runs if the job is cancelled before it started. Signals under the lock,
+  // the font may be gone as soon as StopPrewarm() sees no jobs left.
+  ~CPrewarmJob() override
+  {
+    CSingleLock lock(m_font.m_prewarmSection);
+    m_font.m_prewarmJobs--;
+    m_font.m_prewarmJobDone.Set();
+  }
+
+  bool DoWork() override
+  {
+    m_font.PrewarmCharacters();
+    return true;
+  }
+
+  const char *GetType() const override { return "fontprewarm"; }
+
+private:
+  CGUIFontTTFBase &m_font;
+};
+
 CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache(*this), m_dynamicCache(*this)
 {
   m_texture = NULL;
@@ -172,6 +210,8 @@ CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache
 
   m_face = NULL;
   m_stroker = NULL;
+  m_aspect = 1.0f;
+  m_border = false;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_strFileName = strFileName;
   m_referenceCount = 0;
@@ -227,6 +267,8 @@ void CGUIFontTTFBase::ClearCharacterCache()
 
 void CGUIFontTTFBase::Clear()
 {
+  StopPrewarm();
+
   delete(m_texture);
   m_texture = NULL;
   delete[] m_char;
@@ -245,6 +287,16 @@ void CGUIFontTTFBase::Clear()
     g_freeTypeLibrary.ReleaseStroker(m_stroker);
   m_stroker = NULL;
 
+  for (const auto &it : m_prewarmed)
+    FT_Done_Glyph(it.second.glyph);
+  m_prewarmed.clear();
+  m_prewarmRequested.clear();
+  m_prewarmPending.clear();
+  m_prewarmBytes = 0;
+  m_prewarmCancelled = false;
+  m_prewarmJobId = 0;
+  ReleasePrewarmFace();
+
   m_vertexTrans.clear();
   m_vertex.clear();
 
@@ -288,9 +340,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
      add on the strength of any border - the non-bordered font needs
      aligning with the bordered font by utilising GetTextBaseLine()
      */
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
-    if (strength < 128)
-      strength = 128;
+    FT_Pos strength = GetBorderStrength(m_face);
 
     cellDescender -= strength;
     cellAscender  += strength;
@@ -309,6 +359,8 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_cellHeight   = cellAscender - cellDescender;
 
   m_height = height;
+  m_aspect = aspect;
+  m_border = border;
 
   delete(m_texture);
   m_texture = NULL;
@@ -698,39 +750,67 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   return m_char + low;
 }
 
-bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+bool CGUIFontTTFBase::RasterizeCharacter(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style, FT_Glyph &glyph, float &advance)
 {
-  int glyph_index = FT_Get_Char_Index( m_face, letter );
+  int glyph_index = FT_Get_Char_Index( face, letter );
 
-  FT_Glyph glyph = NULL;
-  if (FT_Load_Glyph( m_face, glyph_index, FT_LOAD_TARGET_LIGHT ))
+  glyph = NULL;
+  if (FT_Load_Glyph( face, glyph_index, FT_LOAD_TARGET_LIGHT ))
   {
     CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
     return false;
   }
   // make bold if applicable
   if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_BOLD);
   // and italics if applicable
   if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
+    ObliqueGlyph(face->glyph);
   // and light if applicable
   if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_LIGHT);
   // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
+  if (FT_Get_Glyph(face->glyph, &glyph))
   {
     CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
     return false;
   }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+  if (stroker)
+    FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
   // render the glyph
   if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
   {
     CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
+    FT_Done_Glyph(glyph);
     return false;
   }
+  advance = (float)MathUtils::round_int( (float)face->glyph->advance.x / 64 );
+  return true;
+}
+
+bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+{
+  FT_Glyph glyph = NULL;
+  float advance = 0;
+
+  // use the glyph if it has been prewarmed, otherwise render it now
+  bool prewarmed = false;
+  {
+    CSingleLock lock(m_prewarmSection);
+    auto it = m_prewarmed.find((style << 16) | letter);
+    if (it != m_prewarmed.end())
+    {
+      glyph = it->second.glyph;
+      advance = it->second.advance;
+      m_prewarmBytes -= it->second.bytes;
+      m_prewarmed.erase(it);
+      prewarmed = true;
+    }
+    ReleasePrewarmFace();
+  }
+  if (!prewarmed && !RasterizeCharacter(m_face, m_stroker, letter, style, glyph, advance))
+    return false;
+
   FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
   FT_Bitmap bitmap = bitGlyph->bitmap;
   bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
@@ -788,7 +868,7 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   ch->top = isEmptyGlyph ? 0 : ((float)m_posY + ch->offsetY);
   ch->right = ch->left + bitmap.width;
   ch->bottom = ch->top + bitmap.rows;
-  ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
+  ch->advance = advance;
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -810,6 +890,142 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   return true;
 }
 
+void CGUIFontTTFBase::Prewarm(const vecText &text)
+{
+  if (!m_face)
+    return;
+
+  CSingleLock lock(m_prewarmSection);
+  for (character_t chr : text)
+  {
+    wchar_t letter = (wchar_t)(chr & 0xffff);
+    character_t style = (chr & 0x7000000) >> 24;
+    if (letter == L'\r')
+      continue;
+
+    // same key as Character::letterAndStyle, skip those already in the texture
+    character_t ch = (style << 16) | letter;
+    Character *cached = std::lower_bound(m_char, m_char + m_numChars, ch,
+                                         [](const Character &c, character_t value) { return c.letterAndStyle < value; });
+    if (cached != m_char + m_numChars && cached->letterAndStyle == ch)
+      continue;
+    if (m_prewarmRequested.insert(ch).second)
+      m_prewarmPending.push_back(ch);
+  }
+
+  if (m_prewarmPending.empty() || m_prewarmRunning || m_prewarmBytes >= PREWARM_MAX_BYTES)
+  {
+    ReleasePrewarmFace();
+    return;
+  }
+
+  if (!m_prewarmFace)
+  {
+    m_prewarmFace = g_freeTypeLibrary.GetFont(m_strFilename, m_height, m_aspect, m_prewarmFontFileInMemory);
+    if (!m_prewarmFace)
+    {
+      m_prewarmPending.clear();
+      return;
+    }
+    if (m_border)
+    {
+      m_prewarmStroker = g_freeTypeLibrary.GetStroker();
+      if (m_prewarmStroker)
+        FT_Stroker_Set(m_prewarmStroker, GetBorderStrength(m_prewarmFace), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+    }
+  }
+
+  m_prewarmRunning = true;
+  m_prewarmStarted = false;
+  m_prewarmJobs++;
+  CPrewarmJob *job = new CPrewarmJob(*this);
+
+  // the job manager deletes cancelled jobs under its own lock, don't hold ours while queueing
+  lock.Leave();
+  unsigned int jobId = CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_LOW);
+  lock.Enter();
+
+  if (!jobId)
+  {
+    // not queued, the job manager is shutting down
+    m_prewarmRunning = false;
+    delete job;
+    return;
+  }
+  m_prewarmJobId = jobId;
+}
+
+void CGUIFontTTFBase::PrewarmCharacters()
+{
+  CSingleLock lock(m_prewarmSection);
+  m_prewarmStarted = true;
+  while (!m_prewarmPending.empty() && !m_prewarmCancelled && m_prewarmBytes < PREWARM_MAX_BYTES)
+  {
+    character_t ch = m_prewarmPending.front();
+    m_prewarmPending.pop_front();
+    lock.Leave();
+
+    FT_Glyph glyph;
+    float advance;
+    bool rasterized = RasterizeCharacter(m_prewarmFace, m_prewarmStroker, (wchar_t)(ch & 0xffff), ch >> 16, glyph, advance);
+
+    lock.Enter();
+    if (rasterized)
+    {
+      const FT_Bitmap &bitmap = ((FT_BitmapGlyph)glyph)->bitmap;
+      size_t bytes = sizeof(FT_BitmapGlyphRec) + bitmap.rows * std::abs(bitmap.pitch);
+      m_prewarmBytes += bytes;
+      m_prewarmed.insert(std::make_pair(ch, PrewarmedCharacter{ glyph, advance, bytes }));
+    }
+  }
+
+  // whatever didn't fit the budget is rendered on first use
+  if (m_prewarmBytes >= PREWARM_MAX_BYTES)
+    m_prewarmPending.clear();
+  m_prewarmRunning = false;
+}
+
+void CGUIFontTTFBase::StopPrewarm()
+{
+  CSingleLock lock(m_prewarmSection);
+  m_prewarmCancelled = true;
+  if (m_prewarmJobs == 0)
+    return;
+
+  // a job that didn't start yet is deleted right away, only a running one is waited for
+  if (!m_prewarmStarted)
+  {
+    unsigned int jobId = m_prewarmJobId;
+    lock.Leave();
+    CJobManager::GetInstance().CancelJob(jobId);
+    lock.Enter();
+  }
+
+  while (m_prewarmJobs > 0)
+  {
+    lock.Leave();
+    m_prewarmJobDone.Wait();
+    lock.Enter();
+  }
+  m_prewarmRunning = false;
+}
+
+void CGUIFontTTFBase::ReleasePrewarmFace()
+{
+  // faces are created and released on the thread that loads the font, the
+  // worker only uses them. Released once idle, glyphs rasterized so far stay.
+  if (m_prewarmRunning)
+    return;
+
+  if (m_prewarmFace)
+    g_freeTypeLibrary.ReleaseFont(m_prewarmFace);
+  m_prewarmFace = nullptr;
+  if (m_prewarmStroker)
+    g_freeTypeLibrary.ReleaseStroker(m_prewarmStroker);
+  m_prewarmStroker = nullptr;
+  m_prewarmFontFileInMemory.clear();
+}
+
 void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices)
 {
   // actual image width isn't same as the character width as that is
@@ -988,8 +1204,8 @@ void CGUIFontTTFBase::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / glyphStrength;
+  FT_Pos strength = FT_MulFix( slot->face->units_per_EM,
+                    slot->face->size->metrics.y_scale ) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
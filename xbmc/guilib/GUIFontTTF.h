@@ -20,10 +20,15 @@
  *
  */
 
+#include <deque>
+#include <map>
+#include <set>
 #include <string>
 #include <stdint.h>
 #include <vector>
 
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/auto_buffer.h"
 #include "utils/Color.h"
 #include "utils/Geometry.h"
@@ -44,12 +49,14 @@ class CRenderSystemBase;
 struct FT_FaceRec_;
 struct FT_LibraryRec_;
 struct FT_GlyphSlotRec_;
+struct FT_GlyphRec_;
 struct FT_BitmapGlyphRec_;
 struct FT_StrokerRec_;
 
 typedef struct FT_FaceRec_ *FT_Face;
 typedef struct FT_LibraryRec_ *FT_Library;
 typedef struct FT_GlyphSlotRec_ *FT_GlyphSlot;
+typedef struct FT_GlyphRec_ *FT_Glyph;
 typedef struct FT_BitmapGlyphRec_ *FT_BitmapGlyph;
 typedef struct FT_StrokerRec_ *FT_Stroker;
 
@@ -97,6 +104,12 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief Rasterize characters on a worker thread ahead of their first use.
+   They are copied to the texture when first drawn, without any FreeType work on the render thread.
+   \param text the characters to prepare, including their style bits
+   */
+  void Prewarm(const vecText &text);
+
 protected:
   struct Character
   {
@@ -124,6 +137,7 @@ protected:
   // Stuff for pre-rendering for speed
   inline Character *GetCharacter(character_t letter);
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
+  static bool RasterizeCharacter(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style, FT_Glyph &glyph, float &advance);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
 
@@ -132,7 +146,7 @@ protected:
   virtual void DeleteHardwareTexture() = 0;
 
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
@@ -165,6 +179,8 @@ protected:
   // freetype stuff
   FT_Face    m_face;
   FT_Stroker m_stroker;
+  float      m_aspect;
+  bool       m_border;
 
   float m_originX;
   float m_originY;
@@ -195,6 +211,37 @@ protected:
   CRenderSystemBase *m_renderSystem = nullptr;
 
 private:
+  friend class TestGUIFontTTF;
+  class CPrewarmJob;
+
+  struct PrewarmedCharacter
+  {
+    FT_Glyph glyph;
+    float advance;
+    size_t bytes; // counted against PREWARM_MAX_BYTES
+  };
+
+  void PrewarmCharacters();
+  void StopPrewarm();
+  void ReleasePrewarmFace();
+
+  // the worker has its own face and stroker, as FreeType objects must not be shared between threads
+  FT_Face m_prewarmFace = nullptr;
+  FT_Stroker m_prewarmStroker = nullptr;
+  XUTILS::auto_buffer m_prewarmFontFileInMemory;
+
+  CCriticalSection m_prewarmSection;
+  std::set<character_t> m_prewarmRequested;
+  std::deque<character_t> m_prewarmPending;
+  std::map<character_t, PrewarmedCharacter> m_prewarmed; // rasterized, but not in the texture yet
+  size_t m_prewarmBytes = 0;
+  bool m_prewarmRunning = false;
+  bool m_prewarmStarted = false;
+  bool m_prewarmCancelled = false;
+  unsigned int m_prewarmJobId = 0;
+  unsigned int m_prewarmJobs = 0;
+  CEvent m_prewarmJobDone;
+
   virtual bool FirstBegin() = 0;
   virtual void LastEnd() = 0;
   CGUIFontTTFBase(const CGUIFontTTFBase&) = delete;
@@ -136,33 +136,54 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  CGUIXMLCache &xmlCache = g_SkinInfo->GetXMLCache();
+  bool loaded = false;
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
-    CXBMCTinyXML xmlDoc;
-    std::string strPathLower = strPath;
-    StringUtils::ToLower(strPathLower);
-    if (!xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(strLowerPath))
+    // a window resolved in an earlier run saves parsing and resolving its xml
+    std::unique_ptr<TiXmlElement> resolved = xmlCache.GetResolved(strPath, m_xmlIncludeConditions);
+    if (resolved)
+      return Load(resolved.get());
+
+    // xml may already have been parsed by a prefetch
+    std::unique_ptr<TiXmlElement> root = xmlCache.GetParsed(strPath);
+    if (!root)
     {
-      CLog::Log(LOGERROR, "Unable to load window XML: %s. Line %d\n%s", strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
-      SetID(WINDOW_INVALID);
-      return false;
-    }
+      CXBMCTinyXML xmlDoc;
+      std::string strPathLower = strPath;
+      StringUtils::ToLower(strPathLower);
+      if (!xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(strLowerPath))
+      {
+        CLog::Log(LOGERROR, "Unable to load window XML: %s. Line %d\n%s", strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
+        SetID(WINDOW_INVALID);
+        return false;
+      }
 
-    // xml need a <window> root element
-    if (!StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
-    {
-      CLog::Log(LOGERROR, "XML file %s does not contain a <window> root element", GetProperty("xmlfile").c_str());
-      return false;
+      // xml need a <window> root element
+      if (!StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
+      {
+        CLog::Log(LOGERROR, "XML file %s does not contain a <window> root element", GetProperty("xmlfile").c_str());
+        return false;
+      }
+
+      root.reset(static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone()));
     }
 
     // store XML for further processing if window's load type is LOAD_EVERY_TIME or a reload is needed
-    m_windowXMLRootElement = static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone());
+    m_windowXMLRootElement = root.release();
+    loaded = true;
   }
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  std::unique_ptr<TiXmlElement> resolved = Prepare(m_windowXMLRootElement);
+  // the stored root node is resolved every time the window loads, only the first one is worth writing
+  if (resolved && loaded)
+    xmlCache.StoreResolved(strPath, *resolved, m_xmlIncludeConditions);
+
+  return Load(resolved.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
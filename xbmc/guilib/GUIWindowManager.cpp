@@ -1576,6 +1576,29 @@ bool CGUIWindowManager::IsWindowVisible(const std::string &xmlFile) const
 void CGUIWindowManager::LoadNotOnDemandWindows()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+
+  // parse the xml of these windows and the startup window on worker threads
+  // while the first ones are being loaded
+  if (g_SkinInfo)
+  {
+    const int startWindow = g_SkinInfo->GetStartWindow();
+    std::vector<std::string> files;
+    for (const auto& entry : m_mapWindows)
+    {
+      CGUIWindow *pWindow = entry.second;
+      if (pWindow->GetLoadType() != CGUIWindow::LOAD_ON_GUI_INIT && entry.first != startWindow)
+        continue;
+
+      std::string xmlFile = pWindow->GetProperty("xmlfile").asString();
+      if (xmlFile.empty())
+        continue;
+      if (xmlFile.find("\\") == std::string::npos && xmlFile.find("/") == std::string::npos)
+        xmlFile = g_SkinInfo->GetSkinPath(xmlFile);
+      files.push_back(xmlFile);
+    }
+    g_SkinInfo->GetXMLCache().Prefetch(files);
+  }
+
   for (const auto& entry : m_mapWindows)
   {
     CGUIWindow *pWindow = entry.second;
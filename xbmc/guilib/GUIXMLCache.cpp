@@ -0,0 +1,553 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUIXMLCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "GUIIncludes.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIComponent.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/auto_buffer.h"
+#include "utils/Crc32.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+namespace
+{
+const char* XMLCACHE_FOLDER = "special://temp/skincache/";
+const uint32_t XMLCACHE_MAGIC = 0x4B535843; // "KSXC"
+const uint32_t XMLCACHE_VERSION = 1;
+
+enum NodeTag : uint8_t
+{
+  TAG_ELEMENT,
+  TAG_TEXT,
+  TAG_CDATA,
+  TAG_COMMENT,
+};
+
+class CWriter
+{
+public:
+  explicit CWriter(std::string &buffer) : m_buffer(buffer) {}
+
+  template<typename T>
+  void Write(T value) { m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+  void Write(const char *value)
+  {
+    const uint32_t length = strlen(value);
+    Write(length);
+    m_buffer.append(value, length);
+  }
+
+  void Write(const std::string &value) { Write(value.c_str()); }
+
+private:
+  std::string &m_buffer;
+};
+
+class CReader
+{
+public:
+  CReader(const char *&pos, const char *end) : m_pos(pos), m_end(end) {}
+
+  template<typename T>
+  bool Read(T &value)
+  {
+    if (m_end - m_pos < static_cast<ptrdiff_t>(sizeof(value)))
+      return false;
+    memcpy(&value, m_pos, sizeof(value));
+    m_pos += sizeof(value);
+    return true;
+  }
+
+  bool Read(std::string &value)
+  {
+    uint32_t length;
+    if (!Read(length) || static_cast<size_t>(m_end - m_pos) < length)
+      return false;
+    value.assign(m_pos, length);
+    m_pos += length;
+    return true;
+  }
+
+private:
+  const char *&m_pos;
+  const char *m_end;
+};
+
+void WriteNode(CWriter &writer, const TiXmlNode &node)
+{
+  switch (node.Type())
+  {
+    case TiXmlNode::TINYXML_ELEMENT:
+    {
+      const TiXmlElement &element = static_cast<const TiXmlElement&>(node);
+      writer.Write(TAG_ELEMENT);
+      writer.Write(element.Value());
+
+      uint32_t count = 0;
+      for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+        count++;
+      writer.Write(count);
+      for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+      {
+        writer.Write(attribute->Name());
+        writer.Write(attribute->Value());
+      }
+
+      count = 0;
+      for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+        count++;
+      writer.Write(count);
+      for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+        WriteNode(writer, *child);
+      break;
+    }
+    case TiXmlNode::TINYXML_TEXT:
+      writer.Write(static_cast<const TiXmlText&>(node).CDATA() ? TAG_CDATA : TAG_TEXT);
+      writer.Write(node.Value());
+      break;
+    default:
+      // anything else can't occur inside an element, store it as a comment to keep the child count
+      writer.Write(TAG_COMMENT);
+      writer.Write(node.Value());
+      break;
+  }
+}
+
+TiXmlNode* ReadNode(CReader &reader, unsigned int depth)
+{
+  uint8_t tag;
+  std::string value;
+  if (depth > 1000 || !reader.Read(tag) || !reader.Read(value))
+    return nullptr;
+
+  switch (tag)
+  {
+    case TAG_ELEMENT:
+    {
+      std::unique_ptr<TiXmlElement> element(new TiXmlElement(value.c_str()));
+
+      uint32_t count;
+      if (!reader.Read(count))
+        return nullptr;
+      for (uint32_t i = 0; i < count; i++)
+      {
+        std::string name;
+        if (!reader.Read(name) || !reader.Read(value))
+          return nullptr;
+        element->SetAttribute(name.c_str(), value.c_str());
+      }
+
+      if (!reader.Read(count))
+        return nullptr;
+      for (uint32_t i = 0; i < count; i++)
+      {
+        TiXmlNode *child = ReadNode(reader, depth + 1);
+        if (!child)
+          return nullptr;
+        element->LinkEndChild(child);
+      }
+      return element.release();
+    }
+    case TAG_TEXT:
+    case TAG_CDATA:
+    {
+      TiXmlText *text = new TiXmlText(value.c_str());
+      text->SetCDATA(tag == TAG_CDATA);
+      return text;
+    }
+    case TAG_COMMENT:
+      return new TiXmlComment(value.c_str());
+    default:
+      return nullptr;
+  }
+}
+}
+
+struct CGUIXMLCache::Entry
+{
+  Entry() : done(true) {}
+
+  std::string file;
+  std::string cacheFile;
+  std::string skinVersion;
+  CEvent done;
+
+  std::unique_ptr<TiXmlElement> resolved;
+  std::vector<std::pair<std::string, bool>> conditions;
+  std::vector<std::string> includeFiles;
+
+  std::unique_ptr<TiXmlElement> parsed;
+};
+
+namespace
+{
+// signals its entry when done, also if it is cancelled without running
+class CPrefetchJob : public CJob
+{
+public:
+  CPrefetchJob(const std::function<void()> &work, CEvent &done) : m_work(work), m_done(done) {}
+  ~CPrefetchJob() override { m_done.Set(); }
+
+  bool DoWork() override
+  {
+    m_work();
+    return true;
+  }
+
+  const char *GetType() const override { return "guixmlcache"; }
+
+private:
+  std::function<void()> m_work;
+  CEvent &m_done;
+};
+}
+
+CGUIXMLCache::CGUIXMLCache(CGUIIncludes &includes)
+  : m_includes(includes)
+{
+}
+
+CGUIXMLCache::~CGUIXMLCache()
+{
+  Wait();
+}
+
+void CGUIXMLCache::Reset(const std::string &skinId, const std::string &skinVersion)
+{
+  Wait();
+
+  {
+    CSingleLock lock(m_critSection);
+    m_entries.clear();
+    m_skinId = skinId;
+    m_skinVersion = skinVersion;
+    m_cacheFolder = StringUtils::Format("%s%08x/", XMLCACHE_FOLDER, Crc32::ComputeFromLowerCase(skinId));
+  }
+
+  if (g_advancedSettings.m_guiSkinCache)
+    Prune();
+}
+
+void CGUIXMLCache::Prune()
+{
+  // every skin has its own folder, tagged with the version its windows were resolved with
+  const std::string versionFile = m_cacheFolder + "version";
+  XFILE::CFile file;
+  XUTILS::auto_buffer buffer;
+  if (file.LoadFile(versionFile, buffer) > 0 && std::string(buffer.get(), buffer.size()) == m_skinVersion)
+    return;
+  file.Close();
+
+  if (XFILE::CDirectory::Exists(m_cacheFolder))
+  {
+    CLog::Log(LOGDEBUG, "CGUIXMLCache::%s - removing windows of another version of %s", __FUNCTION__, m_skinId.c_str());
+    XFILE::CDirectory::RemoveRecursive(m_cacheFolder);
+  }
+
+  if ((!XFILE::CDirectory::Exists(XMLCACHE_FOLDER) && !XFILE::CDirectory::Create(XMLCACHE_FOLDER)) ||
+      !XFILE::CDirectory::Create(m_cacheFolder))
+    return;
+
+  if (!file.OpenForWrite(versionFile, true) ||
+      file.Write(m_skinVersion.data(), m_skinVersion.size()) != static_cast<ssize_t>(m_skinVersion.size()))
+  {
+    file.Close();
+    XFILE::CFile::Delete(versionFile);
+  }
+}
+
+void CGUIXMLCache::Wait()
+{
+  std::map<std::string, EntryPtr> entries;
+  {
+    CSingleLock lock(m_critSection);
+    entries = m_entries;
+  }
+
+  for (const auto &it : entries)
+    it.second->done.Wait();
+}
+
+std::string CGUIXMLCache::GetCacheFile(const std::string &file) const
+{
+  return StringUtils::Format("%s%08x.bin", m_cacheFolder.c_str(), Crc32::ComputeFromLowerCase(file));
+}
+
+bool CGUIXMLCache::GetStamp(const std::string &file, FileStamp &stamp)
+{
+  struct __stat64 info;
+  if (XFILE::CFile::Stat(file, &info) != 0)
+    return false;
+
+  stamp.file = file;
+  stamp.mtime = info.st_mtime;
+  stamp.size = info.st_size;
+  return true;
+}
+
+void CGUIXMLCache::Prefetch(const std::vector<std::string> &files)
+{
+  if (!g_advancedSettings.m_guiSkinCache)
+    return;
+
+  CSingleLock lock(m_critSection);
+  for (const auto &file : files)
+  {
+    if (m_entries.find(file) != m_entries.end())
+      continue;
+
+    EntryPtr entry = std::make_shared<Entry>();
+    entry->file = file;
+    entry->cacheFile = GetCacheFile(file);
+    entry->skinVersion = m_skinVersion;
+    m_entries.insert(std::make_pair(file, entry));
+
+    CJobManager::GetInstance().AddJob(new CPrefetchJob([entry]() { Load(entry, true); }, entry->done),
+                                      nullptr, CJob::PRIORITY_HIGH);
+  }
+}
+
+void CGUIXMLCache::Load(const EntryPtr &entry, bool parse)
+{
+  // a resolved window from the disk cache, if nothing it depends on changed
+  XFILE::CFile file;
+  XUTILS::auto_buffer buffer;
+  if (file.LoadFile(entry->cacheFile, buffer) > 0)
+  {
+    const char *pos = buffer.get();
+    CReader reader(pos, pos + buffer.size());
+
+    uint32_t magic, version, count;
+    std::string skinVersion;
+    bool valid = reader.Read(magic) && magic == XMLCACHE_MAGIC &&
+                 reader.Read(version) && version == XMLCACHE_VERSION &&
+                 reader.Read(skinVersion) && skinVersion == entry->skinVersion &&
+                 reader.Read(count);
+
+    for (uint32_t i = 0; valid && i < count; i++)
+    {
+      FileStamp stored, current;
+      valid = reader.Read(stored.file) && reader.Read(stored.mtime) && reader.Read(stored.size) &&
+              GetStamp(stored.file, current) && current.mtime == stored.mtime && current.size == stored.size;
+      // the window file comes first, the others are include files
+      if (valid && i > 0)
+        entry->includeFiles.push_back(stored.file);
+      else if (valid && stored.file != entry->file)
+        valid = false;
+    }
+
+    valid = valid && reader.Read(count);
+    for (uint32_t i = 0; valid && i < count; i++)
+    {
+      std::string condition;
+      uint8_t value;
+      valid = reader.Read(condition) && reader.Read(value);
+      if (valid)
+        entry->conditions.push_back(std::make_pair(condition, value != 0));
+    }
+
+    if (valid)
+      entry->resolved = Deserialize(pos, buffer.get() + buffer.size());
+    if (entry->resolved)
+      return;
+
+    entry->includeFiles.clear();
+    entry->conditions.clear();
+  }
+
+  if (!parse)
+    return;
+
+  CXBMCTinyXML xmlDoc;
+  if (xmlDoc.LoadFile(entry->file) && StringUtils::EqualsNoCase(xmlDoc.RootElement()->Value(), "window"))
+    entry->parsed.reset(static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone()));
+}
+
+CGUIXMLCache::EntryPtr CGUIXMLCache::TakeEntry(const std::string &file)
+{
+  EntryPtr entry;
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_entries.find(file);
+    if (it == m_entries.end())
+      return entry;
+    entry = it->second;
+    m_entries.erase(it);
+  }
+
+  entry->done.Wait();
+  return entry;
+}
+
+std::unique_ptr<TiXmlElement> CGUIXMLCache::GetResolved(const std::string &file, std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  if (!g_advancedSettings.m_guiSkinCache)
+    return nullptr;
+
+  EntryPtr entry = TakeEntry(file);
+  if (!entry)
+  {
+    entry = std::make_shared<Entry>();
+    entry->file = file;
+    CSingleLock lock(m_critSection);
+    entry->cacheFile = GetCacheFile(file);
+    entry->skinVersion = m_skinVersion;
+    lock.Leave();
+    Load(entry, false);
+    entry->done.Set();
+  }
+
+  if (!entry->resolved)
+  {
+    // keep the parsed window for GetParsed()
+    if (entry->parsed)
+    {
+      CSingleLock lock(m_critSection);
+      m_entries.insert(std::make_pair(file, entry));
+    }
+    return nullptr;
+  }
+
+  std::map<INFO::InfoPtr, bool> conditions;
+  CGUIInfoManager &infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  for (const auto &condition : entry->conditions)
+  {
+    INFO::InfoPtr info = infoMgr.Register(condition.first);
+    if (!info || info->Get() != condition.second)
+    {
+      CLog::Log(LOGDEBUG, "CGUIXMLCache::%s - include condition %s of %s changed", __FUNCTION__, condition.first.c_str(), file.c_str());
+      return nullptr;
+    }
+    conditions.insert(std::make_pair(info, condition.second));
+  }
+
+  // restore the include files the window pulled in while it was resolved
+  for (const auto &includeFile : entry->includeFiles)
+  {
+    const std::vector<std::string> &loaded = m_includes.GetFiles();
+    if (std::find(loaded.begin(), loaded.end(), includeFile) == loaded.end())
+      m_includes.Load(includeFile);
+  }
+
+  includeConditions.swap(conditions);
+  return std::move(entry->resolved);
+}
+
+std::unique_ptr<TiXmlElement> CGUIXMLCache::GetParsed(const std::string &file)
+{
+  EntryPtr entry = TakeEntry(file);
+  if (!entry)
+    return nullptr;
+  return std::move(entry->parsed);
+}
+
+void CGUIXMLCache::StoreResolved(const std::string &file, const TiXmlElement &window, const std::map<INFO::InfoPtr, bool> &includeConditions)
+{
+  if (!g_advancedSettings.m_guiSkinCache)
+    return;
+
+  std::vector<FileStamp> stamps;
+  FileStamp stamp;
+  if (!GetStamp(file, stamp))
+    return;
+  stamps.push_back(stamp);
+  for (const auto &includeFile : m_includes.GetFiles())
+  {
+    if (!GetStamp(includeFile, stamp))
+      return;
+    stamps.push_back(stamp);
+  }
+
+  std::string buffer;
+  CWriter writer(buffer);
+  writer.Write(XMLCACHE_MAGIC);
+  writer.Write(XMLCACHE_VERSION);
+
+  CSingleLock lock(m_critSection);
+  writer.Write(m_skinVersion);
+  const std::string cacheFile = GetCacheFile(file);
+  const std::string cacheFolder = m_cacheFolder;
+  lock.Leave();
+
+  writer.Write(static_cast<uint32_t>(stamps.size()));
+  for (const auto &it : stamps)
+  {
+    writer.Write(it.file);
+    writer.Write(it.mtime);
+    writer.Write(it.size);
+  }
+
+  writer.Write(static_cast<uint32_t>(includeConditions.size()));
+  for (const auto &it : includeConditions)
+  {
+    writer.Write(it.first->GetExpression());
+    writer.Write(static_cast<uint8_t>(it.second));
+  }
+
+  Serialize(window, buffer);
+
+  // writing is left to a worker, the main thread is busy enough loading the skin
+  CJobManager::GetInstance().Submit([cacheFile, cacheFolder, buffer]() {
+    if (!XFILE::CDirectory::Exists(cacheFolder))
+      return;
+
+    XFILE::CFile file;
+    if (!file.OpenForWrite(cacheFile, true) ||
+        file.Write(buffer.data(), buffer.size()) != static_cast<ssize_t>(buffer.size()))
+    {
+      file.Close();
+      XFILE::CFile::Delete(cacheFile);
+    }
+  });
+}
+
+void CGUIXMLCache::Serialize(const TiXmlElement &element, std::string &buffer)
+{
+  CWriter writer(buffer);
+  WriteNode(writer, element);
+}
+
+std::unique_ptr<TiXmlElement> CGUIXMLCache::Deserialize(const char *&buffer, const char *end)
+{
+  const char *pos = buffer;
+  CReader reader(pos, end);
+
+  std::unique_ptr<TiXmlNode> node(ReadNode(reader, 0));
+  if (!node || node->Type() != TiXmlNode::TINYXML_ELEMENT)
+    return nullptr;
+
+  buffer = pos;
+  return std::unique_ptr<TiXmlElement>(static_cast<TiXmlElement*>(node.release()));
+}
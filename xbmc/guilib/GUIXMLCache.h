@@ -0,0 +1,139 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "interfaces/info/InfoBool.h"
+#include "threads/CriticalSection.h"
+
+class CGUIIncludes;
+class TiXmlElement;
+
+/*!
+ \brief Speeds up loading the window xml files of a skin.
+
+ Window files can be prefetched, i.e. read and parsed on worker threads, while
+ the main thread is busy with other windows.
+
+ Windows with resolved includes, constants and expressions are written to disk
+ in a binary format. They are reused across restarts as long as the window file,
+ the loaded include files and the skin version are unchanged, and all include
+ conditions evaluate to the values they had when the window was resolved.
+ */
+class CGUIXMLCache
+{
+public:
+  explicit CGUIXMLCache(CGUIIncludes &includes);
+  ~CGUIXMLCache();
+
+  /*!
+   \brief Drop all cached state and set up the cache for a skin.
+   Waits for any pending prefetches. Windows stored on disk by another version
+   of the skin are removed.
+
+   \param skinId the id of the skin, used to separate the on disk caches of different skins
+   \param skinVersion the version of the skin, any change invalidates the on disk cache
+   */
+  void Reset(const std::string &skinId, const std::string &skinVersion);
+
+  /*!
+   \brief Start loading the given window files on worker threads.
+
+   \param files paths of the window files, as later passed to GetResolved() and GetParsed()
+   */
+  void Prefetch(const std::vector<std::string> &files);
+
+  /*!
+   \brief Get a resolved window from the cache.
+   Waits for a pending prefetch of the file.
+
+   \param file path of the window file
+   \param includeConditions filled with the conditions of the includes of the window
+   \return the resolved <window> element, nullptr if there is no valid one
+   */
+  std::unique_ptr<TiXmlElement> GetResolved(const std::string &file, std::map<INFO::InfoPtr, bool> &includeConditions);
+
+  /*!
+   \brief Get the parsed, unresolved window from a prefetch of the file.
+   Waits for a pending prefetch of the file.
+
+   \param file path of the window file
+   \return the <window> element, nullptr if the file wasn't prefetched or couldn't be parsed
+   */
+  std::unique_ptr<TiXmlElement> GetParsed(const std::string &file);
+
+  /*!
+   \brief Store a resolved window in the cache.
+
+   \param file path of the window file
+   \param window the resolved <window> element
+   \param includeConditions the conditions of the includes of the window
+   */
+  void StoreResolved(const std::string &file, const TiXmlElement &window, const std::map<INFO::InfoPtr, bool> &includeConditions);
+
+  /*!
+   \brief Write an element and all its children into a binary buffer.
+   */
+  static void Serialize(const TiXmlElement &element, std::string &buffer);
+
+  /*!
+   \brief Rebuild an element written by Serialize().
+
+   \param buffer start of the serialized data, advanced past it on success
+   \param end end of the available data
+   \return the element, nullptr if the data is invalid
+   */
+  static std::unique_ptr<TiXmlElement> Deserialize(const char *&buffer, const char *end);
+
+private:
+  CGUIXMLCache(const CGUIXMLCache&) = delete;
+  CGUIXMLCache& operator=(const CGUIXMLCache&) = delete;
+
+  struct FileStamp
+  {
+    std::string file;
+    int64_t mtime;
+    int64_t size;
+  };
+
+  struct Entry;
+  typedef std::shared_ptr<Entry> EntryPtr;
+
+  std::string GetCacheFile(const std::string &file) const;
+  void Prune();
+  static bool GetStamp(const std::string &file, FileStamp &stamp);
+  static void Load(const EntryPtr &entry, bool parse);
+  EntryPtr TakeEntry(const std::string &file);
+  void Wait();
+
+  CGUIIncludes &m_includes;
+  std::string m_skinId;
+  std::string m_skinVersion;
+  std::string m_cacheFolder;
+
+  CCriticalSection m_critSection;
+  std::map<std::string, EntryPtr> m_entries;
+};
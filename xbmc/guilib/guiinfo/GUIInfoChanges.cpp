@@ -0,0 +1,48 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "guilib/guiinfo/GUIInfoChanges.h"
+
+#include "threads/SingleLock.h"
+
+using namespace KODI::GUILIB::GUIINFO;
+
+void CGUIInfoChanges::Track(int info)
+{
+  CSingleLock lock(m_critSection);
+  m_stamps.emplace(info, 0);
+}
+
+void CGUIInfoChanges::Notify(int info)
+{
+  CSingleLock lock(m_critSection);
+  auto it = m_stamps.find(info);
+  if (it != m_stamps.end())
+    ++it->second;
+}
+
+const std::atomic<unsigned int>* CGUIInfoChanges::GetStamp(int info) const
+{
+  CSingleLock lock(m_critSection);
+  auto it = m_stamps.find(info);
+  if (it != m_stamps.end())
+    return &it->second;
+  return nullptr;
+}
@@ -0,0 +1,76 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <map>
+
+namespace KODI
+{
+namespace GUILIB
+{
+namespace GUIINFO
+{
+
+/*!
+ * @brief Change stamps for infos whose providers announce when their value changes.
+ *
+ * Conditions built only from tracked infos don't need to be evaluated every
+ * frame. They compare the stamps of their infos with the ones seen at their
+ * last update instead.
+ */
+class CGUIInfoChanges
+{
+public:
+  CGUIInfoChanges() = default;
+
+  /*!
+   * @brief Announce that changes of an info will be notified.
+   * @param info The info id.
+   */
+  void Track(int info);
+
+  /*!
+   * @brief Notify that the value of a tracked info may have changed.
+   * @param info The info id.
+   */
+  void Notify(int info);
+
+  /*!
+   * @brief Get the change stamp of an info.
+   * @param info The info id.
+   * @return The stamp, valid for the lifetime of this object, or nullptr if the info is not tracked.
+   */
+  const std::atomic<unsigned int>* GetStamp(int info) const;
+
+private:
+  CGUIInfoChanges(const CGUIInfoChanges&) = delete;
+  CGUIInfoChanges& operator=(const CGUIInfoChanges&) = delete;
+
+  mutable CCriticalSection m_critSection;
+  std::map<int, std::atomic<unsigned int>> m_stamps;
+};
+
+} // namespace GUIINFO
+} // namespace GUILIB
+} // namespace KODI
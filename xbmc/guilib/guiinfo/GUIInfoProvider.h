@@ -21,6 +21,7 @@
 
 #include "cores/VideoPlayer/Interface/StreamInfo.h"
 
+#include "guilib/guiinfo/GUIInfoChanges.h"
 #include "guilib/guiinfo/IGUIInfoProvider.h"
 
 namespace KODI
@@ -41,9 +42,14 @@ public:
   void UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo) override
   { m_audioInfo = audioInfo, m_videoInfo = videoInfo; }
 
+  void TrackChanges(CGUIInfoChanges& changes) override { m_changes = &changes; }
+
 protected:
+  void NotifyChanged(int info) const { if (m_changes) m_changes->Notify(info); }
+
   VideoStreamInfo m_videoInfo;
   AudioStreamInfo m_audioInfo;
+  CGUIInfoChanges* m_changes = nullptr;
 };
 
 } // namespace GUIINFO
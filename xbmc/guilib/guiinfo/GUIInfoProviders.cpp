@@ -66,6 +66,8 @@ void CGUIInfoProviders::RegisterProvider(IGUIInfoProvider *provider, bool bAppen
       m_providers.emplace_back(provider);
     else
       m_providers.insert(m_providers.begin(), provider);
+
+    provider->TrackChanges(m_changes);
   }
 }
 
@@ -25,6 +25,7 @@
 #include "guilib/guiinfo/AddonsGUIInfo.h"
 #include "guilib/guiinfo/GamesGUIInfo.h"
 #include "guilib/guiinfo/GUIControlsGUIInfo.h"
+#include "guilib/guiinfo/GUIInfoChanges.h"
 #include "guilib/guiinfo/LibraryGUIInfo.h"
 #include "guilib/guiinfo/MusicGUIInfo.h"
 #include "guilib/guiinfo/PicturesGUIInfo.h"
@@ -145,8 +146,22 @@ public:
    */
   CLibraryGUIInfo& GetLibraryInfoProvider() { return m_libraryGUIInfo; }
 
+  /*!
+   * @brief Get the skin guiinfo provider.
+   * @return The skin guiinfo provider.
+   */
+  CSkinGUIInfo& GetSkinInfoProvider() { return m_skinGUIInfo; }
+
+  /*!
+   * @brief Get the tracker for infos whose providers announce changes.
+   * @return The change tracker.
+   */
+  CGUIInfoChanges& GetChanges() { return m_changes; }
+  const CGUIInfoChanges& GetChanges() const { return m_changes; }
+
 private:
   std::vector<IGUIInfoProvider *> m_providers;
+  CGUIInfoChanges m_changes;
 
   CAddonsGUIInfo m_addonsGUIInfo;
   CGamesGUIInfo m_gamesGUIInfo;
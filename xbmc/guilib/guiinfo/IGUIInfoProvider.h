@@ -35,6 +35,7 @@ namespace GUIINFO
 {
 
 class CGUIInfo;
+class CGUIInfoChanges;
 
 class IGUIInfoProvider
 {
@@ -85,6 +86,13 @@ public:
    * @param videoInfo New video stream info.
    */
   virtual void UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo) = 0;
+
+  /*!
+   * @brief Connect the provider to the change tracker of the guiinfo manager. Providers announcing
+   * changes of some of their infos register them with the tracker here.
+   * @param changes The change tracker.
+   */
+  virtual void TrackChanges(CGUIInfoChanges& changes) = 0;
 };
 
 } // namespace GUIINFO
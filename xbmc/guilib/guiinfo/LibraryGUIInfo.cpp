@@ -30,6 +30,22 @@
 
 using namespace KODI::GUILIB::GUIINFO;
 
+namespace
+{
+const int TRACKED_INFOS[] =
+{
+  LIBRARY_HAS_MUSIC,
+  LIBRARY_HAS_MOVIES,
+  LIBRARY_HAS_MOVIE_SETS,
+  LIBRARY_HAS_TVSHOWS,
+  LIBRARY_HAS_MUSICVIDEOS,
+  LIBRARY_HAS_SINGLES,
+  LIBRARY_HAS_COMPILATIONS,
+  LIBRARY_HAS_VIDEO,
+  LIBRARY_HAS_ROLE,
+};
+}
+
 CLibraryGUIInfo::CLibraryGUIInfo()
 {
   ResetLibraryBools();
@@ -68,8 +84,12 @@ void CLibraryGUIInfo::SetLibraryBool(int condition, bool value)
       m_libraryHasCompilations = value ? 1 : 0;
       break;
     default:
-      break;
+      return;
   }
+
+  NotifyChanged(condition);
+  if (condition == LIBRARY_HAS_MOVIES || condition == LIBRARY_HAS_TVSHOWS || condition == LIBRARY_HAS_MUSICVIDEOS)
+    NotifyChanged(LIBRARY_HAS_VIDEO);
 }
 
 void CLibraryGUIInfo::ResetLibraryBools()
@@ -82,6 +102,18 @@ void CLibraryGUIInfo::ResetLibraryBools()
   m_libraryHasSingles = -1;
   m_libraryHasCompilations = -1;
   m_libraryRoleCounts.clear();
+
+  for (int info : TRACKED_INFOS)
+    NotifyChanged(info);
+}
+
+void CLibraryGUIInfo::TrackChanges(CGUIInfoChanges& changes)
+{
+  CGUIInfoProvider::TrackChanges(changes);
+
+  // all of these are cached and only change through SetLibraryBool/ResetLibraryBools
+  for (int info : TRACKED_INFOS)
+    changes.Track(info);
 }
 
 bool CLibraryGUIInfo::InitCurrentItem(CFileItem *item)
@@ -117,6 +149,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasMusic < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasMusic > 0;
       return true;
     }
@@ -131,6 +165,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasMovies < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasMovies > 0;
       return true;
     }
@@ -145,6 +181,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasMovieSets < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasMovieSets > 0;
       return true;
     }
@@ -159,6 +197,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasTVShows < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasTVShows > 0;
       return true;
     }
@@ -173,6 +213,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasMusicVideos < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasMusicVideos > 0;
       return true;
     }
@@ -187,6 +229,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasSingles < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasSingles > 0;
       return true;
     }
@@ -201,6 +245,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
         }
       }
+      if (m_libraryHasCompilations < 0)
+        NotifyChanged(info.m_info); // database not available, try again next time
       value = m_libraryHasCompilations > 0;
       return true;
     }
@@ -234,6 +280,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryRoleCounts.emplace_back(std::make_pair(strRole, artistcount));
         }
       }
+      if (artistcount < 0)
+        NotifyChanged(LIBRARY_HAS_ROLE);
       value = artistcount > 0;
       return true;
     }
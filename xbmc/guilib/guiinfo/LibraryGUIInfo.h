@@ -45,6 +45,7 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  void TrackChanges(CGUIInfoChanges& changes) override;
 
   bool GetLibraryBool(int condition) const;
   void SetLibraryBool(int condition, bool value);
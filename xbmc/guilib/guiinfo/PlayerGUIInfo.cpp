@@ -43,6 +43,21 @@
 
 using namespace KODI::GUILIB::GUIINFO;
 
+namespace
+{
+const int TRACKED_INFOS[] =
+{
+  PLAYER_HAS_MEDIA,
+  PLAYER_HAS_AUDIO,
+  PLAYER_HAS_VIDEO,
+  PLAYER_HAS_GAME,
+  PLAYER_PLAYING,
+  PLAYER_PAUSED,
+  PLAYER_REWINDING,
+  PLAYER_FORWARDING,
+};
+}
+
 CPlayerGUIInfo::CPlayerGUIInfo()
 : m_AfterSeekTimeout(0),
   m_seekOffset(0),
@@ -55,6 +70,20 @@ CPlayerGUIInfo::~CPlayerGUIInfo()
 {
 }
 
+void CPlayerGUIInfo::TrackChanges(CGUIInfoChanges& changes)
+{
+  CGUIInfoProvider::TrackChanges(changes);
+
+  for (int info : TRACKED_INFOS)
+    changes.Track(info);
+}
+
+void CPlayerGUIInfo::OnPlayerStateChanged()
+{
+  for (int info : TRACKED_INFOS)
+    NotifyChanged(info);
+}
+
 int CPlayerGUIInfo::GetTotalPlayTime() const
 {
   return std::lrint(g_application.GetTotalTime());
@@ -46,6 +46,12 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  void TrackChanges(CGUIInfoChanges& changes) override;
+
+  /*!
+   * @brief Announce a playback state change (start, stop, pause, speed, stream change).
+   */
+  void OnPlayerStateChanged();
 
   bool GetDisplayAfterSeek() const;
   void SetDisplayAfterSeek(unsigned int timeOut = 2500, int seekOffset = 0);
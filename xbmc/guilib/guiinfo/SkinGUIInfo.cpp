@@ -125,3 +125,18 @@ bool CSkinGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contextWi
 
   return false;
 }
+
+void CSkinGUIInfo::TrackChanges(CGUIInfoChanges& changes)
+{
+  CGUIInfoProvider::TrackChanges(changes);
+
+  // skin settings only change through CSkinInfo, which calls OnSettingsChanged
+  changes.Track(SKIN_BOOL);
+  changes.Track(SKIN_STRING);
+}
+
+void CSkinGUIInfo::OnSettingsChanged()
+{
+  NotifyChanged(SKIN_BOOL);
+  NotifyChanged(SKIN_STRING);
+}
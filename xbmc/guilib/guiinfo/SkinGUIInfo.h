@@ -41,6 +41,12 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  void TrackChanges(CGUIInfoChanges& changes) override;
+
+  /*!
+   * @brief Announce a change of skin bools or strings.
+   */
+  void OnSettingsChanged();
 };
 
 } // namespace GUIINFO
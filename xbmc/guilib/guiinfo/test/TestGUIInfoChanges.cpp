@@ -0,0 +1,137 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "guilib/guiinfo/GUIInfoChanges.h"
+#include "interfaces/info/InfoBool.h"
+
+#include "gtest/gtest.h"
+
+using namespace KODI::GUILIB::GUIINFO;
+
+namespace
+{
+const int INFO_A = 1;
+const int INFO_B = 2;
+const int INFO_UNTRACKED = 3;
+
+class CountingInfoBool : public INFO::InfoBool
+{
+public:
+  CountingInfoBool(const CGUIInfoChanges& changes, std::initializer_list<int> infos, unsigned int& refreshCounter)
+    : InfoBool("test", 0, refreshCounter)
+  {
+    for (int info : infos)
+      TrackInfo(changes.GetStamp(info));
+    FinishTracking();
+  }
+
+  void Update(const CGUIListItem *item) override { ++m_updates; }
+
+  unsigned int m_updates = 0;
+};
+}
+
+TEST(TestGUIInfoChanges, Stamps)
+{
+  CGUIInfoChanges changes;
+  changes.Track(INFO_A);
+
+  EXPECT_EQ(nullptr, changes.GetStamp(INFO_UNTRACKED));
+  const std::atomic<unsigned int>* stamp = changes.GetStamp(INFO_A);
+  ASSERT_NE(nullptr, stamp);
+
+  unsigned int value = stamp->load();
+  changes.Notify(INFO_A);
+  EXPECT_NE(value, stamp->load());
+
+  // notifying an untracked info is harmless
+  value = stamp->load();
+  changes.Notify(INFO_UNTRACKED);
+  EXPECT_EQ(value, stamp->load());
+
+  // stamps are stable when tracking more infos
+  changes.Track(INFO_B);
+  EXPECT_EQ(stamp, changes.GetStamp(INFO_A));
+}
+
+TEST(TestGUIInfoChanges, TrackedInfoBool)
+{
+  CGUIInfoChanges changes;
+  changes.Track(INFO_A);
+  changes.Track(INFO_B);
+  unsigned int refreshCounter = 1;
+
+  CountingInfoBool info(changes, { INFO_A, INFO_B }, refreshCounter);
+  EXPECT_TRUE(info.IsTracked());
+  EXPECT_FALSE(info.IsConstant());
+
+  // the first evaluation always updates
+  info.Get();
+  EXPECT_EQ(1u, info.m_updates);
+
+  // no change, no update
+  refreshCounter++;
+  info.Get();
+  EXPECT_EQ(1u, info.m_updates);
+
+  changes.Notify(INFO_B);
+  info.Get();
+  EXPECT_EQ(1u, info.m_updates); // same frame
+  refreshCounter++;
+  info.Get();
+  EXPECT_EQ(2u, info.m_updates);
+
+  refreshCounter++;
+  info.Get();
+  EXPECT_EQ(2u, info.m_updates);
+}
+
+TEST(TestGUIInfoChanges, UntrackedInfoBool)
+{
+  CGUIInfoChanges changes;
+  changes.Track(INFO_A);
+  unsigned int refreshCounter = 1;
+
+  CountingInfoBool info(changes, { INFO_A, INFO_UNTRACKED }, refreshCounter);
+  EXPECT_FALSE(info.IsTracked());
+
+  for (unsigned int i = 1; i <= 3; i++)
+  {
+    info.Get();
+    EXPECT_EQ(i, info.m_updates);
+    refreshCounter++;
+  }
+}
+
+TEST(TestGUIInfoChanges, ConstantInfoBool)
+{
+  CGUIInfoChanges changes;
+  unsigned int refreshCounter = 1;
+
+  CountingInfoBool info(changes, {}, refreshCounter);
+  EXPECT_TRUE(info.IsConstant());
+
+  for (unsigned int i = 0; i < 3; i++)
+  {
+    info.Get();
+    refreshCounter++;
+  }
+  EXPECT_EQ(1u, info.m_updates);
+}
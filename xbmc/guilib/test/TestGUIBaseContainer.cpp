@@ -0,0 +1,197 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "guilib/GUIListContainer.h"
+#include "guilib/GUIListItemLayout.h"
+#include "rendering/RenderSystem.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+#include "windowing/WinSystem.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+const int ITEMS = 5;
+
+// the graphics context projects dirty regions through the render system
+class CTestRenderSystem : public CRenderSystemBase
+{
+public:
+  bool InitRenderSystem() override { return true; }
+  bool DestroyRenderSystem() override { return true; }
+  bool ResetRenderSystem(int width, int height) override { return true; }
+  bool BeginRender() override { return true; }
+  bool EndRender() override { return true; }
+  void PresentRender(bool rendered, bool videoLayer) override {}
+  bool ClearBuffers(UTILS::Color color) override { return true; }
+  bool IsExtSupported(const char* extension) const override { return false; }
+  void SetViewPort(const CRect& viewPort) override {}
+  void GetViewPort(CRect& viewPort) override {}
+  void SetScissors(const CRect &rect) override {}
+  void ResetScissors() override {}
+  void CaptureStateBlock() override {}
+  void ApplyStateBlock() override {}
+  void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor) override {}
+  void ApplyHardwareTransform(const TransformMatrix &matrix) override {}
+  void RestoreHardwareTransform() override {}
+  bool TestRender() override { return true; }
+};
+
+// containers only need the graphics context and render system of the window system
+class CTestWinSystem : public CWinSystemBase
+{
+public:
+  bool CreateNewWindow(const std::string& name, bool fullScreen, RESOLUTION_INFO& res) override { return false; }
+  bool ResizeWindow(int newWidth, int newHeight, int newLeft, int newTop) override { return false; }
+  bool SetFullScreen(bool fullScreen, RESOLUTION_INFO& res, bool blankOtherDisplays) override { return false; }
+  void Register(IDispResource *resource) override {}
+  void Unregister(IDispResource *resource) override {}
+  CRenderSystemBase *GetRenderSystem() override { return &m_renderSystem; }
+
+private:
+  CTestRenderSystem m_renderSystem;
+};
+
+// a vertical list of items with empty layouts that records which layouts it processes
+class CTestContainer : public CGUIListContainer
+{
+public:
+  CTestContainer() : CGUIListContainer(0, 50, 0, 0, 100, 100, VERTICAL, CScroller(0), 0)
+  {
+    m_layouts.emplace_back();
+    m_layouts.back().SetWidth(100);
+    m_layouts.back().SetHeight(10);
+    m_focusedLayouts.emplace_back();
+    m_focusedLayouts.back().SetWidth(100);
+    m_focusedLayouts.back().SetHeight(10);
+    for (int i = 0; i < ITEMS; i++)
+      m_items.push_back(CGUIListItemPtr(new CFileItem(StringUtils::Format("item %i", i))));
+    UpdateLayout(true);
+    SetFocus(true);
+  }
+
+  // processes a frame with the given item focused. all items fit on one page, the cursor
+  // is moved directly as the info manager that tracks moving containers isn't around
+  void Frame(int item)
+  {
+    CGUIBaseContainer::SetCursor(item);
+    m_processed.clear();
+    CDirtyRegionList dirtyregions;
+    m_time += 20;
+    DoProcess(m_time, dirtyregions);
+  }
+
+  bool ProcessedFocused(int item) const
+  {
+    const CGUIListItem *listItem = m_items[item].get();
+    for (const auto &it : m_processed)
+    {
+      if (it.first == listItem && it.second)
+        return true;
+    }
+    return false;
+  }
+
+  int ProcessedFocusedCount() const
+  {
+    int count = 0;
+    for (const auto &it : m_processed)
+      count += it.second ? 1 : 0;
+    return count;
+  }
+
+protected:
+  void ProcessLayout(CGUIListItemLayout *layout, CGUIListItem *item, unsigned int currentTime, CDirtyRegionList &dirtyregions) override
+  {
+    m_processed.push_back(std::make_pair(item, layout == item->GetFocusedLayout()));
+    CGUIListContainer::ProcessLayout(layout, item, currentTime, dirtyregions);
+  }
+
+private:
+  std::vector<std::pair<const CGUIListItem*, bool>> m_processed;
+  unsigned int m_time = 0;
+};
+}
+
+class TestGUIBaseContainer : public ::testing::Test
+{
+protected:
+  TestGUIBaseContainer()
+  {
+    m_skipHiddenLayouts = g_advancedSettings.m_guiSkipHiddenLayouts;
+    CServiceBroker::RegisterWinSystem(&m_winSystem);
+  }
+
+  ~TestGUIBaseContainer() override
+  {
+    CServiceBroker::UnregisterWinSystem();
+    g_advancedSettings.m_guiSkipHiddenLayouts = m_skipHiddenLayouts;
+  }
+
+  CTestWinSystem m_winSystem;
+  bool m_skipHiddenLayouts;
+};
+
+TEST_F(TestGUIBaseContainer, SkipsHiddenFocusedLayoutsByDefault)
+{
+  EXPECT_TRUE(g_advancedSettings.m_guiSkipHiddenLayouts);
+  CTestContainer container;
+
+  for (int i = 0; i < ITEMS; i++)
+    container.Frame(i);
+
+  // only the layout that is shown is processed
+  EXPECT_EQ(1, container.ProcessedFocusedCount());
+  EXPECT_TRUE(container.ProcessedFocused(ITEMS - 1));
+}
+
+TEST_F(TestGUIBaseContainer, ProcessesHiddenFocusedLayouts)
+{
+  g_advancedSettings.m_guiSkipHiddenLayouts = false;
+  CTestContainer container;
+
+  for (int i = 0; i < ITEMS; i++)
+    container.Frame(i);
+
+  // every item keeps its focused layout once it had focus, all of them are processed
+  EXPECT_EQ(ITEMS, container.ProcessedFocusedCount());
+}
+
+TEST_F(TestGUIBaseContainer, Refocus)
+{
+  g_advancedSettings.m_guiSkipHiddenLayouts = true;
+  CTestContainer container;
+
+  container.Frame(0);
+  EXPECT_TRUE(container.ProcessedFocused(0));
+
+  container.Frame(1);
+  EXPECT_FALSE(container.ProcessedFocused(0));
+  EXPECT_TRUE(container.ProcessedFocused(1));
+
+  // the layout picks up again as soon as its item is focused
+  container.Frame(0);
+  EXPECT_TRUE(container.ProcessedFocused(0));
+  EXPECT_FALSE(container.ProcessedFocused(1));
+}
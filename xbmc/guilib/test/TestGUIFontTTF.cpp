@@ -0,0 +1,203 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ServiceBroker.h"
+#include "guilib/GUIFontTTF.h"
+#include "guilib/Texture.h"
+#include "rendering/RenderSystem.h"
+#include "test/TestUtils.h"
+#include "threads/SingleLock.h"
+#include "windowing/WinSystem.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+const std::string TEXT = "Kodi";
+
+// fonts and their textures only need the limits of the render system
+class CTestRenderSystem : public CRenderSystemBase
+{
+public:
+  bool InitRenderSystem() override { return true; }
+  bool DestroyRenderSystem() override { return true; }
+  bool ResetRenderSystem(int width, int height) override { return true; }
+  bool BeginRender() override { return true; }
+  bool EndRender() override { return true; }
+  void PresentRender(bool rendered, bool videoLayer) override {}
+  bool ClearBuffers(UTILS::Color color) override { return true; }
+  bool IsExtSupported(const char* extension) const override { return false; }
+  void SetViewPort(const CRect& viewPort) override {}
+  void GetViewPort(CRect& viewPort) override {}
+  void SetScissors(const CRect &rect) override {}
+  void ResetScissors() override {}
+  void CaptureStateBlock() override {}
+  void ApplyStateBlock() override {}
+  void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor) override {}
+  void ApplyHardwareTransform(const TransformMatrix &matrix) override {}
+  void RestoreHardwareTransform() override {}
+  bool TestRender() override { return true; }
+};
+
+class CTestWinSystem : public CWinSystemBase
+{
+public:
+  bool CreateNewWindow(const std::string& name, bool fullScreen, RESOLUTION_INFO& res) override { return false; }
+  bool ResizeWindow(int newWidth, int newHeight, int newLeft, int newTop) override { return false; }
+  bool SetFullScreen(bool fullScreen, RESOLUTION_INFO& res, bool blankOtherDisplays) override { return false; }
+  void Register(IDispResource *resource) override {}
+  void Unregister(IDispResource *resource) override {}
+  CRenderSystemBase *GetRenderSystem() override { return &m_renderSystem; }
+
+private:
+  CTestRenderSystem m_renderSystem;
+};
+
+// a font that keeps the bitmap of the last character copied to its texture
+class CTestFont : public CGUIFontTTFBase
+{
+public:
+  CTestFont() : CGUIFontTTFBase("test") {}
+
+  bool Cache(wchar_t letter, float &advance, std::vector<unsigned char> &bitmap)
+  {
+    Character ch;
+    m_bitmap.clear();
+    if (!CacheCharacter(letter, 0, &ch))
+      return false;
+    advance = ch.advance;
+    bitmap = m_bitmap;
+    return true;
+  }
+
+protected:
+  CBaseTexture* ReallocTexture(unsigned int& newHeight) override
+  {
+    delete m_texture;
+    m_textureHeight = newHeight;
+    return new CTexture(m_textureWidth, newHeight, XB_FMT_A8);
+  }
+
+  bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override
+  {
+    const FT_Bitmap &bitmap = bitGlyph->bitmap;
+    for (unsigned int y = 0; y < bitmap.rows; y++)
+    {
+      const unsigned char *row = bitmap.buffer + y * bitmap.pitch;
+      m_bitmap.insert(m_bitmap.end(), row, row + bitmap.width);
+    }
+    return true;
+  }
+
+  void DeleteHardwareTexture() override {}
+
+private:
+  bool FirstBegin() override { return false; }
+  void LastEnd() override {}
+
+  std::vector<unsigned char> m_bitmap;
+};
+}
+
+class TestGUIFontTTF : public testing::Test
+{
+protected:
+  TestGUIFontTTF()
+  {
+    CServiceBroker::RegisterWinSystem(&m_winSystem);
+  }
+
+  ~TestGUIFontTTF() override
+  {
+    CServiceBroker::UnregisterWinSystem();
+  }
+
+  static bool WaitForPrewarm(CGUIFontTTFBase &font)
+  {
+    CSingleLock lock(font.m_prewarmSection);
+    while (font.m_prewarmJobs > 0)
+    {
+      lock.Leave();
+      if (!font.m_prewarmJobDone.WaitMSec(5000))
+        return false;
+      lock.Enter();
+    }
+    return true;
+  }
+
+  static size_t GetPrewarmedCount(CGUIFontTTFBase &font)
+  {
+    CSingleLock lock(font.m_prewarmSection);
+    return font.m_prewarmed.size();
+  }
+
+  static size_t GetPrewarmBytes(CGUIFontTTFBase &font)
+  {
+    CSingleLock lock(font.m_prewarmSection);
+    return font.m_prewarmBytes;
+  }
+
+  static bool HasPrewarmFace(CGUIFontTTFBase &font)
+  {
+    CSingleLock lock(font.m_prewarmSection);
+    return font.m_prewarmFace != nullptr;
+  }
+
+  CTestWinSystem m_winSystem;
+};
+
+TEST_F(TestGUIFontTTF, PrewarmedGlyphsMatchRasterizedOnes)
+{
+  const std::string path = XBMC_REF_FILE_PATH("media/Fonts/teletext.ttf");
+  CTestFont prewarmed;
+  CTestFont rasterized;
+  ASSERT_TRUE(prewarmed.Load(path, 20.0f));
+  ASSERT_TRUE(rasterized.Load(path, 20.0f));
+
+  vecText text(TEXT.begin(), TEXT.end());
+  prewarmed.Prewarm(text);
+  ASSERT_TRUE(WaitForPrewarm(prewarmed));
+  EXPECT_EQ(TEXT.size(), GetPrewarmedCount(prewarmed));
+  EXPECT_LT(0u, GetPrewarmBytes(prewarmed));
+
+  for (char letter : TEXT)
+  {
+    float advance = 0;
+    float rasterizedAdvance = 0;
+    std::vector<unsigned char> bitmap;
+    std::vector<unsigned char> rasterizedBitmap;
+    ASSERT_TRUE(prewarmed.Cache(letter, advance, bitmap));
+    ASSERT_TRUE(rasterized.Cache(letter, rasterizedAdvance, rasterizedBitmap));
+    EXPECT_EQ(rasterizedAdvance, advance) << letter;
+    EXPECT_FALSE(bitmap.empty()) << letter;
+    EXPECT_EQ(rasterizedBitmap, bitmap) << letter;
+  }
+
+  // all glyphs are in the texture now, their memory is freed and so is the worker's face
+  EXPECT_EQ(0u, GetPrewarmedCount(prewarmed));
+  EXPECT_EQ(0u, GetPrewarmBytes(prewarmed));
+  EXPECT_FALSE(HasPrewarmFace(prewarmed));
+}
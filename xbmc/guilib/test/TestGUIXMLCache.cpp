@@ -0,0 +1,120 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIIncludes.h"
+#include "guilib/GUIXMLCache.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+const std::string WINDOW_XML =
+  "<window id=\"1100\" type=\"dialog\">"
+  "<!-- comment -->"
+  "<controls>"
+  "<control type=\"label\" id=\"2\"><label>$INFO[Player.Title]</label></control>"
+  "<control type=\"button\"><onclick><![CDATA[Action(Back)]]></onclick></control>"
+  "</controls>"
+  "</window>";
+}
+
+TEST(TestGUIXMLCache, RoundTrip)
+{
+  CXBMCTinyXML doc;
+  doc.Parse(WINDOW_XML);
+  const TiXmlElement *root = doc.RootElement();
+  ASSERT_NE(nullptr, root);
+
+  std::string buffer;
+  CGUIXMLCache::Serialize(*root, buffer);
+
+  const char *pos = buffer.data();
+  std::unique_ptr<TiXmlElement> window = CGUIXMLCache::Deserialize(pos, buffer.data() + buffer.size());
+  ASSERT_NE(nullptr, window.get());
+  EXPECT_EQ(buffer.data() + buffer.size(), pos);
+
+  EXPECT_EQ("window", window->ValueStr());
+  EXPECT_STREQ("1100", window->Attribute("id"));
+  EXPECT_STREQ("dialog", window->Attribute("type"));
+
+  const TiXmlElement *control = window->FirstChildElement("controls")->FirstChildElement("control");
+  ASSERT_NE(nullptr, control);
+  EXPECT_STREQ("label", control->Attribute("type"));
+  EXPECT_EQ("$INFO[Player.Title]", control->FirstChildElement("label")->FirstChild()->ValueStr());
+
+  const TiXmlText *onclick = control->NextSiblingElement("control")->FirstChildElement("onclick")->FirstChild()->ToText();
+  ASSERT_NE(nullptr, onclick);
+  EXPECT_TRUE(onclick->CDATA());
+  EXPECT_EQ("Action(Back)", onclick->ValueStr());
+
+  std::string again;
+  CGUIXMLCache::Serialize(*window, again);
+  EXPECT_EQ(buffer, again);
+}
+
+TEST(TestGUIXMLCache, TruncatedData)
+{
+  CXBMCTinyXML doc;
+  doc.Parse(WINDOW_XML);
+  ASSERT_NE(nullptr, doc.RootElement());
+
+  std::string buffer;
+  CGUIXMLCache::Serialize(*doc.RootElement(), buffer);
+
+  for (size_t length = 0; length < buffer.size(); length++)
+  {
+    const char *pos = buffer.data();
+    EXPECT_EQ(nullptr, CGUIXMLCache::Deserialize(pos, buffer.data() + length).get());
+  }
+}
+
+TEST(TestGUIXMLCache, PruneOnVersionChange)
+{
+  const bool skinCache = g_advancedSettings.m_guiSkinCache;
+  g_advancedSettings.m_guiSkinCache = true;
+
+  CGUIIncludes includes;
+  CGUIXMLCache cache(includes);
+  cache.Reset("skin.test", "1.0.0");
+
+  // the skin's folder is the only one in the cache
+  CFileItemList folders;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory("special://temp/skincache/", folders, "/", XFILE::DIR_FLAG_BYPASS_CACHE));
+  ASSERT_EQ(1, folders.Size());
+  const std::string window = URIUtils::AddFileToFolder(folders[0]->GetPath(), "window.bin");
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(window, true));
+  file.Close();
+
+  cache.Reset("skin.test", "1.0.0");
+  EXPECT_TRUE(XFILE::CFile::Exists(window));
+
+  cache.Reset("skin.test", "1.0.1");
+  EXPECT_FALSE(XFILE::CFile::Exists(window));
+
+  XFILE::CDirectory::RemoveRecursive("special://temp/skincache/");
+  g_advancedSettings.m_guiSkinCache = skinCache;
+}
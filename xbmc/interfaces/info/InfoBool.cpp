@@ -29,8 +29,65 @@ namespace INFO
       m_listItemDependent(false),
       m_expression(expression),
       m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_parentRefreshCounter(refreshCounter),
+      m_tracked(false),
+      m_untracked(false),
+      m_changed(true)
   {
     StringUtils::ToLower(m_expression);
   }
+
+  void InfoBool::TrackInfo(const std::atomic<unsigned int> *stamp)
+  {
+    if (!stamp)
+    {
+      m_untracked = true;
+      return;
+    }
+
+    for (const auto &dependency : m_dependencies)
+    {
+      if (dependency.first == stamp)
+        return;
+    }
+    m_dependencies.emplace_back(stamp, stamp->load());
+  }
+
+  void InfoBool::TrackInfo(const InfoBool &info)
+  {
+    if (!info.m_tracked)
+    {
+      m_untracked = true;
+      return;
+    }
+
+    for (const auto &dependency : info.m_dependencies)
+      TrackInfo(dependency.first);
+  }
+
+  void InfoBool::FinishTracking()
+  {
+    m_tracked = !m_untracked && !m_listItemDependent;
+    if (!m_tracked)
+      m_dependencies.clear();
+    m_changed = true;
+  }
+
+  bool InfoBool::HasChanged()
+  {
+    // stamps are taken before the update, so a change during the update
+    // triggers another one next time
+    bool changed = m_changed;
+    m_changed = false;
+    for (auto &dependency : m_dependencies)
+    {
+      const unsigned int stamp = dependency.first->load();
+      if (stamp != dependency.second)
+      {
+        dependency.second = stamp;
+        changed = true;
+      }
+    }
+    return changed;
+  }
 }
@@ -20,8 +20,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class CGUIListItem;
 
@@ -49,7 +52,8 @@ public:
       Update(item);
     else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
     {
-      Update(NULL);
+      if (!m_tracked || HasChanged())
+        Update(NULL);
       m_refreshCounter = m_parentRefreshCounter;
     }
     return m_value;
@@ -78,7 +82,33 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+
+  /*! \brief Whether this info bool is only updated when one of the infos it depends on changed
+   \sa TrackInfo
+   */
+  bool IsTracked() const { return m_tracked; }
+
+  /*! \brief Whether the value of this info bool never changes
+   A tracked info bool without any infos to depend on, like "true".
+   */
+  bool IsConstant() const { return m_tracked && m_dependencies.empty(); }
 protected:
+  /*! \brief Add an info this bool depends on
+   Only if all infos of a bool are tracked, it skips updates while their change
+   stamps stay the same. A bool which adds no infos at all is constant.
+   Must be followed by a call to FinishTracking().
+   \param stamp change stamp of the info, nullptr if the info is not tracked
+   */
+  void TrackInfo(const std::atomic<unsigned int> *stamp);
+
+  /*! \brief Add all infos another bool depends on
+   \sa TrackInfo
+   */
+  void TrackInfo(const InfoBool &info);
+
+  /*! \brief Enable tracking if all infos added with TrackInfo() are tracked
+   */
+  void FinishTracking();
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
@@ -86,8 +116,17 @@ protected:
   std::string  m_expression;   ///< original expression
 
 private:
+  /*! \brief Check for changed infos and remember their current stamps
+   */
+  bool HasChanged();
+
   unsigned int m_refreshCounter;
   unsigned int &m_parentRefreshCounter;
+
+  bool m_tracked;              ///< only update when a dependency changed
+  bool m_untracked;            ///< depends on an info without change notifications
+  bool m_changed;              ///< not updated since tracking was enabled
+  std::vector<std::pair<const std::atomic<unsigned int>*, unsigned int>> m_dependencies;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -23,6 +23,7 @@
 #include "utils/log.h"
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/guiinfo/GUIInfoLabels.h"
 #include "ServiceBroker.h"
 #include <list>
 #include <memory>
@@ -31,7 +32,12 @@ using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  // true and false don't depend on anything
+  if (m_condition != SYSTEM_ALWAYS_TRUE && m_condition != SYSTEM_ALWAYS_FALSE)
+    TrackInfo(infoMgr.GetChangeStamp(m_condition));
+  FinishTracking();
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -41,41 +47,68 @@ void InfoSingle::Update(const CGUIListItem *item)
 
 void InfoExpression::Initialize()
 {
-  if (!Parse(m_expression))
+  InfoSubexpressionPtr tree;
+  if (Parse(m_expression, tree))
+    Compile(tree);
+  else
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_program.push_back({ OP_CONSTANT, false });
   }
+  FinishTracking();
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  bool value = false;
+  const size_t size = m_program.size();
+  size_t pc = 0;
+  while (pc < size)
+  {
+    const Instruction &instruction = m_program[pc++];
+    switch (instruction.opcode)
+    {
+      case OP_CONSTANT:
+        value = instruction.argument != 0;
+        break;
+      case OP_LEAF:
+        value = m_leaves[instruction.argument]->Get(item);
+        break;
+      case OP_LEAF_INVERT:
+        value = !m_leaves[instruction.argument]->Get(item);
+        break;
+      case OP_JUMP_IF_TRUE:
+        if (value)
+          pc = instruction.argument;
+        break;
+      case OP_JUMP_IF_FALSE:
+        if (!value)
+          pc = instruction.argument;
+        break;
+    }
+  }
+  m_value = value;
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
- * true nodes for OR subexpressions, or false nodes for AND subexpressions).
- * The end effect is to minimise the number of leaf nodes that need to be
- * evaluated in order to determine the value of the expression. The runtime
- * adaptability has the advantage of not being customised for any particular skin.
- *
- * The modifications to the expression at parse time fall into two groups:
+ * formation of groups of associative nodes:
  * 1) Moving logical NOTs so that they are only applied to leaf nodes.
- *    For example, rewriting ![A+B]|C as !A|!B|C allows reordering such that
- *    any of the three leaves can be evaluated first.
+ *    For example, rewriting ![A+B]|C as !A|!B|C.
  * 2) Combining adjacent AND or OR operations such that each path from the root
  *    to a leaf encounters a strictly alternating pattern of AND and OR
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
+ *
+ * The tree is then simplified and compiled into a flat program:
+ * 1) Constant leaves (true/false) are folded away, as are duplicate leaves of
+ *    a group. A group containing both A and !A is folded into a constant.
+ * 2) Nested groups are registered with the info manager as expressions of
+ *    their own, so that a subexpression used by several conditions of the
+ *    skin is evaluated only once per frame. Groups depending on the listitem
+ *    gain nothing from that and are compiled inline.
+ * 3) Each group is emitted as its children separated by conditional jumps to
+ *    the end of the group, so evaluation stops as soon as its value is known.
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
-{
-  return m_invert ^ m_info->Get(item);
-}
-
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
     node_type_t type,
     const InfoSubexpressionPtr &left,
@@ -96,29 +129,6 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
-{
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
-  {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
-    {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
-    }
-  }
-  return use_and ^ result;
-}
-
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
  * (AND/OR) are treated as right-associative so that we don't need to make a
  * special case for the unary NOT operator. This has no effect upon the answers
@@ -207,7 +217,7 @@ void InfoExpression::OperatorPop(std::stack<operator_t> &operator_stack, bool &i
   }
 }
 
-bool InfoExpression::Parse(const std::string &expression)
+bool InfoExpression::Parse(const std::string &expression, InfoSubexpressionPtr &tree)
 {
   const char *s = expression.c_str();
   std::string operand;
@@ -252,8 +262,6 @@ bool InfoExpression::Parse(const std::string &expression)
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
           return false;
         }
-        /* Propagate any listItem dependency from the operand to the expression */
-        m_listItemDependent |= info->ListItemDependent();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -303,13 +311,195 @@ bool InfoExpression::Parse(const std::string &expression)
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
       return false;
     }
-    /* Propagate any listItem dependency from the operand to the expression */
-    m_listItemDependent |= info->ListItemDependent();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  tree = nodes.top();
   return true;
 }
+
+InfoExpression::InfoSubexpressionPtr InfoExpression::Fold(const InfoSubexpressionPtr &node, bool &constant)
+{
+  if (node->Type() == NODE_LEAF)
+  {
+    std::shared_ptr<InfoLeaf> leaf = std::static_pointer_cast<InfoLeaf>(node);
+    if (leaf->m_info->IsConstant())
+    {
+      constant = leaf->m_invert ^ leaf->m_info->Get();
+      return InfoSubexpressionPtr();
+    }
+    return node;
+  }
+
+  std::shared_ptr<InfoAssociativeGroup> group = std::static_pointer_cast<InfoAssociativeGroup>(node);
+  // the value which decides the whole group: true for OR, false for AND
+  const bool decisive = (group->m_type == NODE_OR);
+
+  std::list<InfoSubexpressionPtr> children;
+  for (const auto &child : group->m_children)
+  {
+    bool value;
+    InfoSubexpressionPtr folded = Fold(child, value);
+    if (!folded)
+    {
+      if (value == decisive)
+      {
+        constant = decisive;
+        return InfoSubexpressionPtr();
+      }
+      continue;
+    }
+
+    bool decided = false;
+    if (folded->Type() == group->m_type)
+    {
+      // a nested group reduced to a single group of our own type
+      for (const auto &grandchild : std::static_pointer_cast<InfoAssociativeGroup>(folded)->m_children)
+        decided |= AddFolded(children, grandchild);
+    }
+    else
+      decided = AddFolded(children, folded);
+
+    if (decided)
+    {
+      constant = decisive;
+      return InfoSubexpressionPtr();
+    }
+  }
+
+  if (children.empty())
+  {
+    constant = !decisive;
+    return InfoSubexpressionPtr();
+  }
+  if (children.size() == 1)
+    return children.front();
+
+  group->m_children.swap(children);
+  return group;
+}
+
+bool InfoExpression::AddFolded(std::list<InfoSubexpressionPtr> &children, const InfoSubexpressionPtr &child)
+{
+  if (child->Type() == NODE_LEAF)
+  {
+    std::shared_ptr<InfoLeaf> leaf = std::static_pointer_cast<InfoLeaf>(child);
+    for (const auto &sibling : children)
+    {
+      if (sibling->Type() != NODE_LEAF)
+        continue;
+      std::shared_ptr<InfoLeaf> other = std::static_pointer_cast<InfoLeaf>(sibling);
+      if (other->m_info == leaf->m_info)
+        return other->m_invert != leaf->m_invert; // A|!A or A+!A decides the group, A|A is just A
+    }
+  }
+  children.push_back(child);
+  return false;
+}
+
+bool InfoExpression::IsListItemDependent(const InfoSubexpressionPtr &node)
+{
+  if (node->Type() == NODE_LEAF)
+    return std::static_pointer_cast<InfoLeaf>(node)->m_info->ListItemDependent();
+
+  for (const auto &child : std::static_pointer_cast<InfoAssociativeGroup>(node)->m_children)
+  {
+    if (IsListItemDependent(child))
+      return true;
+  }
+  return false;
+}
+
+std::string InfoExpression::Describe(const InfoSubexpressionPtr &node)
+{
+  if (node->Type() == NODE_LEAF)
+  {
+    std::shared_ptr<InfoLeaf> leaf = std::static_pointer_cast<InfoLeaf>(node);
+    return leaf->m_invert ? "!" + leaf->m_info->GetExpression() : leaf->m_info->GetExpression();
+  }
+
+  std::shared_ptr<InfoAssociativeGroup> group = std::static_pointer_cast<InfoAssociativeGroup>(node);
+  std::string description;
+  for (const auto &child : group->m_children)
+  {
+    if (!description.empty())
+      description += group->m_type == NODE_AND ? '+' : '|';
+    if (child->Type() == NODE_LEAF)
+      description += Describe(child);
+    else
+      description += "[" + Describe(child) + "]";
+  }
+  return description;
+}
+
+void InfoExpression::Compile(const InfoSubexpressionPtr &tree)
+{
+  bool constant = false;
+  InfoSubexpressionPtr folded = Fold(tree, constant);
+  if (folded)
+    Emit(folded, true);
+  else
+    m_program.push_back({ OP_CONSTANT, constant });
+
+  /* Propagate any listItem dependency from the remaining operands to the expression */
+  m_listItemDependent = false;
+  for (const auto &leaf : m_leaves)
+  {
+    m_listItemDependent |= leaf->ListItemDependent();
+    TrackInfo(*leaf);
+  }
+}
+
+void InfoExpression::Emit(const InfoSubexpressionPtr &node, bool root)
+{
+  if (node->Type() == NODE_LEAF)
+  {
+    std::shared_ptr<InfoLeaf> leaf = std::static_pointer_cast<InfoLeaf>(node);
+    m_program.push_back({ leaf->m_invert ? OP_LEAF_INVERT : OP_LEAF, AddLeaf(leaf->m_info) });
+    return;
+  }
+
+  if (!root && !IsListItemDependent(node))
+  {
+    InfoPtr info = CServiceBroker::GetGUI()->GetInfoManager().Register(Describe(node), m_context);
+    if (info)
+    {
+      m_program.push_back({ OP_LEAF, AddLeaf(info) });
+      return;
+    }
+  }
+
+  std::shared_ptr<InfoAssociativeGroup> group = std::static_pointer_cast<InfoAssociativeGroup>(node);
+  const opcode_t jump = group->m_type == NODE_OR ? OP_JUMP_IF_TRUE : OP_JUMP_IF_FALSE;
+  std::vector<size_t> jumps;
+  bool first = true;
+  for (const auto &child : group->m_children)
+  {
+    if (!first)
+    {
+      // stop as soon as the previous child decided the group
+      jumps.push_back(m_program.size());
+      m_program.push_back({ jump, 0 });
+    }
+    Emit(child, false);
+    first = false;
+  }
+
+  const unsigned int end = m_program.size();
+  for (size_t index : jumps)
+    m_program[index].argument = end;
+}
+
+unsigned int InfoExpression::AddLeaf(const InfoPtr &info)
+{
+  for (size_t i = 0; i < m_leaves.size(); i++)
+  {
+    if (m_leaves[i] == info)
+      return i;
+  }
+  m_leaves.push_back(info);
+  return m_leaves.size() - 1;
+}
+
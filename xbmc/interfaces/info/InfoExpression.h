@@ -44,6 +44,9 @@ private:
 };
 
 /*! \brief Class to wrap active boolean expressions
+
+ The expression is parsed into a tree, simplified and compiled into a flat
+ program which is run whenever the value needs updating.
  */
 class InfoExpression : public InfoBool
 {
@@ -73,12 +76,26 @@ private:
     NODE_OR,
   } node_type_t;
 
-  // An abstract base class for nodes in the expression tree
+  typedef enum
+  {
+    OP_CONSTANT,      // value = argument
+    OP_LEAF,          // value = leaf[argument]
+    OP_LEAF_INVERT,   // value = !leaf[argument]
+    OP_JUMP_IF_TRUE,  // continue at argument if value is true
+    OP_JUMP_IF_FALSE, // continue at argument if value is false
+  } opcode_t;
+
+  struct Instruction
+  {
+    opcode_t opcode;
+    unsigned int argument;
+  };
+
+  // An abstract base class for nodes in the expression tree, only used while compiling
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -89,9 +106,8 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return NODE_LEAF; };
-  private:
+
     InfoPtr m_info;
     bool m_invert;
   };
@@ -103,17 +119,26 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return m_type; };
-  private:
+
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
   };
 
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
-  bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  bool Parse(const std::string &expression, InfoSubexpressionPtr &tree);
+
+  static InfoSubexpressionPtr Fold(const InfoSubexpressionPtr &node, bool &constant);
+  static bool AddFolded(std::list<InfoSubexpressionPtr> &children, const InfoSubexpressionPtr &child);
+  static bool IsListItemDependent(const InfoSubexpressionPtr &node);
+  static std::string Describe(const InfoSubexpressionPtr &node);
+  void Compile(const InfoSubexpressionPtr &tree);
+  void Emit(const InfoSubexpressionPtr &node, bool root);
+  unsigned int AddLeaf(const InfoPtr &info);
+
+  std::vector<Instruction> m_program;
+  std::vector<InfoPtr> m_leaves;
 };
 
 };
@@ -19,6 +19,7 @@
  */
 
 #include "AudioLibrary.h"
+#include "ResponseStream.h"
 #include "music/MusicDatabase.h"
 #include "FileItem.h"
 #include "ServiceBroker.h"
@@ -347,6 +348,27 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
   std::set<std::string> additionalProperties;
   bool artistData = CheckForAdditionalProperties(parameterObject["properties"], checkProperties, additionalProperties);
  
+  // write the songs into the response while they are being read
+  CResponseStream *stream = transport->GetResponseStream();
+  if (stream != nullptr)
+  {
+    // the additional details are read with a second connection as the first
+    // one is busy with the songs
+    CMusicDatabase detailsdatabase;
+    std::set<std::string> detailsProperties;
+    if (GetAdditionalSongProperties(parameterObject, detailsProperties) && !detailsdatabase.Open())
+      return InternalError;
+
+    CItemStreamer streamer("songid", true, "songs", parameterObject, *stream, [&](const CFileItemPtr &item)
+    {
+      GetAdditionalSongDetails(detailsProperties, item, detailsdatabase);
+    });
+    if (!musicdatabase.GetSongsFullByWhere(musicUrl.ToString(), CDatabase::Filter(), streamer, sorting, artistData))
+      return InternalError;
+
+    return streamer.End() ? OK : InternalError;
+  }
+
   CFileItemList items;
   if (!musicdatabase.GetSongsFullByWhere(musicUrl.ToString(), CDatabase::Filter(), items, sorting, artistData))
     return InternalError; 
@@ -1030,6 +1052,18 @@ JSONRPC_STATUS CAudioLibrary::GetAdditionalSongDetails(const CVariant &parameter
   if (!musicdatabase.Open())
     return InternalError;
 
+  std::set<std::string> additionalProperties;
+  if (!GetAdditionalSongProperties(parameterObject, additionalProperties))
+    return OK;
+
+  for (int i = 0; i < items.Size(); i++)
+    GetAdditionalSongDetails(additionalProperties, items[i], musicdatabase);
+
+  return OK;
+}
+
+bool CAudioLibrary::GetAdditionalSongProperties(const CVariant &parameterObject, std::set<std::string> &additionalProperties)
+{
   std::set<std::string> checkProperties;
   checkProperties.insert("genreid");
   // Query (songview join songartistview) returns song.strAlbumArtists = CMusicInfoTag.m_strAlbumArtistDesc only
@@ -1038,37 +1072,32 @@ JSONRPC_STATUS CAudioLibrary::GetAdditionalSongDetails(const CVariant &parameter
   checkProperties.insert("albumartist"); 
   checkProperties.insert("albumartistid");
   checkProperties.insert("musicbrainzalbumartistid");
-  std::set<std::string> additionalProperties;
-  if (!CheckForAdditionalProperties(parameterObject["properties"], checkProperties, additionalProperties))
-    return OK;
+  return CheckForAdditionalProperties(parameterObject["properties"], checkProperties, additionalProperties);
+}
 
-  for (int i = 0; i < items.Size(); i++)
+void CAudioLibrary::GetAdditionalSongDetails(const std::set<std::string> &additionalProperties, const CFileItemPtr &item, CMusicDatabase &musicdatabase)
+{
+  if (additionalProperties.find("genreid") != additionalProperties.end())
   {
-    CFileItemPtr item = items[i];
-    if (additionalProperties.find("genreid") != additionalProperties.end())
+    std::vector<int> genreids;
+    if (musicdatabase.GetGenresBySong(item->GetMusicInfoTag()->GetDatabaseId(), genreids))
     {
-      std::vector<int> genreids;
-      if (musicdatabase.GetGenresBySong(item->GetMusicInfoTag()->GetDatabaseId(), genreids))
-      {
-        CVariant genreidObj(CVariant::VariantTypeArray);
-        for (std::vector<int>::const_iterator genreid = genreids.begin(); genreid != genreids.end(); ++genreid)
-          genreidObj.push_back(*genreid);
+      CVariant genreidObj(CVariant::VariantTypeArray);
+      for (std::vector<int>::const_iterator genreid = genreids.begin(); genreid != genreids.end(); ++genreid)
+        genreidObj.push_back(*genreid);
 
-        item->SetProperty("genreid", genreidObj);
-      }
+      item->SetProperty("genreid", genreidObj);
     }
-    if (item->GetMusicInfoTag()->GetAlbumId() > 0)
+  }
+  if (item->GetMusicInfoTag()->GetAlbumId() > 0)
+  {
+    if (additionalProperties.find("albumartist") != additionalProperties.end() ||
+        additionalProperties.find("albumartistid") != additionalProperties.end() ||
+        additionalProperties.find("musicbrainzalbumartistid") != additionalProperties.end())
     {
-      if (additionalProperties.find("albumartist") != additionalProperties.end() ||
-          additionalProperties.find("albumartistid") != additionalProperties.end() ||
-          additionalProperties.find("musicbrainzalbumartistid") != additionalProperties.end())
-      {
-        musicdatabase.GetArtistsByAlbum(item->GetMusicInfoTag()->GetAlbumId(), item.get());
-      }
+      musicdatabase.GetArtistsByAlbum(item->GetMusicInfoTag()->GetAlbumId(), item.get());
     }
   }
-
-  return OK;
 }
 
 bool CAudioLibrary::CheckForAdditionalProperties(const CVariant &properties, const std::set<std::string> &checkProperties, std::set<std::string> &foundProperties)
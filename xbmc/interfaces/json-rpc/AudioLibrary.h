@@ -66,6 +66,9 @@ namespace JSONRPC
     static JSONRPC_STATUS GetAdditionalSongDetails(const CVariant &parameterObject, CFileItemList &items, CMusicDatabase &musicdatabase);
 
   private:
+    static bool GetAdditionalSongProperties(const CVariant &parameterObject, std::set<std::string> &additionalProperties);
+    static void GetAdditionalSongDetails(const std::set<std::string> &additionalProperties, const CFileItemPtr &item, CMusicDatabase &musicdatabase);
+
     static void FillAlbumItem(const CAlbum &album, const std::string &path, CFileItemPtr &item);
     static void FillItemArtistIDs(const std::vector<int> artistids, CFileItemPtr &item);
     
@@ -23,6 +23,7 @@
 
 #include "FileItemHandler.h"
 #include "AudioLibrary.h"
+#include "ResponseStream.h"
 #include "VideoLibrary.h"
 #include "FileOperations.h"
 #include "utils/SortUtils.h"
@@ -204,6 +205,63 @@ void CFileItemHandler::FillDetails(const ISerializable *info, const CFileItemPtr
   }
 }
 
+CFileItemHandler::CItemStreamer::CItemStreamer(const char *ID, bool allowFile, const char *resultname, const CVariant &parameterObject, CResponseStream &stream, FillItem fillItem /* = nullptr */)
+  : m_ID(ID),
+    m_allowFile(allowFile),
+    m_resultName(resultname),
+    m_parameterObject(parameterObject),
+    m_stream(stream),
+    m_fillItem(fillItem)
+{
+  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
+  {
+    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array(); field != parameterObject["properties"].end_array(); field++)
+      m_fields.insert(field->asString());
+  }
+}
+
+CFileItemHandler::CItemStreamer::~CItemStreamer() = default;
+
+bool CFileItemHandler::CItemStreamer::OnTotal(int total)
+{
+  CVariant result;
+  int start, end;
+  HandleLimits(m_parameterObject, result, total, start, end);
+
+  return m_stream.Begin(result, m_resultName);
+}
+
+bool CFileItemHandler::CItemStreamer::OnItem(const CFileItemPtr &item)
+{
+  if (m_thumbLoader == nullptr)
+  {
+    if (item->HasVideoInfoTag())
+      m_thumbLoader.reset(new CVideoThumbLoader());
+    else if (item->HasMusicInfoTag())
+      m_thumbLoader.reset(new CMusicThumbLoader());
+
+    if (m_thumbLoader != nullptr)
+      m_thumbLoader->OnLoaderStart();
+  }
+
+  if (m_fillItem)
+    m_fillItem(item);
+
+  CVariant result;
+  HandleFileItem(m_ID, m_allowFile, m_resultName, item, m_parameterObject, m_fields, result, false, m_thumbLoader.get());
+
+  return m_stream.Append(result[m_resultName]);
+}
+
+bool CFileItemHandler::CItemStreamer::End()
+{
+  // without any items the listing didn't report a total
+  if (!m_stream.IsStarted() && !OnTotal(0))
+    return false;
+
+  return m_stream.End();
+}
+
 void CFileItemHandler::HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, bool sortLimit /* = true */)
 {
   HandleFileItemList(ID, allowFile, resultname, items, parameterObject, result, items.Size(), sortLimit);
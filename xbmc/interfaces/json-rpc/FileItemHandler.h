@@ -19,20 +19,61 @@
  *
  */
 
+#include <functional>
+#include <memory>
 #include <set>
 
 #include "JSONRPC.h"
 #include "JSONUtils.h"
 #include "FileItem.h"
+#include "dbwrappers/Database.h"
 
 class CThumbLoader;
 class CVariant;
 
 namespace JSONRPC
 {
+  class CResponseStream;
+
   class CFileItemHandler : public CJSONUtils
   {
   protected:
+    /*!
+     \brief Writes the items of a database listing into a response stream while they are being read
+
+     Every item is handled like by HandleFileItemList() without sorting and
+     limiting (which the database has already applied) and written right away.
+     */
+    class CItemStreamer : public CDatabase::IItemCallback
+    {
+    public:
+      typedef std::function<void(const CFileItemPtr &item)> FillItem;
+
+      /*!
+       \param fillItem optional function to add details to every item before it is written
+       */
+      CItemStreamer(const char *ID, bool allowFile, const char *resultname, const CVariant &parameterObject, CResponseStream &stream, FillItem fillItem = nullptr);
+      ~CItemStreamer() override;
+
+      bool OnTotal(int total) override;
+      bool OnItem(const CFileItemPtr &item) override;
+
+      /*!
+       \brief Finishes the response, also if there weren't any items
+       */
+      bool End();
+
+    private:
+      const char *m_ID;
+      bool m_allowFile;
+      const char *m_resultName;
+      const CVariant &m_parameterObject;
+      CResponseStream &m_stream;
+      FillItem m_fillItem;
+      std::set<std::string> m_fields;
+      std::unique_ptr<CThumbLoader> m_thumbLoader;
+    };
+
     static void FillDetails(const ISerializable *info, const CFileItemPtr &item, std::set<std::string> &fields, CVariant &result, CThumbLoader *thumbLoader = NULL);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, bool sortLimit = true);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, int size, bool sortLimit = true);
@@ -25,6 +25,8 @@ class CVariant;
 
 namespace JSONRPC
 {
+  class CResponseStream;
+
   enum TransportLayerCapability
   {
     Response = 0x1,
@@ -42,5 +44,11 @@ namespace JSONRPC
     virtual bool PrepareDownload(const char *path, CVariant &details, std::string &protocol) = 0;
     virtual bool Download(const char *path, CVariant &result) = 0;
     virtual int GetCapabilities() = 0;
+
+    /*!
+     \brief Returns the stream into which the response of the current method
+     call can be written while it is being built, if the transport supports it
+     */
+    virtual CResponseStream* GetResponseStream() { return nullptr; }
   };
 }
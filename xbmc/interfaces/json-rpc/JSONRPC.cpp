@@ -18,9 +18,11 @@
  *
  */
 
+#include <set>
 #include <string.h>
 
 #include "JSONRPC.h"
+#include "ResponseStream.h"
 #include "ServiceDescription.h"
 #include "addons/Addon.h"
 #include "addons/IAddon.h"
@@ -30,6 +32,7 @@
 #include "interfaces/AnnouncementManager.h"
 #include "playlists/SmartPlayList.h"
 #include "settings/AdvancedSettings.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
@@ -40,6 +43,34 @@ using namespace JSONRPC;
 
 bool CJSONRPC::m_initialized = false;
 
+namespace
+{
+  // methods which write their result items into the response stream
+  const std::set<std::string> StreamableMethods = {
+    "audiolibrary.getsongs",
+    "videolibrary.getmovies"
+  };
+
+  // passes the response stream to the called method
+  class CStreamTransportLayer : public ITransportLayer
+  {
+  public:
+    CStreamTransportLayer(ITransportLayer *transport, CResponseStream &stream)
+      : m_transport(transport),
+        m_stream(stream)
+    { }
+
+    bool PrepareDownload(const char *path, CVariant &details, std::string &protocol) override { return m_transport->PrepareDownload(path, details, protocol); }
+    bool Download(const char *path, CVariant &result) override { return m_transport->Download(path, result); }
+    int GetCapabilities() override { return m_transport->GetCapabilities(); }
+    CResponseStream* GetResponseStream() override { return &m_stream; }
+
+  private:
+    ITransportLayer *m_transport;
+    CResponseStream &m_stream;
+  };
+}
+
 void CJSONRPC::Initialize()
 {
   if (m_initialized)
@@ -281,6 +312,39 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
   return str;
 }
 
+bool CJSONRPC::ParseStreamableCall(const std::string &inputString, CVariant &request)
+{
+  if (!CJSONVariantParser::Parse(inputString, request) || !request.isObject() ||
+      !IsProperJSONRPC(request) || !request.isMember("id"))
+    return false;
+
+  std::string methodName = request["method"].asString();
+  StringUtils::ToLower(methodName);
+
+  return StreamableMethods.find(methodName) != StreamableMethods.end();
+}
+
+bool CJSONRPC::MethodCall(const CVariant &request, ITransportLayer *transport, IClient *client, CJSONStreamWriter &writer)
+{
+  CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming streamed request: %s", request["method"].asString().c_str());
+
+  CResponseStream stream(request["id"], writer);
+  CStreamTransportLayer streamTransport(transport, stream);
+
+  CVariant response;
+  HandleMethodCall(request, response, &streamTransport, client);
+
+  // the method has written its result into the stream
+  if (stream.IsStarted())
+  {
+    if (!stream.IsComplete())
+      CLog::Log(LOGERROR, "JSONRPC: Failed to stream the response of %s", request["method"].asString().c_str());
+    return stream.IsComplete();
+  }
+
+  return writer.Write(response) && writer.Flush();
+}
+
 bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
 {
   JSONRPC_STATUS errorCode = OK;
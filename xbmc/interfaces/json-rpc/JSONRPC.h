@@ -27,6 +27,7 @@
 #include "JSONRPCUtils.h"
 #include "JSONServiceDescription.h"
 
+class CJSONStreamWriter;
 class CVariant;
 
 namespace JSONRPC
@@ -64,6 +65,30 @@ namespace JSONRPC
      */
     static std::string MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client);
 
+    /*
+     \brief Checks whether an incoming JSON-RPC request can be answered with a streamed response
+     \param inputString received JSON-RPC request
+     \param request Parsed request
+     \return True if the input is a single request (not a notification or a batch) of a method which streams its result
+
+     Only methods which return long lists of database items stream their results.
+     */
+    static bool ParseStreamableCall(const std::string &inputString, CVariant &request);
+
+    /*
+     \brief Handles a JSON-RPC request parsed by ParseStreamableCall() and writes its response into a stream
+     \param request parsed JSON-RPC request
+     \param transport Transport protocol on which the request arrived
+     \param client Client which sent the request
+     \param writer Writer for the JSON-RPC response
+     \return True if the complete response has been written
+
+     The method writes the items of its result into the stream while they are
+     being read. If it fails after the response has been started the response
+     can't be completed anymore.
+     */
+    static bool MethodCall(const CVariant &request, ITransportLayer *transport, IClient *client, CJSONStreamWriter &writer);
+
     static JSONRPC_STATUS Introspect(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Version(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Permission(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
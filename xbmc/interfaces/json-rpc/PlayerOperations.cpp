@@ -39,6 +39,7 @@
 #include "pvr/channels/PVRChannelGroupsContainer.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/recordings/PVRRecordings.h"
+#include "cores/DataCacheCore.h"
 #include "cores/IPlayer.h"
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "SeekHandler.h"
@@ -1735,6 +1736,32 @@ JSONRPC_STATUS CPlayerOperations::GetPropertyValue(PlayerType player, const std:
   }
   else if (property == "live")
     result = IsPVRChannel();
+  else if (property == "audiolatency")
+  {
+    switch (player)
+    {
+      case Video:
+      case Audio:
+      {
+        CDataCacheCore &dataCache = CServiceBroker::GetDataCacheCore();
+        result = CVariant(CVariant::VariantTypeObject);
+        result["stream"] = static_cast<int>(dataCache.GetAudioLatencyStream() * 1000);
+        result["processing"] = static_cast<int>(dataCache.GetAudioLatencyProcessing() * 1000);
+        result["engine"] = static_cast<int>(dataCache.GetAudioLatencyEngine() * 1000);
+        result["sink"] = static_cast<int>(dataCache.GetAudioLatencySink() * 1000);
+        result["device"] = static_cast<int>(dataCache.GetAudioLatencyDevice() * 1000);
+        result["total"] = static_cast<int>(dataCache.GetAudioLatency() * 1000);
+        result["lowlatency"] = dataCache.IsAudioLowLatency();
+        result["underruns"] = dataCache.GetAudioUnderruns();
+        break;
+      }
+
+      case Picture:
+      default:
+        result = CVariant(CVariant::VariantTypeNull);
+        break;
+    }
+  }
   else
     return InvalidParams;
 
@@ -0,0 +1,96 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ResponseStream.h"
+#include "utils/JSONVariantWriter.h"
+
+using namespace JSONRPC;
+
+CResponseStream::CResponseStream(const CVariant &id, CJSONStreamWriter &writer)
+  : m_id(id),
+    m_writer(writer)
+{ }
+
+bool CResponseStream::Begin(const CVariant &result, const std::string &listName)
+{
+  if (m_started)
+    return false;
+
+  m_started = true;
+  m_result = result;
+  m_listName = listName;
+
+  // the members of a response are written in the order of CVariant's keys
+  return m_writer.StartObject() &&
+         m_writer.Key("id") && m_writer.Write(m_id) &&
+         m_writer.Key("jsonrpc") && m_writer.Write("2.0") &&
+         m_writer.Key("result") && m_writer.StartObject() &&
+         WriteMembers(true);
+}
+
+bool CResponseStream::Append(const CVariant &item)
+{
+  if (!m_started || m_ended)
+    return false;
+
+  if (!m_listStarted)
+  {
+    m_listStarted = true;
+    if (!m_writer.Key(m_listName) || !m_writer.StartArray())
+      return false;
+  }
+
+  return m_writer.Write(item);
+}
+
+bool CResponseStream::End()
+{
+  if (!m_started || m_ended)
+    return false;
+
+  m_ended = true;
+  if (m_listStarted && !m_writer.EndArray())
+    return false;
+
+  return WriteMembers(false) &&
+         m_writer.EndObject() &&
+         m_writer.EndObject() &&
+         m_writer.Flush();
+}
+
+bool CResponseStream::IsComplete() const
+{
+  return m_ended && m_writer.IsComplete();
+}
+
+bool CResponseStream::WriteMembers(bool beforeList)
+{
+  for (CVariant::const_iterator_map itr = m_result.begin_map(); itr != m_result.end_map(); ++itr)
+  {
+    int order = itr->first.compare(m_listName);
+    if (order == 0 || (order < 0) != beforeList)
+      continue;
+
+    if (!m_writer.Key(itr->first) || !m_writer.Write(itr->second))
+      return false;
+  }
+
+  return true;
+}
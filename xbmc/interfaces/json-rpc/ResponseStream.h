@@ -0,0 +1,76 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "utils/Variant.h"
+
+class CJSONStreamWriter;
+
+namespace JSONRPC
+{
+  /*!
+   \ingroup jsonrpc
+   \brief Writes a JSON-RPC response while the result list is being built
+
+   Methods returning long lists of items can use the stream of their
+   transport layer (see ITransportLayer::GetResponseStream()) to send every
+   item as soon as it has been read instead of collecting all of them in the
+   result first. The response is written in the same member order as a
+   buffered response.
+   */
+  class CResponseStream
+  {
+  public:
+    CResponseStream(const CVariant &id, CJSONStreamWriter &writer);
+
+    /*!
+     \brief Starts the response with all members of the result except the list
+     \param result Result object without the list (e.g. with the limits)
+     \param listName Name of the list member in the result object
+     */
+    bool Begin(const CVariant &result, const std::string &listName);
+
+    /*!
+     \brief Appends an item to the list of the result
+     */
+    bool Append(const CVariant &item);
+
+    /*!
+     \brief Finishes the list and the response
+     */
+    bool End();
+
+    bool IsStarted() const { return m_started; }
+    bool IsComplete() const;
+
+  private:
+    bool WriteMembers(bool beforeList);
+
+    CVariant m_id;
+    CJSONStreamWriter &m_writer;
+    CVariant m_result;
+    std::string m_listName;
+    bool m_started = false;
+    bool m_listStarted = false;
+    bool m_ended = false;
+  };
+}
@@ -19,6 +19,7 @@
  */
 
 #include "VideoLibrary.h"
+#include "ResponseStream.h"
 #include "messaging/ApplicationMessenger.h"
 #include "TextureDatabase.h"
 #include "Util.h"
@@ -47,14 +48,20 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (!videoUrl.FromString("videodb://movies/titles/"))
     return InternalError;
 
-  int genreID = -1, year = -1, setID = 0;
+  // ids which aren't positive don't filter the movies
   const CVariant &filter = parameterObject["filter"];
   if (filter.isMember("genreid"))
-    genreID = (int)filter["genreid"].asInteger();
+  {
+    if (filter["genreid"].asInteger() > 0)
+      videoUrl.AddOption("genreid", (int)filter["genreid"].asInteger());
+  }
   else if (filter.isMember("genre"))
     videoUrl.AddOption("genre", filter["genre"].asString());
   else if (filter.isMember("year"))
-    year = (int)filter["year"].asInteger();
+  {
+    if (filter["year"].asInteger() > 0)
+      videoUrl.AddOption("year", (int)filter["year"].asInteger());
+  }
   else if (filter.isMember("actor"))
     videoUrl.AddOption("actor", filter["actor"].asString());
   else if (filter.isMember("director"))
@@ -64,7 +71,10 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   else if (filter.isMember("country"))
     videoUrl.AddOption("country", filter["country"].asString());
   else if (filter.isMember("setid"))
-    setID = (int)filter["setid"].asInteger();
+  {
+    if (filter["setid"].asInteger() > 0)
+      videoUrl.AddOption("setid", (int)filter["setid"].asInteger());
+  }
   else if (filter.isMember("set"))
     videoUrl.AddOption("set", filter["set"].asString());
   else if (filter.isMember("tag"))
@@ -78,12 +88,21 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
     videoUrl.AddOption("xsp", xsp);
   }
 
-  // setID must not be -1 otherwise GetMoviesNav() will return sets
-  if (setID < 0)
-    setID = 0;
+  int getDetails = RequiresAdditionalDetails(MediaTypeMovie, parameterObject);
+
+  // write the movies into the response while they are being read
+  CResponseStream *stream = transport->GetResponseStream();
+  if (stream != nullptr)
+  {
+    CItemStreamer streamer("movieid", true, "movies", parameterObject, *stream);
+    if (!videodatabase.GetMoviesByWhere(videoUrl.ToString(), CDatabase::Filter(), streamer, sorting, getDetails))
+      return stream->IsStarted() ? InternalError : InvalidParams;
+
+    return streamer.End() ? OK : InternalError;
+  }
 
   CFileItemList items;
-  if (!videodatabase.GetMoviesNav(videoUrl.ToString(), items, genreID, year, -1, -1, -1, -1, setID, -1, sorting, RequiresAdditionalDetails(MediaTypeMovie, parameterObject)))
+  if (!videodatabase.GetMoviesByWhere(videoUrl.ToString(), CDatabase::Filter(), items, sorting, getDetails))
     return InvalidParams;
 
   return HandleItems("movieid", "movies", items, parameterObject, result, false);
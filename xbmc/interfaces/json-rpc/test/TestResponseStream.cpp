@@ -0,0 +1,116 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "interfaces/json-rpc/ResponseStream.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+
+#include "gtest/gtest.h"
+
+using namespace JSONRPC;
+
+namespace
+{
+  // writes the result like CJSONRPC::MethodCall() does without a stream
+  std::string WriteBuffered(const CVariant &result, bool compact)
+  {
+    CVariant response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = 1;
+    response["result"] = result;
+
+    std::string str;
+    EXPECT_TRUE(CJSONVariantWriter::Write(response, str, compact));
+    return str;
+  }
+
+  std::string WriteStreamed(const CVariant &result, const std::string &listName, bool compact)
+  {
+    std::string str;
+    CJSONStreamWriter writer([&str](const char *data, size_t size)
+    {
+      str.append(data, size);
+      return true;
+    }, compact, 16);
+    CResponseStream stream(CVariant(1), writer);
+
+    CVariant head = result;
+    head.erase(listName);
+    EXPECT_FALSE(stream.IsStarted());
+    EXPECT_TRUE(stream.Begin(head, listName));
+    EXPECT_TRUE(stream.IsStarted());
+    if (result.isMember(listName))
+    {
+      for (CVariant::const_iterator_array itr = result[listName].begin_array(); itr != result[listName].end_array(); ++itr)
+        EXPECT_TRUE(stream.Append(*itr));
+    }
+    EXPECT_FALSE(stream.IsComplete());
+    EXPECT_TRUE(stream.End());
+    EXPECT_TRUE(stream.IsComplete());
+
+    return str;
+  }
+}
+
+TEST(TestResponseStream, MatchesBufferedResponse)
+{
+  CVariant result;
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = 2;
+  result["limits"]["total"] = 2;
+  for (int i = 1; i <= 2; i++)
+  {
+    CVariant movie;
+    movie["movieid"] = i;
+    movie["label"] = "movie";
+    result["movies"].push_back(movie);
+  }
+  // members after the list
+  result["zzz"] = true;
+
+  for (bool compact : { true, false })
+    EXPECT_EQ(WriteBuffered(result, compact), WriteStreamed(result, "movies", compact));
+}
+
+TEST(TestResponseStream, EmptyList)
+{
+  // without items the buffered result has no list at all
+  CVariant result;
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = 0;
+  result["limits"]["total"] = 0;
+
+  EXPECT_EQ(WriteBuffered(result, true), WriteStreamed(result, "songs", true));
+}
+
+TEST(TestResponseStream, AppendRequiresBegin)
+{
+  std::string str;
+  CJSONStreamWriter writer([&str](const char *data, size_t size)
+  {
+    str.append(data, size);
+    return true;
+  }, true);
+  CResponseStream stream(CVariant(1), writer);
+
+  EXPECT_FALSE(stream.Append(CVariant(1)));
+  EXPECT_FALSE(stream.End());
+  EXPECT_TRUE(str.empty());
+}
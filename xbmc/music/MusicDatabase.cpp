@@ -1042,14 +1042,14 @@ int CMusicDatabase::AddGenre(std::string& strGenre)
       return it->second;
 
 
-    strSQL=PrepareSQL("SELECT idGenre, strGenre FROM genre WHERE strGenre LIKE '%s'", strGenre.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "SELECT idGenre, strGenre FROM genre WHERE strGenre LIKE ?";
+    m_pDS->query_prepared(strSQL, { dbiplus::field_value(strGenre) });
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL=PrepareSQL("INSERT INTO genre (idGenre, strGenre) values( NULL, '%s' )", strGenre.c_str());
-      m_pDS->exec(strSQL);
+      strSQL = "INSERT INTO genre (idGenre, strGenre) values( NULL, ? )";
+      m_pDS->exec_prepared(strSQL, { dbiplus::field_value(strGenre) });
 
       int idGenre = (int)m_pDS->lastinsertid();
       m_genreCache.insert(std::pair<std::string, int>(strGenre, idGenre));
@@ -1066,7 +1066,7 @@ int CMusicDatabase::AddGenre(std::string& strGenre)
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "musicdatabase:unable to addgenre (%s)", strSQL.c_str());
+    CLog::Log(LOGERROR, "musicdatabase:unable to addgenre (%s) (%s)", strSQL.c_str(), strGenre.c_str());
   }
 
   return -1;
@@ -1502,23 +1502,23 @@ int CMusicDatabase::AddRole(const std::string &strRole)
   {
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
-    strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "SELECT idRole FROM role WHERE strRole LIKE ?";
+    m_pDS->query_prepared(strSQL, { dbiplus::field_value(strRole) });
     if (m_pDS->num_rows() > 0)
       idRole = m_pDS->fv("idRole").get_asInt();
     m_pDS->close();
 
     if (idRole < 0)
     {
-      strSQL = PrepareSQL("INSERT INTO role (strRole) VALUES ('%s')", strRole.c_str());
-      m_pDS->exec(strSQL);
+      strSQL = "INSERT INTO role (strRole) VALUES (?)";
+      m_pDS->exec_prepared(strSQL, { dbiplus::field_value(strRole) });
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "musicdatabase:unable to AddRole (%s)", strSQL.c_str());
+    CLog::Log(LOGERROR, "musicdatabase:unable to AddRole (%s) (%s)", strSQL.c_str(), strRole.c_str());
   }
   return idRole;
 }
@@ -1531,10 +1531,9 @@ bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, const std::string&
 
 bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, int idRole, const std::string& strArtist, int iOrder)
 {
-  std::string strSQL;
-  strSQL = PrepareSQL("replace into song_artist (idArtist, idSong, idRole, strArtist, iOrder) values(%i,%i,%i,'%s',%i)",
-    idArtist, idSong, idRole, strArtist.c_str(), iOrder);
-  return ExecuteQuery(strSQL);
+  return ExecutePrepared("replace into song_artist (idArtist, idSong, idRole, strArtist, iOrder) values(?,?,?,?,?)",
+    { dbiplus::field_value(idArtist), dbiplus::field_value(idSong), dbiplus::field_value(idRole),
+      dbiplus::field_value(strArtist), dbiplus::field_value(iOrder) });
 }
 
 int CMusicDatabase::AddSongContributor(int idSong, const std::string& strRole, const std::string& strArtist, const std::string &strSort)
@@ -1668,10 +1667,9 @@ bool CMusicDatabase::DeleteSongArtistsBySong(int idSong)
 
 bool CMusicDatabase::AddAlbumArtist(int idArtist, int idAlbum, std::string strArtist, int iOrder)
 {
-  std::string strSQL;
-  strSQL = PrepareSQL("replace into album_artist (idArtist, idAlbum, strArtist, iOrder) values(%i,%i,'%s',%i)",
-    idArtist, idAlbum, strArtist.c_str(), iOrder);
-  return ExecuteQuery(strSQL);
+  return ExecutePrepared("replace into album_artist (idArtist, idAlbum, strArtist, iOrder) values(?,?,?,?)",
+    { dbiplus::field_value(idArtist), dbiplus::field_value(idAlbum),
+      dbiplus::field_value(strArtist), dbiplus::field_value(iOrder) });
 }
 
 bool CMusicDatabase::DeleteAlbumArtistsByAlbum(int idAlbum)
@@ -1696,9 +1694,9 @@ bool CMusicDatabase::AddSongGenres(int idSong, const std::vector<std::string>& g
     for (auto &strGenre : modgenres)
     {
       int idGenre = AddGenre(strGenre); // Genre string trimed and matched case insensitively
-      strSQL = PrepareSQL("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(%i,%i,%i)",
-        idGenre, idSong, index++);
-      if (!ExecuteQuery(strSQL))
+      strSQL = "INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(?,?,?)";
+      if (!ExecutePrepared(strSQL, { dbiplus::field_value(idGenre), dbiplus::field_value(idSong),
+                                     dbiplus::field_value(index++) }))
         return false;
     }
     // Update concatenated genre string from the standardised genre values
@@ -2014,14 +2012,14 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (it != m_pathCache.end())
       return it->second;
 
-    strSQL=PrepareSQL( "select * from path where strPath='%s'", strPath.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select * from path where strPath=?";
+    m_pDS->query_prepared(strSQL, { dbiplus::field_value(strPath) });
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL=PrepareSQL("insert into path (idPath, strPath) values( NULL, '%s' )", strPath.c_str());
-      m_pDS->exec(strSQL);
+      strSQL = "insert into path (idPath, strPath) values( NULL, ? )";
+      m_pDS->exec_prepared(strSQL, { dbiplus::field_value(strPath) });
 
       int idPath = (int)m_pDS->lastinsertid();
       m_pathCache.insert(std::pair<std::string, int>(strPath, idPath));
@@ -2037,7 +2035,7 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "musicdatabase:unable to addpath (%s)", strSQL.c_str());
+    CLog::Log(LOGERROR, "musicdatabase:unable to addpath (%s) (%s)", strSQL.c_str(), strPath1.c_str());
   }
 
   return -1;
@@ -4419,7 +4417,40 @@ bool CMusicDatabase::GetAlbumsByWhere(const std::string &baseDir, const Filter &
   return false;
 }
 
+namespace
+{
+  // collects the songs read by CMusicDatabase::GetSongsFullByWhere in a list
+  class CSongListCallback : public CDatabase::IItemCallback
+  {
+  public:
+    explicit CSongListCallback(CFileItemList &items) : m_items(items) { }
+
+    bool OnTotal(int total) override
+    {
+      // Store the total number of songs as a property
+      m_items.SetProperty("total", total);
+      m_items.Reserve(total);
+      return true;
+    }
+
+    bool OnItem(const CFileItemPtr &item) override
+    {
+      m_items.Add(item);
+      return true;
+    }
+
+  private:
+    CFileItemList &m_items;
+  };
+}
+
 bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filter &filter, CFileItemList &items, const SortDescription &sortDescription /* = SortDescription() */, bool artistData /* = false*/)
+{
+  CSongListCallback callback(items);
+  return GetSongsFullByWhere(baseDir, filter, callback, sortDescription, artistData);
+}
+
+bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription /* = SortDescription() */, bool artistData /* = false*/)
 {
   if (m_pDB.get() == NULL || m_pDS.get() == NULL)
     return false;
@@ -4492,9 +4523,6 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
       return true;
     }
 
-    // Store the total number of songs as a property
-    items.SetProperty("total", total);
-
     DatabaseResults results;
     results.reserve(iRowsFound);
     // Avoid sorting with limits when have join with songartistview 
@@ -4506,34 +4534,56 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
     if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
       return false;
 
+    // Songs can only be passed on as soon as they are complete if they don't need
+    // any sorting in items list we have not been able to do before in SQL or dataset,
+    // that is when have join with songartistview and sorting other than random with limit
+    bool sortItems = artistData && sortDescription.sortBy != SortByNone && !(limitedInSQL && sortDescription.sortBy == SortByRandom);
+    CFileItemList sortedItems;
+    if (sortItems)
+      sortedItems.Reserve(total);
+    else if (!callback.OnTotal(total))
+    {
+      m_pDS->close();
+      return false;
+    }
+
     // Get songs from returned rows. If join songartistview then there is a row for every artist
-    items.Reserve(total);
     int songArtistOffset = song_enumCount;
     int songId = -1;
+    CFileItemPtr song;
     VECARTISTCREDITS artistCredits;
     const dbiplus::query_data &data = m_pDS->get_result_set().records;
     int count = 0;
-    for (const auto &i : results)
+    bool stopped = false;
+    auto songDone = [&]()
     {
-      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
+      if (!artistCredits.empty())
+      {
+        //Store artist credits for the song
+        GetFileItemFromArtistCredits(artistCredits, song.get());
+        artistCredits.clear();
+      }
+      if (sortItems)
+        sortedItems.Add(song);
+      else if (!callback.OnItem(song))
+        stopped = true;
+    };
+    for (DatabaseResults::const_iterator it = results.begin(); !stopped && it != results.end(); ++it)
+    {
+      unsigned int targetRow = (unsigned int)it->at(FieldRow).asInteger();
       const dbiplus::sql_record* const record = data.at(targetRow);
       
       try
       {
         if (songId != record->at(song_idSong).get_asInt())
         { //New song
-          if (songId > 0 && !artistCredits.empty())
-          {
-            //Store artist credits for previous song
-            GetFileItemFromArtistCredits(artistCredits, items[items.Size()-1].get());
-            artistCredits.clear();
-          }
+          if (song != nullptr)
+            songDone();
           songId = record->at(song_idSong).get_asInt();
-          CFileItemPtr item(new CFileItem);
-          GetFileItemFromDataset(record, item.get(), musicUrl);
+          song.reset(new CFileItem);
+          GetFileItemFromDataset(record, song.get(), musicUrl);
           // HACK for sorting by database returned order
-          item->m_iprogramCount = ++count;
-          items.Add(item);
+          song->m_iprogramCount = ++count;
         }
         // Get song artist credits and contributors
         if (artistData)
@@ -4542,29 +4592,34 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
           if (idSongArtistRole == ROLE_ARTIST)
             artistCredits.push_back(GetArtistCreditFromDataset(record, songArtistOffset));
           else
-            items[items.Size() - 1]->GetMusicInfoTag()->AppendArtistRole(GetArtistRoleFromDataset(record, songArtistOffset));
+            song->GetMusicInfoTag()->AppendArtistRole(GetArtistRoleFromDataset(record, songArtistOffset));
         }
       }
       catch (...)
       {
         m_pDS->close();
         CLog::Log(LOGERROR, "%s: out of memory loading query: %s", __FUNCTION__, filter.where.c_str());
-        return (items.Size() > 0);
+        return count > 0;
       }
     }
-    if (!artistCredits.empty())
-    {
-      //Store artist credits for final song
-      GetFileItemFromArtistCredits(artistCredits, items[items.Size() - 1].get());
-      artistCredits.clear();
-    }
+    if (song != nullptr && !stopped)
+      songDone();
     // cleanup
     m_pDS->close();
+    if (stopped)
+      return false;
 
-    // Finally do any sorting in items list we have not been able to do before in SQL or dataset,
-    // that is when have join with songartistview and sorting other than random with limit
-    if (artistData && sortDescription.sortBy != SortByNone && !(limitedInSQL && sortDescription.sortBy == SortByRandom))
-      items.Sort(sortDescription);
+    if (sortItems)
+    {
+      sortedItems.Sort(sortDescription);
+      if (!callback.OnTotal(total))
+        return false;
+      for (int i = 0; i < sortedItems.Size(); i++)
+      {
+        if (!callback.OnItem(sortedItems.Get(i)))
+          return false;
+      }
+    }
      
     CLog::Log(LOGDEBUG, "%s(%s) - took %d ms", __FUNCTION__, filter.where.c_str(), XbmcThreads::SystemClockMillis() - time);
     return true;
@@ -4619,6 +4674,34 @@ bool CMusicDatabase::GetSongsByWhere(const std::string &baseDir, const Filter &f
     strSQL = PrepareSQL(strSQL, !filter.fields.empty() && filter.fields.compare("*") != 0 ? filter.fields.c_str() : "songview.*") + strSQLExtra;
 
     CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
+
+    // without sorting, items are created in database order straight from a
+    // forward-only cursor instead of buffering the whole result set first
+    if (sortDescription.sortBy == SortByNone)
+    {
+      if (!m_pDS->query_forward(strSQL))
+        return false;
+
+      int count = 0;
+      while (!m_pDS->eof())
+      {
+        CFileItemPtr item(new CFileItem);
+        GetFileItemFromDataset(m_pDS->get_sql_record(), item.get(), musicUrl);
+        // HACK for sorting by database returned order
+        item->m_iprogramCount = ++count;
+        items.Add(item);
+        m_pDS->next();
+      }
+      m_pDS->close();
+
+      // store the total value of items as a property
+      if (total < count)
+        total = count;
+      if (count > 0)
+        items.SetProperty("total", total);
+      return true;
+    }
+
     // run query
     if (!m_pDS->query(strSQL))
       return false;
@@ -435,6 +435,12 @@ public:
   bool GetSongsByYear(const std::string& baseDir, CFileItemList& items, int year);
   bool GetSongsByWhere(const std::string &baseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription());
   bool GetSongsFullByWhere(const std::string &baseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription(), bool artistData = false);
+  /*! \brief Passes the songs to the callback while they are being read instead of collecting them in a list
+   The total number of songs is passed to IItemCallback::OnTotal() before the first song. Songs which have
+   to be sorted after all their artists have been read are collected and passed on once they are sorted.
+   \return false if the query failed or the callback stopped the listing
+   */
+  bool GetSongsFullByWhere(const std::string &baseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription = SortDescription(), bool artistData = false);
   bool GetAlbumsByWhere(const std::string &baseDir, const Filter &filter, CFileItemList &items, const SortDescription &sortDescription = SortDescription(), bool countOnly = false);
   bool GetAlbumsByWhere(const std::string &baseDir, const Filter &filter, VECALBUMS& albums, int& total, const SortDescription &sortDescription = SortDescription(), bool countOnly = false);
   bool GetArtistsByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription(), bool countOnly = false);
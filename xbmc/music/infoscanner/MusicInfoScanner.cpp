@@ -34,6 +34,7 @@
 #include "events/MediaLibraryEvent.h"
 #include "FileItem.h"
 #include "filesystem/Directory.h"
+#include "filesystem/DirectoryCrawler.h"
 #include "filesystem/File.h"
 #include "filesystem/MusicDatabaseDirectory.h"
 #include "filesystem/MusicDatabaseDirectory/DirectoryNode.h"
@@ -151,7 +152,16 @@ void CMusicInfoScanner::Process()
 
         // Clear list of albums added by this scan
         m_albumsAdded.clear();
+        // Commit the tags read from files in batches rather than per album
+        m_musicDatabase.BeginBatch(g_advancedSettings.m_iMusicLibraryScanBatchItems,
+                                   g_advancedSettings.m_iMusicLibraryScanBatchTime);
+        // fetch the listings of subfolders while the current one is scanned
+        m_crawler.reset(new CDirectoryCrawler(
+            CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg",
+            DIR_FLAG_DEFAULTS, g_advancedSettings.m_audioExcludeFromScanRegExps));
         bool scancomplete = DoScan(*it);
+        m_crawler.reset();
+        m_musicDatabase.EndBatch();
         if (scancomplete)
         { 
           if (m_albumsAdded.size() > 0)
@@ -469,7 +479,11 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 
   std::set<std::string>::const_iterator it = m_seenPaths.find(strDirectory);
   if (it != m_seenPaths.end())
+  {
+    if (m_crawler)
+      m_crawler->Release(strDirectory);
     return true;
+  }
 
   m_seenPaths.insert(strDirectory);
 
@@ -477,11 +491,18 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   const std::vector<std::string> &regexps = g_advancedSettings.m_audioExcludeFromScanRegExps;
 
   if (IsExcluded(strDirectory, regexps))
+  {
+    if (m_crawler)
+      m_crawler->Release(strDirectory);
     return true;
+  }
 
   // load subfolder
   CFileItemList items;
-  CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
+  if (m_crawler)
+    m_crawler->GetDirectory(strDirectory, items);
+  else
+    CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
 
   // sort and get the path hash.  Note that we don't filter .cue sheet items here as we want
   // to detect changes in the .cue sheet as well.  The .cue sheet items only need filtering
@@ -515,6 +536,7 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 
     // save information about this folder
     m_musicDatabase.SetPathHash(strDirectory, hash);
+    m_musicDatabase.BatchItemDone();
   }
   else
   { // path is the same - no need to rescan
@@ -28,6 +28,11 @@ class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
 
+namespace XFILE
+{
+  class CDirectoryCrawler;
+}
+
 namespace MUSIC_INFO
 {
 
@@ -252,6 +257,7 @@ protected:
   std::set<int> m_albumsAdded;
  
   std::set<std::string> m_seenPaths;
+  std::unique_ptr<XFILE::CDirectoryCrawler> m_crawler;
   int m_flags;
   CThread m_fileCountReader;
 };
@@ -19,6 +19,10 @@
  */
 
 #include "HTTPJsonRpcHandler.h"
+
+#include <algorithm>
+#include <string.h>
+
 #include "URL.h"
 #include "filesystem/File.h"
 #include "interfaces/json-rpc/JSONRPC.h"
@@ -26,11 +30,16 @@
 #include "interfaces/json-rpc/JSONUtils.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/log.h"
 #include "utils/Variant.h"
 
 #define MAX_HTTP_POST_SIZE 65536
+// size and maximum number of queued chunks of a streamed response
+#define HTTP_STREAM_CHUNK_SIZE 32768
+#define MAX_HTTP_STREAM_CHUNKS 8
 
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request) const
 {
@@ -82,7 +91,21 @@ int CHTTPJsonRpcHandler::HandleRequest()
       jsonpCallback = argument->second;
   }
 
-  if (isRequest)
+  CVariant request;
+  if (isRequest && JSONRPC::CJSONRPC::ParseStreamableCall(m_requestData, request))
+  {
+    // the response is sent while the method is still writing it
+    m_requestData.clear();
+    m_responseProducer.reset(new CResponseProducer(request, m_request.method, jsonpCallback));
+    m_responseProducer->Start();
+
+    m_response.type = HTTPStreamDownload;
+    m_response.status = MHD_HTTP_OK;
+    m_response.contentType = "application/json";
+
+    return MHD_YES;
+  }
+  else if (isRequest)
   {
     m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
 
@@ -130,6 +153,14 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+ssize_t CHTTPJsonRpcHandler::ReadResponseData(char *buffer, size_t size)
+{
+  if (m_responseProducer == nullptr)
+    return -1;
+
+  return m_responseProducer->Read(buffer, size);
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
@@ -190,3 +221,94 @@ bool CHTTPJsonRpcHandler::CHTTPClient::SetAnnouncementFlags(int flags)
 {
   return false;
 }
+
+CHTTPJsonRpcHandler::CResponseProducer::CResponseProducer(const CVariant &request, HTTPMethod method, const std::string &jsonpCallback)
+  : CThread("HTTPJsonRpcResponse"),
+    m_request(request),
+    m_client(method),
+    m_jsonpCallback(jsonpCallback)
+{ }
+
+CHTTPJsonRpcHandler::CResponseProducer::~CResponseProducer()
+{
+  // stops a method which is still waiting for the client
+  StopThread();
+}
+
+void CHTTPJsonRpcHandler::CResponseProducer::Start()
+{
+  Create();
+}
+
+ssize_t CHTTPJsonRpcHandler::CResponseProducer::Read(char *buffer, size_t size)
+{
+  while (m_chunkPosition >= m_chunk.size())
+  {
+    CSingleLock lock(m_critSection);
+    if (!m_chunks.empty())
+    {
+      m_chunk = std::move(m_chunks.front());
+      m_chunks.pop_front();
+      m_chunkPosition = 0;
+      m_chunkRead.Set();
+    }
+    else if (m_done)
+    {
+      if (m_failed)
+        CLog::Log(LOGERROR, "JSONRPC: Failed to write the streamed response");
+      return m_failed ? -1 : 0;
+    }
+    else
+    {
+      lock.Leave();
+      m_chunkQueued.Wait();
+    }
+  }
+
+  size_t length = std::min(size, m_chunk.size() - m_chunkPosition);
+  memcpy(buffer, m_chunk.c_str() + m_chunkPosition, length);
+  m_chunkPosition += length;
+
+  return static_cast<ssize_t>(length);
+}
+
+void CHTTPJsonRpcHandler::CResponseProducer::Process()
+{
+  bool success = m_jsonpCallback.empty() || (Push(m_jsonpCallback.c_str(), m_jsonpCallback.size()) && Push("(", 1));
+
+  if (success)
+  {
+    CJSONStreamWriter writer([this](const char *data, size_t size) { return Push(data, size); },
+                             g_advancedSettings.m_jsonOutputCompact, HTTP_STREAM_CHUNK_SIZE);
+    success = JSONRPC::CJSONRPC::MethodCall(m_request, &m_transportLayer, &m_client, writer);
+  }
+
+  if (success && !m_jsonpCallback.empty())
+    success = Push(");", 2);
+
+  CSingleLock lock(m_critSection);
+  m_done = true;
+  m_failed = !success;
+  m_chunkQueued.Set();
+}
+
+bool CHTTPJsonRpcHandler::CResponseProducer::Push(const char *data, size_t size)
+{
+  while (!m_bStop)
+  {
+    {
+      CSingleLock lock(m_critSection);
+      if (m_chunks.size() < MAX_HTTP_STREAM_CHUNKS)
+      {
+        m_chunks.emplace_back(data, size);
+        m_chunkQueued.Set();
+        return true;
+      }
+    }
+
+    // wait until the client has read a chunk
+    AbortableWait(m_chunkRead);
+  }
+
+  return false;
+}
@@ -19,11 +19,17 @@
  *
  */
 
+#include <deque>
+#include <memory>
 #include <string>
 
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/Variant.h"
 
 class CHTTPJsonRpcHandler : public IHTTPRequestHandler
 {
@@ -38,6 +44,7 @@ public:
   int HandleRequest() override;
 
   HttpResponseRanges GetResponseData() const override;
+  ssize_t ReadResponseData(char *buffer, size_t size) override;
 
   int GetPriority() const override { return 5; }
 
@@ -79,4 +86,42 @@ private:
   private:
     int m_permissionFlags;
   };
+
+  /*!
+   * \brief Handles a streamable request on its own thread and queues the
+   * response in chunks while it is being written, until they are read by
+   * ReadResponseData(). When the queue is full the method call waits.
+   */
+  class CResponseProducer : protected CThread
+  {
+  public:
+    CResponseProducer(const CVariant &request, HTTPMethod method, const std::string &jsonpCallback);
+    ~CResponseProducer() override;
+
+    void Start();
+    ssize_t Read(char *buffer, size_t size);
+
+  protected:
+    void Process() override;
+
+  private:
+    bool Push(const char *data, size_t size);
+
+    CVariant m_request;
+    CHTTPTransportLayer m_transportLayer;
+    CHTTPClient m_client;
+    std::string m_jsonpCallback;
+
+    CCriticalSection m_critSection;
+    std::deque<std::string> m_chunks;
+    bool m_done = false;
+    bool m_failed = false;
+    CEvent m_chunkQueued;
+    CEvent m_chunkRead;
+
+    // the chunk which is being read
+    std::string m_chunk;
+    size_t m_chunkPosition = 0;
+  };
+  std::unique_ptr<CResponseProducer> m_responseProducer;
 };
@@ -21,6 +21,7 @@
 #include <algorithm>
 
 #include "Picture.h"
+#include "PictureScaler.h"
 #include "URL.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -35,10 +36,6 @@
 #include "cores/omxplayer/OMXImage.h"
 #endif
 
-extern "C" {
-#include "libswscale/swscale.h"
-}
-
 using namespace XFILE;
 
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
@@ -340,22 +337,14 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
                           uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
                           CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext *context = sws_getContext(in_width, in_height, AV_PIX_FMT_BGRA,
-                                                         out_width, out_height, AV_PIX_FMT_BGRA,
-                                                         CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
-
   uint8_t *src[] = { in_pixels, 0, 0, 0 };
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
   uint8_t *dst[] = { out_pixels , 0, 0, 0 };
   int     dstStride[] = { (int)out_pitch, 0, 0, 0 };
 
-  if (context)
-  {
-    sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
-    return true;
-  }
-  return false;
+  return CPictureScaler::Scale(AV_PIX_FMT_BGRA, src, srcStride, in_width, in_height,
+                               AV_PIX_FMT_BGRA, dst, dstStride, out_width, out_height,
+                               CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm));
 }
 
 bool CPicture::OrientateImage(uint32_t *&pixels, unsigned int &width, unsigned int &height, int orientation)
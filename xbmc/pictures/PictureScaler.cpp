@@ -0,0 +1,358 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PictureScaler.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <list>
+#include <vector>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+  #define HAS_SCALER_SSE2
+  #include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define HAS_SCALER_NEON
+  #include <arm_neon.h>
+#endif
+
+extern "C" {
+#include "libswscale/swscale.h"
+}
+
+namespace
+{
+
+// contexts are kept per geometry, thumbnail extraction during a scan mostly reuses a handful
+const unsigned int MAX_POOLED_CONTEXTS = 8;
+
+struct ScalerKey
+{
+  AVPixelFormat srcFormat;
+  unsigned int srcWidth;
+  unsigned int srcHeight;
+  AVPixelFormat dstFormat;
+  unsigned int dstWidth;
+  unsigned int dstHeight;
+  int flags;
+
+  bool operator==(const ScalerKey &rhs) const
+  {
+    return srcFormat == rhs.srcFormat && srcWidth == rhs.srcWidth && srcHeight == rhs.srcHeight &&
+           dstFormat == rhs.dstFormat && dstWidth == rhs.dstWidth && dstHeight == rhs.dstHeight &&
+           flags == rhs.flags;
+  }
+};
+
+class CContextPool
+{
+public:
+  ~CContextPool()
+  {
+    Flush();
+  }
+
+  SwsContext* Acquire(const ScalerKey &key)
+  {
+    {
+      CSingleLock lock(m_section);
+      for (auto it = m_contexts.begin(); it != m_contexts.end(); ++it)
+      {
+        if (it->first == key)
+        {
+          SwsContext *context = it->second;
+          m_contexts.erase(it);
+          return context;
+        }
+      }
+    }
+
+    return sws_getContext(key.srcWidth, key.srcHeight, key.srcFormat,
+                          key.dstWidth, key.dstHeight, key.dstFormat,
+                          key.flags, nullptr, nullptr, nullptr);
+  }
+
+  void Release(const ScalerKey &key, SwsContext *context)
+  {
+    SwsContext *evicted = nullptr;
+    {
+      CSingleLock lock(m_section);
+      m_contexts.push_front(std::make_pair(key, context));
+      if (m_contexts.size() > MAX_POOLED_CONTEXTS)
+      {
+        evicted = m_contexts.back().second;
+        m_contexts.pop_back();
+      }
+    }
+    if (evicted)
+      sws_freeContext(evicted);
+  }
+
+  void Flush()
+  {
+    std::list<std::pair<ScalerKey, SwsContext*>> contexts;
+    {
+      CSingleLock lock(m_section);
+      contexts.swap(m_contexts);
+    }
+    for (auto &context : contexts)
+      sws_freeContext(context.second);
+  }
+
+  unsigned int Size()
+  {
+    CSingleLock lock(m_section);
+    return m_contexts.size();
+  }
+
+private:
+  CCriticalSection m_section;
+  // most recently released first
+  std::list<std::pair<ScalerKey, SwsContext*>> m_contexts;
+};
+
+CContextPool& GetContextPool()
+{
+  static CContextPool pool;
+  return pool;
+}
+
+inline uint8_t Average(uint8_t a, uint8_t b)
+{
+  return (a + b + 1) >> 1;
+}
+
+void HalveRow(const uint8_t *top, const uint8_t *bottom, uint8_t *out,
+              unsigned int x, unsigned int width, unsigned int components)
+{
+  unsigned int outWidth = (width + 1) / 2;
+  for (; x < outWidth; ++x)
+  {
+    unsigned int left = 2 * x * components;
+    unsigned int right = (2 * x + 1 < width) ? left + components : left;
+    for (unsigned int c = 0; c < components; ++c)
+    {
+      out[x * components + c] = Average(Average(top[left + c], bottom[left + c]),
+                                        Average(top[right + c], bottom[right + c]));
+    }
+  }
+}
+
+#if defined(HAS_SCALER_SSE2)
+/* returns the number of samples done, the caller finishes the row */
+unsigned int HalveRowSSE2(const uint8_t *top, const uint8_t *bottom, uint8_t *out,
+                          unsigned int width, unsigned int components)
+{
+  unsigned int x = 0;
+  if (components == 1)
+  {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (; (x + 16) * 2 <= width; x += 16)
+    {
+      __m128i v0 = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(top + 2 * x)),
+                                _mm_loadu_si128((const __m128i*)(bottom + 2 * x)));
+      __m128i v1 = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(top + 2 * x + 16)),
+                                _mm_loadu_si128((const __m128i*)(bottom + 2 * x + 16)));
+      __m128i h0 = _mm_avg_epu16(_mm_and_si128(v0, mask), _mm_srli_epi16(v0, 8));
+      __m128i h1 = _mm_avg_epu16(_mm_and_si128(v1, mask), _mm_srli_epi16(v1, 8));
+      _mm_storeu_si128((__m128i*)(out + x), _mm_packus_epi16(h0, h1));
+    }
+  }
+  else if (components == 2)
+  {
+    const __m128i mask = _mm_set1_epi32(0x0000FFFF);
+    for (; (x + 8) * 2 <= width; x += 8)
+    {
+      __m128i v0 = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(top + 4 * x)),
+                                _mm_loadu_si128((const __m128i*)(bottom + 4 * x)));
+      __m128i v1 = _mm_avg_epu8(_mm_loadu_si128((const __m128i*)(top + 4 * x + 16)),
+                                _mm_loadu_si128((const __m128i*)(bottom + 4 * x + 16)));
+      // each 32 bit lane holds two pairs, average them into the low half
+      __m128i h0 = _mm_avg_epu8(_mm_and_si128(v0, mask), _mm_srli_epi32(v0, 16));
+      __m128i h1 = _mm_avg_epu8(_mm_and_si128(v1, mask), _mm_srli_epi32(v1, 16));
+      // gather the four pairs of each register into its low 64 bits
+      h0 = _mm_shufflelo_epi16(h0, _MM_SHUFFLE(3, 1, 2, 0));
+      h0 = _mm_shufflehi_epi16(h0, _MM_SHUFFLE(3, 1, 2, 0));
+      h0 = _mm_shuffle_epi32(h0, _MM_SHUFFLE(3, 1, 2, 0));
+      h1 = _mm_shufflelo_epi16(h1, _MM_SHUFFLE(3, 1, 2, 0));
+      h1 = _mm_shufflehi_epi16(h1, _MM_SHUFFLE(3, 1, 2, 0));
+      h1 = _mm_shuffle_epi32(h1, _MM_SHUFFLE(3, 1, 2, 0));
+      _mm_storeu_si128((__m128i*)(out + 2 * x), _mm_unpacklo_epi64(h0, h1));
+    }
+  }
+  return x;
+}
+#endif
+
+#if defined(HAS_SCALER_NEON)
+unsigned int HalveRowNEON(const uint8_t *top, const uint8_t *bottom, uint8_t *out,
+                          unsigned int width, unsigned int components)
+{
+  unsigned int x = 0;
+  if (components == 1)
+  {
+    for (; (x + 16) * 2 <= width; x += 16)
+    {
+      uint8x16x2_t t = vld2q_u8(top + 2 * x);
+      uint8x16x2_t b = vld2q_u8(bottom + 2 * x);
+      vst1q_u8(out + x, vrhaddq_u8(vrhaddq_u8(t.val[0], b.val[0]), vrhaddq_u8(t.val[1], b.val[1])));
+    }
+  }
+  else if (components == 2)
+  {
+    for (; (x + 16) * 2 <= width; x += 16)
+    {
+      uint8x16x4_t t = vld4q_u8(top + 4 * x);
+      uint8x16x4_t b = vld4q_u8(bottom + 4 * x);
+      uint8x16x2_t r;
+      r.val[0] = vrhaddq_u8(vrhaddq_u8(t.val[0], b.val[0]), vrhaddq_u8(t.val[2], b.val[2]));
+      r.val[1] = vrhaddq_u8(vrhaddq_u8(t.val[1], b.val[1]), vrhaddq_u8(t.val[3], b.val[3]));
+      vst2q_u8(out + 2 * x, r);
+    }
+  }
+  return x;
+}
+#endif
+
+/* number of planes the box filter reduces, 0 if the format is left to swscale */
+int ReducedPlanes(AVPixelFormat format)
+{
+  switch (format)
+  {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+      return 3;
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_NV21:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+bool ScaleWithContext(AVPixelFormat srcFormat, const uint8_t* const src[], const int srcStride[],
+                      unsigned int srcWidth, unsigned int srcHeight,
+                      AVPixelFormat dstFormat, uint8_t* const dst[], const int dstStride[],
+                      unsigned int dstWidth, unsigned int dstHeight, int flags)
+{
+  ScalerKey key = { srcFormat, srcWidth, srcHeight, dstFormat, dstWidth, dstHeight, flags };
+  CContextPool &pool = GetContextPool();
+  SwsContext *context = pool.Acquire(key);
+  if (!context)
+    return false;
+
+  sws_scale(context, src, srcStride, 0, srcHeight, dst, dstStride);
+  pool.Release(key, context);
+  return true;
+}
+
+}
+
+bool CPictureScaler::Scale(AVPixelFormat srcFormat, uint8_t* const src[], const int srcStride[],
+                           unsigned int srcWidth, unsigned int srcHeight,
+                           AVPixelFormat dstFormat, uint8_t* const dst[], const int dstStride[],
+                           unsigned int dstWidth, unsigned int dstHeight, int flags)
+{
+  if (!dstWidth || !dstHeight)
+    return false;
+
+  int planes = ReducedPlanes(srcFormat);
+  if (!(flags & SWS_FAST_BILINEAR) || !planes ||
+      srcWidth < 2 * dstWidth || srcHeight < 2 * dstHeight)
+  {
+    return ScaleWithContext(srcFormat, src, srcStride, srcWidth, srcHeight,
+                            dstFormat, dst, dstStride, dstWidth, dstHeight, flags);
+  }
+
+  // the first pass reads the source, further passes halve the buffer in place
+  unsigned int components = (planes == 2) ? 2 : 1;
+  unsigned int width = (srcWidth + 1) / 2;
+  unsigned int height = (srcHeight + 1) / 2;
+  unsigned int chromaWidth = (width + 1) / 2;
+  unsigned int chromaHeight = (height + 1) / 2;
+  int stride[4] = { 0, 0, 0, 0 };
+  stride[0] = (width + 15) & ~15;
+  for (int i = 1; i < planes; i++)
+    stride[i] = (chromaWidth * components + 15) & ~15;
+
+  std::vector<uint8_t> buffer(stride[0] * height + (planes - 1) * stride[1] * chromaHeight);
+  uint8_t *reduced[4] = { buffer.data(), nullptr, nullptr, nullptr };
+  for (int i = 1; i < planes; i++)
+    reduced[i] = reduced[i - 1] + stride[i - 1] * (i == 1 ? height : chromaHeight);
+
+  HalvePlane(src[0], srcStride[0], srcWidth, srcHeight, reduced[0], stride[0], 1);
+  for (int i = 1; i < planes; i++)
+    HalvePlane(src[i], srcStride[i], (srcWidth + 1) / 2, (srcHeight + 1) / 2, reduced[i], stride[i], components);
+
+  while (width >= 2 * dstWidth && height >= 2 * dstHeight)
+  {
+    HalvePlane(reduced[0], stride[0], width, height, reduced[0], stride[0], 1);
+    for (int i = 1; i < planes; i++)
+      HalvePlane(reduced[i], stride[i], (width + 1) / 2, (height + 1) / 2, reduced[i], stride[i], components);
+    width = (width + 1) / 2;
+    height = (height + 1) / 2;
+  }
+
+  return ScaleWithContext(srcFormat, reduced, stride, width, height,
+                          dstFormat, dst, dstStride, dstWidth, dstHeight, flags);
+}
+
+void CPictureScaler::HalvePlane(const uint8_t *src, int srcStride, unsigned int width, unsigned int height,
+                                uint8_t *dst, int dstStride, unsigned int components)
+{
+  unsigned int outHeight = (height + 1) / 2;
+  for (unsigned int y = 0; y < outHeight; ++y)
+  {
+    const uint8_t *top = src + static_cast<ptrdiff_t>(2 * y) * srcStride;
+    const uint8_t *bottom = (2 * y + 1 < height) ? top + srcStride : top;
+    uint8_t *out = dst + static_cast<ptrdiff_t>(y) * dstStride;
+    unsigned int x = 0;
+#if defined(HAS_SCALER_SSE2)
+    x = HalveRowSSE2(top, bottom, out, width, components);
+#elif defined(HAS_SCALER_NEON)
+    x = HalveRowNEON(top, bottom, out, width, components);
+#endif
+    HalveRow(top, bottom, out, x, width, components);
+  }
+}
+
+void CPictureScaler::HalvePlaneGeneric(const uint8_t *src, int srcStride, unsigned int width, unsigned int height,
+                                       uint8_t *dst, int dstStride, unsigned int components)
+{
+  unsigned int outHeight = (height + 1) / 2;
+  for (unsigned int y = 0; y < outHeight; ++y)
+  {
+    const uint8_t *top = src + static_cast<ptrdiff_t>(2 * y) * srcStride;
+    const uint8_t *bottom = (2 * y + 1 < height) ? top + srcStride : top;
+    HalveRow(top, bottom, dst + static_cast<ptrdiff_t>(y) * dstStride, 0, width, components);
+  }
+}
+
+void CPictureScaler::FlushContexts()
+{
+  GetContextPool().Flush();
+}
+
+unsigned int CPictureScaler::GetPooledContexts()
+{
+  return GetContextPool().Size();
+}
@@ -0,0 +1,69 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+
+extern "C" {
+#include "libavutil/pixfmt.h"
+}
+
+/*! \brief Scaling and pixel format conversion for thumbnails and cached images
+ swscale contexts are costly to set up, so they are kept in a small pool keyed
+ by formats, sizes and flags and reused by later calls with the same geometry.
+ Fast bilinear down-scales of YUV420P and NV12 sources by at least a factor of
+ two first reduce the planes with a 2x2 box filter, leaving swscale a much
+ smaller image to convert.
+ */
+class CPictureScaler
+{
+public:
+  /*! \brief Scale and convert an image
+   \param srcFormat pixel format of the source planes
+   \param src source planes
+   \param srcStride line size of each source plane
+   \param dstFormat pixel format of the destination planes
+   \param dst destination planes
+   \param dstStride line size of each destination plane
+   \param flags swscale flags, e.g. SWS_FAST_BILINEAR
+   \return true if successful, false if no context could be created
+   */
+  static bool Scale(AVPixelFormat srcFormat, uint8_t* const src[], const int srcStride[],
+                    unsigned int srcWidth, unsigned int srcHeight,
+                    AVPixelFormat dstFormat, uint8_t* const dst[], const int dstStride[],
+                    unsigned int dstWidth, unsigned int dstHeight, int flags);
+
+  /*! \brief Halve a plane of 8 bit samples with a 2x2 box filter
+   The result is (width + 1) / 2 by (height + 1) / 2, odd edges repeat their last
+   sample. Each output sample is the rounded average of the rounded vertical
+   averages, which matches what the SIMD average instructions produce. Halving
+   in place with dst == src is allowed.
+   \param width samples per line, in units of components
+   \param components interleaved components per sample, 1 for planar and 2 for NV12 chroma
+   */
+  static void HalvePlane(const uint8_t *src, int srcStride, unsigned int width, unsigned int height,
+                         uint8_t *dst, int dstStride, unsigned int components);
+  static void HalvePlaneGeneric(const uint8_t *src, int srcStride, unsigned int width, unsigned int height,
+                                uint8_t *dst, int dstStride, unsigned int components);
+
+  /*! \brief Free all pooled contexts */
+  static void FlushContexts();
+  static unsigned int GetPooledContexts();
+};
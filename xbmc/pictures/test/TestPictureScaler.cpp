@@ -0,0 +1,128 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "pictures/PictureScaler.h"
+
+#include <vector>
+
+extern "C" {
+#include "libswscale/swscale.h"
+}
+
+#include "gtest/gtest.h"
+
+namespace
+{
+std::vector<uint8_t> CreatePlane(unsigned int width, unsigned int height, int stride)
+{
+  std::vector<uint8_t> plane(stride * height);
+  for (size_t i = 0; i < plane.size(); ++i)
+    plane[i] = static_cast<uint8_t>((i * 37 + (i >> 5) * 11) & 0xFF);
+  return plane;
+}
+}
+
+TEST(TestPictureScaler, HalvePlaneAverages)
+{
+  const uint8_t src[] = { 0, 255, 10,
+                          1, 100, 20 };
+  uint8_t dst[2];
+  CPictureScaler::HalvePlane(src, 3, 3, 2, dst, 2, 1);
+  // the rounded average of the rounded column averages 1 and 178, the odd column repeats itself
+  EXPECT_EQ(90, dst[0]);
+  EXPECT_EQ(15, dst[1]);
+}
+
+TEST(TestPictureScaler, HalvePlaneMatchesGeneric)
+{
+  for (unsigned int components = 1; components <= 2; ++components)
+  {
+    for (unsigned int width : { 1u, 15u, 16u, 33u, 67u, 100u, 257u })
+    {
+      for (unsigned int height : { 1u, 2u, 7u, 10u })
+      {
+        int stride = width * components + 5;
+        std::vector<uint8_t> src = CreatePlane(width, height, stride);
+        int outStride = (width + 1) / 2 * components;
+        std::vector<uint8_t> expected(outStride * ((height + 1) / 2));
+        std::vector<uint8_t> result(expected.size());
+
+        CPictureScaler::HalvePlaneGeneric(src.data(), stride, width, height, expected.data(), outStride, components);
+        CPictureScaler::HalvePlane(src.data(), stride, width, height, result.data(), outStride, components);
+        EXPECT_EQ(expected, result) << "width " << width << " height " << height << " components " << components;
+
+        // in place
+        CPictureScaler::HalvePlane(src.data(), stride, width, height, src.data(), stride, components);
+        for (unsigned int y = 0; y < (height + 1) / 2; ++y)
+        {
+          for (int x = 0; x < outStride; ++x)
+            ASSERT_EQ(expected[y * outStride + x], src[y * stride + x]);
+        }
+      }
+    }
+  }
+}
+
+TEST(TestPictureScaler, ReusesContexts)
+{
+  CPictureScaler::FlushContexts();
+
+  std::vector<uint8_t> in(64 * 64 * 4, 0x80);
+  std::vector<uint8_t> out(32 * 32 * 4);
+  uint8_t *src[] = { in.data(), nullptr, nullptr, nullptr };
+  int srcStride[] = { 64 * 4, 0, 0, 0 };
+  uint8_t *dst[] = { out.data(), nullptr, nullptr, nullptr };
+  int dstStride[] = { 32 * 4, 0, 0, 0 };
+
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(CPictureScaler::Scale(AV_PIX_FMT_BGRA, src, srcStride, 64, 64,
+                                      AV_PIX_FMT_BGRA, dst, dstStride, 32, 32, SWS_BICUBIC));
+    EXPECT_EQ(1u, CPictureScaler::GetPooledContexts());
+  }
+
+  CPictureScaler::FlushContexts();
+  EXPECT_EQ(0u, CPictureScaler::GetPooledContexts());
+}
+
+TEST(TestPictureScaler, ReducesYUV420P)
+{
+  const unsigned int width = 321, height = 241;
+  std::vector<uint8_t> luma(width * height, 0x80);
+  std::vector<uint8_t> chroma((width + 1) / 2 * ((height + 1) / 2), 0x80);
+  std::vector<uint8_t> out(40 * 30 * 4);
+  uint8_t *src[] = { luma.data(), chroma.data(), chroma.data(), nullptr };
+  int srcStride[] = { (int)width, (int)(width + 1) / 2, (int)(width + 1) / 2, 0 };
+  uint8_t *dst[] = { out.data(), nullptr, nullptr, nullptr };
+  int dstStride[] = { 40 * 4, 0, 0, 0 };
+
+  EXPECT_TRUE(CPictureScaler::Scale(AV_PIX_FMT_YUV420P, src, srcStride, width, height,
+                                    AV_PIX_FMT_BGRA, dst, dstStride, 40, 30, SWS_FAST_BILINEAR));
+
+  // a flat grey picture stays flat grey
+  for (size_t i = 0; i < out.size(); i += 4)
+  {
+    EXPECT_NEAR(out[i], out[i + 1], 2);
+    EXPECT_NEAR(out[i + 1], out[i + 2], 2);
+    EXPECT_NEAR(out[0], out[i], 2);
+  }
+
+  CPictureScaler::FlushContexts();
+}
@@ -128,6 +128,7 @@ void CAdvancedSettings::Initialize()
   m_videoSubsDelayRange = 60;
   m_videoAudioDelayRange = 10;
   m_videoUseTimeSeeking = true;
+  m_videoSeekIndex = true;
   m_videoTimeSeekForward = 30;
   m_videoTimeSeekBackward = -30;
   m_videoTimeSeekForwardBig = 600;
@@ -282,6 +283,8 @@ void CAdvancedSettings::Initialize()
   m_bMusicLibraryCleanOnUpdate = false;
   m_bMusicLibraryArtistSortOnUpdate = false;
   m_iMusicLibraryRecentlyAddedItems = 25;
+  m_iMusicLibraryScanBatchItems = 100;
+  m_iMusicLibraryScanBatchTime = 5000;
   m_strMusicLibraryAlbumFormat = "";
   m_prioritiseAPEv2tags = false;
   m_musicUseArtistSortName = false;
@@ -297,6 +300,8 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
+  m_iVideoLibraryScanBatchItems = 50;
+  m_iVideoLibraryScanBatchTime = 5000;
   m_bVideoScannerIgnoreErrors = false;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
@@ -366,6 +371,10 @@ void CAdvancedSettings::Initialize()
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  m_cacheAdaptive = false;
+  m_cacheTargetDuration = 30;
+  m_bDirectoryCachePersist = false;
+  m_iDirectoryCachePersistDays = 30;
 
   m_addonPackageFolderSize = 200;
 
@@ -378,6 +387,8 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiSkinCache = true;
+  m_guiSkipHiddenLayouts = true;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -557,6 +568,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "ignorepercentatend", m_videoIgnorePercentAtEnd, 0, 100.0f);
 
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_videoUseTimeSeeking);
+    XMLUtils::GetBoolean(pElement, "seekindex", m_videoSeekIndex);
     XMLUtils::GetInt(pElement, "timeseekforward", m_videoTimeSeekForward, 0, 6000);
     XMLUtils::GetInt(pElement, "timeseekbackward", m_videoTimeSeekBackward, -6000, 0);
     XMLUtils::GetInt(pElement, "timeseekforwardbig", m_videoTimeSeekForwardBig, 0, 6000);
@@ -740,6 +752,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "scanbatchitems", m_iMusicLibraryScanBatchItems, 0, INT_MAX);
+    XMLUtils::GetInt(pElement, "scanbatchtime", m_iMusicLibraryScanBatchTime, 0, INT_MAX);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -793,6 +807,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
     XMLUtils::GetBoolean(pElement, "importresumepoint", m_bVideoLibraryImportResumePoint);
     XMLUtils::GetInt(pElement, "dateadded", m_iVideoLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "scanbatchitems", m_iVideoLibraryScanBatchItems, 0, INT_MAX);
+    XMLUtils::GetInt(pElement, "scanbatchtime", m_iVideoLibraryScanBatchTime, 0, INT_MAX);
   }
 
   pElement = pRootElement->FirstChildElement("videoscanner");
@@ -830,6 +846,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "memorysize", m_cacheMemSize);
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetBoolean(pElement, "adaptive", m_cacheAdaptive);
+    XMLUtils::GetUInt(pElement, "targetduration", m_cacheTargetDuration, 5, 600);
+    XMLUtils::GetBoolean(pElement, "persistdirectories", m_bDirectoryCachePersist);
+    XMLUtils::GetUInt(pElement, "persistdirectorydays", m_iDirectoryCachePersistDays, 1, 365);
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -1205,6 +1225,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "skincache", m_guiSkinCache);
+    XMLUtils::GetBoolean(pElement, "skiphiddenlayouts", m_guiSkipHiddenLayouts);
   }
 
   std::string seekSteps;
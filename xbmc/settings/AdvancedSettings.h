@@ -148,6 +148,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_videoSubsDelayRange;
     float m_videoAudioDelayRange;
     bool m_videoUseTimeSeeking;
+    bool m_videoSeekIndex; ///< keep keyframe indexes of local mkv/ts files in the thumbnail cache
     int m_videoTimeSeekForward;
     int m_videoTimeSeekBackward;
     int m_videoTimeSeekForwardBig;
@@ -261,6 +262,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
+    int m_iMusicLibraryScanBatchItems;
+    int m_iMusicLibraryScanBatchTime; // ms
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
     std::string m_musicItemSeparator;
@@ -276,6 +279,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
     bool m_bVideoLibraryImportResumePoint;
+    int m_iVideoLibraryScanBatchItems;
+    int m_iVideoLibraryScanBatchTime; // ms
 
     bool m_bVideoScannerIgnoreErrors;
     int m_iVideoLibraryDateAdded;
@@ -345,11 +350,17 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiSkinCache;
+    bool m_guiSkipHiddenLayouts;
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     float m_cacheReadFactor;
+    bool m_cacheAdaptive; ///< size the cache from measured stream and link rates instead of memorysize/readfactor
+    unsigned int m_cacheTargetDuration; ///< seconds of playback the adaptive cache tries to keep buffered
+    bool m_bDirectoryCachePersist;
+    unsigned int m_iDirectoryCachePersistDays;
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
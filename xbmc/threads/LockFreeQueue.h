@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ \brief Bounded queue which can be used from several threads without locking.
+
+ Based on the sequence numbered ring buffer by Dmitry Vyukov. Any number of
+ threads may push, popping has to be serialized by the caller (e.g. only done
+ by one consumer thread or while holding a lock). Push() and Pop() never
+ allocate, the capacity is rounded up to the next power of two.
+ */
+template<typename T>
+class CLockFreeQueue
+{
+public:
+  explicit CLockFreeQueue(size_t capacity)
+    : m_mask(RoundUp(capacity) - 1),
+      m_cells(new Cell[m_mask + 1]),
+      m_enqueuePos(0),
+      m_dequeuePos(0)
+  {
+    for (size_t i = 0; i <= m_mask; i++)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Appends the given value.
+   \return False if the queue is full
+   */
+  bool Push(const T &value)
+  {
+    Cell *cell;
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell = &m_cells[pos & m_mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0)
+      {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;
+      else
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   \brief Removes the oldest value.
+   \return False if the queue is empty
+   */
+  bool Pop(T &value)
+  {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell = &m_cells[pos & m_mask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0)
+      return false;
+
+    value = cell->value;
+    cell->value = T();
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  size_t Capacity() const { return m_mask + 1; }
+
+private:
+  CLockFreeQueue(const CLockFreeQueue&) = delete;
+  CLockFreeQueue& operator=(const CLockFreeQueue&) = delete;
+
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static size_t RoundUp(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    return size;
+  }
+
+  const size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+
+  // keep the producer and consumer positions on separate cache lines
+  char m_pad0[64];
+  std::atomic<size_t> m_enqueuePos;
+  char m_pad1[64];
+  std::atomic<size_t> m_dequeuePos;
+};
@@ -0,0 +1,87 @@
+/*
+ *      Copyright (C) 2005-2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/LockFreeQueue.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(TestLockFreeQueue, PushPop)
+{
+  CLockFreeQueue<int> queue(3);
+  EXPECT_EQ(4U, queue.Capacity());
+
+  int value = 0;
+  EXPECT_FALSE(queue.Pop(value));
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(queue.Push(i));
+  EXPECT_FALSE(queue.Push(4));
+
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(queue.Pop(value));
+}
+
+TEST(TestLockFreeQueue, MultipleProducers)
+{
+  const int producers = 4;
+  const int count = 10000;
+  CLockFreeQueue<int> queue(64);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+  {
+    threads.push_back(std::thread([&queue, p, count]()
+    {
+      for (int i = 0; i < count; i++)
+      {
+        while (!queue.Push(p * count + i))
+          std::this_thread::yield();
+      }
+    }));
+  }
+
+  // values of every single producer have to arrive in order
+  std::vector<int> last(producers, -1);
+  int received = 0;
+  while (received < producers * count)
+  {
+    int value;
+    if (!queue.Pop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    int producer = value / count;
+    EXPECT_LT(last[producer], value % count);
+    last[producer] = value % count;
+    received++;
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+}
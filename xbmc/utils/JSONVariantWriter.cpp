@@ -102,3 +102,164 @@ bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool
   output = stringBuffer.GetString();
   return true;
 }
+
+namespace
+{
+  // rapidjson output stream which passes the serialized data on in chunks
+  class CJSONOutputStream
+  {
+  public:
+    typedef char Ch;
+
+    CJSONOutputStream(const CJSONStreamWriter::Output &output, size_t bufferSize)
+      : m_output(output),
+        m_bufferSize(bufferSize > 0 ? bufferSize : 1)
+    {
+      m_buffer.reserve(m_bufferSize);
+    }
+
+    void Put(Ch c)
+    {
+      if (m_failed)
+        return;
+
+      m_buffer.push_back(c);
+      if (m_buffer.size() >= m_bufferSize)
+        Flush();
+    }
+
+    void Flush()
+    {
+      if (!m_failed && !m_buffer.empty() && !m_output(m_buffer.data(), m_buffer.size()))
+        m_failed = true;
+
+      m_buffer.clear();
+    }
+
+    bool HasFailed() const { return m_failed; }
+
+  private:
+    CJSONStreamWriter::Output m_output;
+    size_t m_bufferSize;
+    std::string m_buffer;
+    bool m_failed = false;
+  };
+}
+
+class CJSONStreamWriter::IWriter
+{
+public:
+  virtual ~IWriter() = default;
+
+  virtual bool StartObject() = 0;
+  virtual bool EndObject() = 0;
+  virtual bool StartArray() = 0;
+  virtual bool EndArray() = 0;
+  virtual bool Key(const std::string &key) = 0;
+  virtual bool Write(const CVariant &value) = 0;
+  virtual bool Flush() = 0;
+  virtual bool IsComplete() const = 0;
+  virtual bool HasFailed() const = 0;
+};
+
+template<class TWriter>
+class CJSONStreamWriter::CWriter : public CJSONStreamWriter::IWriter
+{
+public:
+  CWriter(const Output &output, size_t bufferSize)
+    : m_stream(output, bufferSize),
+      m_writer(m_stream)
+  { }
+
+  TWriter& GetWriter() { return m_writer; }
+
+  bool StartObject() override { return Check(m_writer.StartObject()); }
+  bool EndObject() override { return Check(m_writer.EndObject()); }
+  bool StartArray() override { return Check(m_writer.StartArray()); }
+  bool EndArray() override { return Check(m_writer.EndArray()); }
+  bool Key(const std::string &key) override { return Check(m_writer.Key(key.c_str(), key.size())); }
+  bool Write(const CVariant &value) override { return Check(InternalWrite(m_writer, value)); }
+
+  bool Flush() override
+  {
+    if (!m_failed)
+      m_stream.Flush();
+
+    return !HasFailed();
+  }
+
+  bool IsComplete() const override { return !HasFailed() && m_writer.IsComplete(); }
+  bool HasFailed() const override { return m_failed || m_stream.HasFailed(); }
+
+private:
+  bool Check(bool result)
+  {
+    if (!result)
+      m_failed = true;
+
+    return !HasFailed();
+  }
+
+  CJSONOutputStream m_stream;
+  TWriter m_writer;
+  bool m_failed = false;
+};
+
+CJSONStreamWriter::CJSONStreamWriter(Output output, bool compact, size_t bufferSize /* = 32 * 1024 */)
+{
+  if (compact)
+    m_writer.reset(new CWriter<rapidjson::Writer<CJSONOutputStream>>(output, bufferSize));
+  else
+  {
+    CWriter<rapidjson::PrettyWriter<CJSONOutputStream>> *writer = new CWriter<rapidjson::PrettyWriter<CJSONOutputStream>>(output, bufferSize);
+    writer->GetWriter().SetIndent('\t', 1);
+    m_writer.reset(writer);
+  }
+}
+
+CJSONStreamWriter::~CJSONStreamWriter() = default;
+
+bool CJSONStreamWriter::StartObject()
+{
+  return !HasFailed() && m_writer->StartObject();
+}
+
+bool CJSONStreamWriter::EndObject()
+{
+  return !HasFailed() && m_writer->EndObject();
+}
+
+bool CJSONStreamWriter::StartArray()
+{
+  return !HasFailed() && m_writer->StartArray();
+}
+
+bool CJSONStreamWriter::EndArray()
+{
+  return !HasFailed() && m_writer->EndArray();
+}
+
+bool CJSONStreamWriter::Key(const std::string &key)
+{
+  return !HasFailed() && m_writer->Key(key);
+}
+
+bool CJSONStreamWriter::Write(const CVariant &value)
+{
+  return !HasFailed() && m_writer->Write(value);
+}
+
+bool CJSONStreamWriter::Flush()
+{
+  return m_writer->Flush();
+}
+
+bool CJSONStreamWriter::IsComplete() const
+{
+  return m_writer->IsComplete();
+}
+
+bool CJSONStreamWriter::HasFailed() const
+{
+  return m_writer->HasFailed();
+}
@@ -19,6 +19,8 @@
  *
  */
 
+#include <functional>
+#include <memory>
 #include <string>
 
 class CVariant;
@@ -30,3 +32,41 @@ public:
 
   static bool Write(const CVariant &value, std::string& output, bool compact);
 };
+
+/*!
+ \brief Writes JSON incrementally and hands it to an output in chunks
+
+ The document is built with StartObject()/Key()/Write()/EndObject() etc.
+ Serialized data is collected until bufferSize bytes are available or the
+ document is complete and is then passed to the output. If the output
+ returns false the writer fails and ignores everything written afterwards.
+ */
+class CJSONStreamWriter
+{
+public:
+  typedef std::function<bool(const char *data, size_t size)> Output;
+
+  CJSONStreamWriter(Output output, bool compact, size_t bufferSize = 32 * 1024);
+  ~CJSONStreamWriter();
+
+  bool StartObject();
+  bool EndObject();
+  bool StartArray();
+  bool EndArray();
+  bool Key(const std::string &key);
+  bool Write(const CVariant &value);
+
+  /*!
+   \brief Passes all buffered data to the output
+   */
+  bool Flush();
+
+  bool IsComplete() const;
+  bool HasFailed() const;
+
+private:
+  class IWriter;
+  template<class TWriter> class CWriter;
+
+  std::unique_ptr<IWriter> m_writer;
+};
@@ -23,12 +23,15 @@
 #include "URL.h"
 #include "Util.h"
 #include "XBDateTime.h"
+#include "threads/Thread.h"
 #include "utils/CharsetConverter.h"
+#include "utils/CPUInfo.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <memory>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -433,130 +436,312 @@ std::string ByLastUsed(SortAttribute attributes, const SortItem &values)
   return values.at(FieldLastUsed).asString();
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
+namespace
 {
-  // make sure both items have the necessary data to do the sorting
-  SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
+// sort tokens of the sort running on this thread, see CSortTokensScope
+thread_local const std::set<std::string>* currentSortTokens = nullptr;
+
+/*!
+ \brief Fetches the sort tokens once for all items of a sort instead of once
+ per call to SortUtils::RemoveArticles().
+ */
+class CSortTokensScope
+{
+public:
+  CSortTokensScope() : m_tokens(g_langInfo.GetSortTokens()), m_previous(currentSortTokens)
   {
-    result = false;
-    return true;
+    currentSortTokens = &m_tokens;
   }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
+  ~CSortTokensScope()
   {
-    result = true;
-    return true;
+    currentSortTokens = m_previous;
   }
 
-  // look at special sorting behaviour
-  SortItem::const_iterator itLeft, itRight;
-  SortSpecial leftSortSpecial = SortSpecialNone;
-  SortSpecial rightSortSpecial = SortSpecialNone;
-  if ((itLeft = left.find(FieldSortSpecial)) != left.end() && itLeft->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    leftSortSpecial = (SortSpecial)itLeft->second.asInteger();
-  if ((itRight = right.find(FieldSortSpecial)) != right.end() && itRight->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    rightSortSpecial = (SortSpecial)itRight->second.asInteger();
-  
-  // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
-  {
-    // left should be sorted on top
-    // or right should be sorted on bottom
-    // => left is sorted above right
-    if (leftSortSpecial == SortSpecialOnTop ||
-        rightSortSpecial == SortSpecialOnBottom)
-    {
-      result = true;
-      return true;
-    }
-    
-    // otherwise right is sorted above left
-    result = false;
-    return true;
-  }
-  // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecialNone && leftSortSpecial == rightSortSpecial)
+private:
+  CSortTokensScope(const CSortTokensScope&) = delete;
+  CSortTokensScope& operator=(const CSortTokensScope&) = delete;
+
+  const std::set<std::string> m_tokens;
+  const std::set<std::string>* m_previous;
+};
+
+// lists with at least this many items are sorted in parallel
+const size_t PARALLEL_SORT_MIN_ITEMS = 16384;
+// don't split the list into chunks smaller than this
+const size_t PARALLEL_SORT_MIN_CHUNK = 4096;
+const unsigned int PARALLEL_SORT_MAX_THREADS = 4;
+
+/*!
+ \brief The sort keys of all items, extracted into contiguous columns.
+
+ The keys are extracted once per sort, so comparisons only touch these arrays
+ instead of looking up fields in the std::map of every item.
+ */
+struct SortColumns
+{
+  std::vector<std::wstring> labels;
+  std::vector<int64_t> numbers; //!< only filled if every label is a plain number
+  std::vector<std::u32string> keys; //!< collation keys of the labels otherwise
+  std::vector<char> special;    //!< SortSpecial
+  std::vector<char> folder;     //!< 1 folder, 0 file, -1 unknown
+  bool handleFolder = true;
+  bool descending = false;
+};
+
+/*!
+ \brief Check whether the label is a non-negative number with at most 15
+ digits, for which comparing numerically yields the same result as
+ StringUtils::AlphaNumericCompare().
+ */
+bool GetNumber(const std::wstring &label, int64_t &number)
+{
+  if (label.empty() || label.size() > 15)
+    return false;
+
+  number = 0;
+  for (wchar_t c : label)
   {
-    result = false;
-    return true;
+    if (c < L'0' || c > L'9')
+      return false;
+    number = number * 10 + (c - L'0');
   }
+  return true;
+}
+
+class CSortColumnsLess
+{
+public:
+  explicit CSortColumnsLess(const SortColumns &columns) : m_columns(columns) { }
 
-  if (handleFolder)
+  bool operator()(size_t left, size_t right) const
   {
-    itLeft = left.find(FieldFolder);
-    itRight = right.find(FieldFolder);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
+    // look at special sorting behaviour
+    char leftSpecial = m_columns.special[left];
+    char rightSpecial = m_columns.special[right];
+    if (leftSpecial != rightSpecial)
     {
-      result = itLeft->second.asBoolean();
-      return true;
+      // left should be sorted on top
+      // or right should be sorted on bottom
+      // => left is sorted above right
+      return leftSpecial == SortSpecialOnTop || rightSpecial == SortSpecialOnBottom;
     }
-  }
+    // both have either sort on top or sort on bottom -> leave as-is
+    if (leftSpecial != SortSpecialNone)
+      return false;
 
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
+    if (m_columns.handleFolder)
+    {
+      char leftFolder = m_columns.folder[left];
+      char rightFolder = m_columns.folder[right];
+      if (leftFolder >= 0 && rightFolder >= 0 && leftFolder != rightFolder)
+        return leftFolder != 0;
+    }
 
-  return false;
-}
+    if (!m_columns.numbers.empty())
+    {
+      if (m_columns.descending)
+        return m_columns.numbers[left] > m_columns.numbers[right];
+      return m_columns.numbers[left] < m_columns.numbers[right];
+    }
 
-bool SorterAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+    if (m_columns.descending)
+      return m_columns.keys[right] < m_columns.keys[left];
+    return m_columns.keys[left] < m_columns.keys[right];
+  }
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
+private:
+  const SortColumns &m_columns;
+};
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
+class CSortChunkJob : public IRunnable
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+public:
+  CSortChunkJob(std::vector<size_t>::iterator begin, std::vector<size_t>::iterator end, const SortColumns &columns)
+    : m_begin(begin), m_end(end), m_columns(columns) { }
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
+  void Run() override
+  {
+    std::stable_sort(m_begin, m_end, CSortColumnsLess(m_columns));
+  }
 
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+private:
+  std::vector<size_t>::iterator m_begin;
+  std::vector<size_t>::iterator m_end;
+  const SortColumns &m_columns;
+};
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
+/*!
+ \brief Stable sort of the indices by the extracted columns.
 
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
+ Large lists are split into chunks which are sorted on separate threads and
+ merged afterwards. Stable sorting the chunks and merging them in order gives
+ the same result as stable sorting the whole list.
+ */
+void SortIndices(std::vector<size_t> &order, const SortColumns &columns)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  unsigned int chunks = 1;
+  if (order.size() >= PARALLEL_SORT_MIN_ITEMS)
+  {
+    chunks = std::min<unsigned int>(g_cpuInfo.getCPUCount(), PARALLEL_SORT_MAX_THREADS);
+    chunks = std::min<unsigned int>(chunks, order.size() / PARALLEL_SORT_MIN_CHUNK);
+  }
+
+  if (chunks <= 1)
+  {
+    std::stable_sort(order.begin(), order.end(), CSortColumnsLess(columns));
+    return;
+  }
+
+  std::vector<std::vector<size_t>::iterator> bounds;
+  for (unsigned int i = 0; i < chunks; ++i)
+    bounds.push_back(order.begin() + order.size() * i / chunks);
+  bounds.push_back(order.end());
+
+  // the calling thread sorts the first chunk itself
+  std::vector<std::unique_ptr<CSortChunkJob>> jobs;
+  std::vector<std::unique_ptr<CThread>> threads;
+  for (unsigned int i = 1; i < chunks; ++i)
+  {
+    jobs.emplace_back(new CSortChunkJob(bounds[i], bounds[i + 1], columns));
+    threads.emplace_back(new CThread(jobs.back().get(), "SortChunk"));
+    threads.back()->Create();
+  }
+  CSortChunkJob(bounds[0], bounds[1], columns).Run();
+  for (auto &thread : threads)
+    thread->StopThread(true);
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  // merge the sorted chunks, the left one always starts at the beginning
+  for (unsigned int i = 1; i < chunks; ++i)
+    std::inplace_merge(order.begin(), bounds[i], bounds[i + 1], CSortColumnsLess(columns));
 }
 
-bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
+std::wstring GetSortLabel(SortUtils::SortPreparator preparator, SortAttribute attributes, const SortItem &item)
 {
-  return SorterAscending(*left, *right);
+  std::wstring sortLabel;
+#ifdef TARGET_ANDROID
+  // Android does not support locale; Translate to ASCII
+  std::string dest;
+  g_charsetConverter.utf8ToASCII(preparator(attributes, item), dest);
+  for (char c : dest)
+  {
+    if (::isalnum(c) || c == ' ')
+      sortLabel.push_back(c);
+  }
+#else
+  g_charsetConverter.utf8ToW(preparator(attributes, item), sortLabel, false);
+#endif
+  return sortLabel;
 }
 
-bool SorterIndirectDescending(const SortItemPtr &left, const SortItemPtr &right)
+const SortItem& GetItem(const SortItem &item) { return item; }
+const SortItem& GetItem(const SortItemPtr &item) { return *item; }
+SortItem& GetItem(SortItem &item) { return item; }
+SortItem& GetItem(SortItemPtr &item) { return *item; }
+
+/*!
+ \brief Determine the sorted order of the items, applying the limits.
+ \return false if the items don't need to be sorted
+ */
+template<typename T>
+bool GetOrder(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, std::vector<T> &items,
+              const SortUtils::SortPreparator &preparator, const Fields &sortingFields,
+              std::vector<size_t> &order, std::vector<std::wstring> &labels)
 {
-  return SorterDescending(*left, *right);
+  if (sortBy == SortByNone || preparator == NULL)
+    return false;
+
+  SortColumns columns;
+  columns.handleFolder = (attributes & SortAttributeIgnoreFolders) == 0;
+  columns.descending = sortOrder == SortOrderDescending;
+  columns.labels.reserve(items.size());
+  columns.special.reserve(items.size());
+  columns.folder.reserve(items.size());
+
+  CSortTokensScope sortTokens;
+
+  bool numeric = true;
+  for (auto it = items.begin(); it != items.end(); ++it)
+  {
+    SortItem &item = GetItem(*it);
+
+    // add all fields to the item that are required for sorting if they are currently missing
+    for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
+    {
+      if (item.find(*field) == item.end())
+        item.insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
+    }
+
+    columns.labels.push_back(GetSortLabel(preparator, attributes, item));
+
+    if (numeric)
+    {
+      int64_t number;
+      numeric = GetNumber(columns.labels.back(), number);
+      if (numeric)
+        columns.numbers.push_back(number);
+    }
+
+    SortSpecial special = SortSpecialNone;
+    SortItem::const_iterator field = item.find(FieldSortSpecial);
+    if (field != item.end() && field->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+      special = (SortSpecial)field->second.asInteger();
+    columns.special.push_back(static_cast<char>(special));
+
+    field = item.find(FieldFolder);
+    columns.folder.push_back(field == item.end() ? -1 : (field->second.asBoolean() ? 1 : 0));
+  }
+  if (!numeric)
+  {
+    columns.numbers.clear();
+    StringUtils::AlphaNumericCollationKeys(columns.labels, columns.keys);
+  }
+
+  order.resize(items.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  SortIndices(order, columns);
+
+  labels = std::move(columns.labels);
+  return true;
 }
 
-bool SorterIndirectIgnoreFoldersAscending(const SortItemPtr &left, const SortItemPtr &right)
+void ApplyLimits(std::vector<size_t> &order, int limitEnd, int limitStart)
 {
-  return SorterIgnoreFoldersAscending(*left, *right);
+  if (limitStart > 0 && (size_t)limitStart < order.size())
+  {
+    order.erase(order.begin(), order.begin() + limitStart);
+    limitEnd -= limitStart;
+  }
+  if (limitEnd > 0 && (size_t)limitEnd < order.size())
+    order.erase(order.begin() + limitEnd, order.end());
 }
 
-bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortItemPtr &right)
+template<typename T>
+void SortItemsByColumns(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, std::vector<T> &items,
+                        int limitEnd, int limitStart,
+                        const SortUtils::SortPreparator &preparator, const Fields &sortingFields)
 {
-  return SorterIgnoreFoldersDescending(*left, *right);
+  std::vector<size_t> order;
+  std::vector<std::wstring> labels;
+  if (!GetOrder(sortBy, sortOrder, attributes, items, preparator, sortingFields, order, labels))
+  {
+    order.resize(items.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+  }
+  ApplyLimits(order, limitEnd, limitStart);
+
+  std::vector<T> sorted;
+  sorted.reserve(order.size());
+  for (std::vector<size_t>::const_iterator it = order.begin(); it != order.end(); ++it)
+  {
+    // keep the string used for sorting under FieldSort
+    if (!labels.empty())
+      GetItem(items[*it])[FieldSort] = CVariant(std::move(labels[*it]));
+    sorted.push_back(std::move(items[*it]));
+  }
+  items = std::move(sorted);
+}
 }
 
 std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
@@ -711,102 +896,12 @@ std::map<SortBy, Fields> SortUtils::m_sortingFields = fillSortingFields();
 
 void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, DatabaseResults& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
 {
-  if (sortBy != SortByNone)
-  {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator != NULL)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
-
-      // Prepare the string used for sorting and store it under FieldSort
-      for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
-      {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if (item->find(*field) == item->end())
-            item->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-#ifdef TARGET_ANDROID
-        // Android does not support locale; Translate to ASCII
-        std::string dest;
-        g_charsetConverter.utf8ToASCII(preparator(attributes, *item), dest);
-        for (char c : dest)
-        {
-          if (::isalnum(c) || c == ' ')
-            sortLabel.push_back(c);
-        }
-#else
-        g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-#endif
-        item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
-      }
-
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
-    }
-  }
-
-  if (limitStart > 0 && (size_t)limitStart < items.size())
-  {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
-  }
-  if (limitEnd > 0 && (size_t)limitEnd < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
+  SortItemsByColumns(sortBy, sortOrder, attributes, items, limitEnd, limitStart, getPreparator(sortBy), GetFieldsForSorting(sortBy));
 }
 
 void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, SortItems& items, int limitEnd /* = -1 */, int limitStart /* = 0 */)
 {
-  if (sortBy != SortByNone)
-  {
-    // get the matching SortPreparator
-    SortPreparator preparator = getPreparator(sortBy);
-    if (preparator != NULL)
-    {
-      Fields sortingFields = GetFieldsForSorting(sortBy);
-
-      // Prepare the string used for sorting and store it under FieldSort
-      for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
-      {
-        // add all fields to the item that are required for sorting if they are currently missing
-        for (Fields::const_iterator field = sortingFields.begin(); field != sortingFields.end(); ++field)
-        {
-          if ((*item)->find(*field) == (*item)->end())
-            (*item)->insert(std::pair<Field, CVariant>(*field, CVariant::ConstNullVariant));
-        }
-
-        std::wstring sortLabel;
-#ifdef TARGET_ANDROID
-        // Android does not support locale; Translate to ASCII
-        std::string dest;
-        g_charsetConverter.utf8ToASCII(preparator(attributes, **item), dest);
-        for (char c : dest)
-        {
-          if (::isalnum(c) || c == ' ')
-            sortLabel.push_back(c);
-        }
-#else
-        g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
-#endif
-        (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
-      }
-
-      // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
-    }
-  }
-
-  if (limitStart > 0 && (size_t)limitStart < items.size())
-  {
-    items.erase(items.begin(), items.begin() + limitStart);
-    limitEnd -= limitStart;
-  }
-  if (limitEnd > 0 && (size_t)limitEnd < items.size())
-    items.erase(items.begin() + limitEnd, items.end());
+  SortItemsByColumns(sortBy, sortOrder, attributes, items, limitEnd, limitStart, getPreparator(sortBy), GetFieldsForSorting(sortBy));
 }
 
 void SortUtils::Sort(const SortDescription &sortDescription, DatabaseResults& items)
@@ -819,6 +914,19 @@ void SortUtils::Sort(const SortDescription &sortDescription, SortItems& items)
   Sort(sortDescription.sortBy, sortDescription.sortOrder, sortDescription.sortAttributes, items, sortDescription.limitEnd, sortDescription.limitStart);
 }
 
+void SortUtils::GetSortedOrder(const SortDescription &sortDescription, DatabaseResults& items, std::vector<size_t> &order, std::vector<std::wstring> &sortLabels)
+{
+  if (!GetOrder(sortDescription.sortBy, sortDescription.sortOrder, sortDescription.sortAttributes, items,
+                getPreparator(sortDescription.sortBy), GetFieldsForSorting(sortDescription.sortBy), order, sortLabels))
+  {
+    order.resize(items.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    sortLabels.clear();
+  }
+  ApplyLimits(order, sortDescription.limitEnd, sortDescription.limitStart);
+}
+
 bool SortUtils::SortFromDataset(const SortDescription &sortDescription, const MediaType &mediaType, const std::unique_ptr<dbiplus::Dataset> &dataset, DatabaseResults &results)
 {
   FieldList fields;
@@ -849,22 +957,6 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIgnoreFoldersDescending : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIndirectIgnoreFoldersDescending : SorterIndirectIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterIndirectDescending : SorterIndirectAscending;
-}
-
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 {
   std::map<SortBy, Fields>::const_iterator it = m_sortingFields.find(sortBy);
@@ -876,7 +968,14 @@ const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 
 std::string SortUtils::RemoveArticles(const std::string &label)
 {
-  std::set<std::string> sortTokens = g_langInfo.GetSortTokens();
+  if (currentSortTokens)
+    return RemoveArticles(label, *currentSortTokens);
+
+  return RemoveArticles(label, g_langInfo.GetSortTokens());
+}
+
+std::string SortUtils::RemoveArticles(const std::string &label, const std::set<std::string> &sortTokens)
+{
   for (std::set<std::string>::const_iterator token = sortTokens.begin(); token != sortTokens.end(); ++token)
   {
     if (token->size() < label.size() && StringUtils::StartsWithNoCase(label, *token))
@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -211,19 +212,28 @@ public:
   static void Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attributes, SortItems& items, int limitEnd = -1, int limitStart = 0);
   static void Sort(const SortDescription &sortDescription, DatabaseResults& items);
   static void Sort(const SortDescription &sortDescription, SortItems& items);
+
+  /*! \brief Determine the sorted order of the given items without reordering them.
+   Sorting a list of indices is cheaper than moving the items around, which is
+   useful when the items are only a by-product of another list that has to be
+   reordered anyway.
+   \param sortDescription how to sort the items, including the limits
+   \param items the items to sort, fields required for sorting are added if missing
+   \param order [out] the indices of the items in sorted order, limited as requested
+   \param sortLabels [out] the label used for sorting of every item, in the original order
+                     (empty if the items weren't sorted)
+   */
+  static void GetSortedOrder(const SortDescription &sortDescription, DatabaseResults& items, std::vector<size_t> &order, std::vector<std::wstring> &sortLabels);
   static bool SortFromDataset(const SortDescription &sortDescription, const MediaType &mediaType, const std::unique_ptr<dbiplus::Dataset> &dataset, DatabaseResults &results);
   
   static const Fields& GetFieldsForSorting(SortBy sortBy);
   static std::string RemoveArticles(const std::string &label);
+  static std::string RemoveArticles(const std::string &label, const std::set<std::string> &sortTokens);
   
   typedef std::string (*SortPreparator) (SortAttribute, const SortItem&);
-  typedef bool (*Sorter) (const DatabaseResult &, const DatabaseResult &);
-  typedef bool (*SorterIndirect) (const SortItemPtr &, const SortItemPtr &);
   
 private:
   static const SortPreparator& getPreparator(SortBy sortBy);
-  static Sorter getSorter(SortOrder sortOrder, SortAttribute attributes);
-  static SorterIndirect getSorterIndirect(SortOrder sortOrder, SortAttribute attributes);
 
   static std::map<SortBy, SortPreparator> m_preparators;
   static std::map<SortBy, Fields> m_sortingFields;
@@ -829,6 +829,87 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t *left, const wchar_t *rig
   return 0; // files are the same
 }
 
+namespace
+{
+inline bool IsDigit(wchar_t c)
+{
+  return c >= L'0' && c <= L'9';
+}
+
+inline wchar_t FoldCase(wchar_t c)
+{
+  // same case folding as AlphaNumericCompare()
+  if (c >= L'A' && c <= L'Z')
+    c += L'a' - L'A';
+  return c;
+}
+}
+
+void StringUtils::AlphaNumericCollationKeys(const std::vector<std::wstring> &strings, std::vector<std::u32string> &keys)
+{
+  const std::collate<wchar_t>& coll = std::use_facet<std::collate<wchar_t> >(g_langInfo.GetSystemLocale());
+
+  // collect all distinct characters, numbers are ranked like the digit 0
+  std::vector<wchar_t> chars(1, L'0');
+  for (const std::wstring &str : strings)
+  {
+    for (wchar_t c : str)
+    {
+      if (!IsDigit(c))
+        chars.push_back(FoldCase(c));
+    }
+  }
+  std::sort(chars.begin(), chars.end());
+  chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+  // rank the characters by the locale, characters which collate equally get the same rank
+  std::vector<wchar_t> collated(chars);
+  auto less = [&coll](wchar_t left, wchar_t right)
+  {
+    return coll.compare(&left, &left + 1, &right, &right + 1) < 0;
+  };
+  std::stable_sort(collated.begin(), collated.end(), less);
+  std::vector<char32_t> ranks(chars.size());
+  char32_t rank = 0;
+  for (size_t i = 0; i < collated.size(); ++i)
+  {
+    if (i == 0 || less(collated[i - 1], collated[i]))
+      ++rank;
+    size_t index = std::lower_bound(chars.begin(), chars.end(), collated[i]) - chars.begin();
+    ranks[index] = rank;
+  }
+  const char32_t numberRank = ranks[std::lower_bound(chars.begin(), chars.end(), L'0') - chars.begin()];
+
+  keys.resize(strings.size());
+  for (size_t i = 0; i < strings.size(); ++i)
+  {
+    const std::wstring &str = strings[i];
+    std::u32string &key = keys[i];
+    key.clear();
+    key.reserve(str.size());
+
+    for (size_t pos = 0; pos < str.size();)
+    {
+      if (IsDigit(str[pos]))
+      {
+        // compare only up to 15 digits, like AlphaNumericCompare()
+        uint64_t number = 0;
+        size_t end = std::min(pos + 15, str.size());
+        for (; pos < end && IsDigit(str[pos]); ++pos)
+          number = number * 10 + (str[pos] - L'0');
+        key.push_back(numberRank);
+        key.push_back(static_cast<char32_t>(number >> 32));
+        key.push_back(static_cast<char32_t>(number & 0xffffffff));
+      }
+      else
+      {
+        wchar_t c = FoldCase(str[pos++]);
+        key.push_back(ranks[std::lower_bound(chars.begin(), chars.end(), c) - chars.begin()]);
+      }
+    }
+  }
+}
+
 int StringUtils::DateStringToYYYYMMDD(const std::string &dateString)
 {
   std::vector<std::string> days = StringUtils::Split(dateString, '-');
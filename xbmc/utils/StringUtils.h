@@ -240,6 +240,17 @@ public:
   static std::vector<std::string> SplitMulti(const std::vector<std::string> &input, const std::vector<std::string> &delimiters, unsigned int iMaxStrings = 0);
   static int FindNumber(const std::string& strInput, const std::string &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+
+  /*! \brief Build keys for a set of strings that sort like AlphaNumericCompare().
+   Comparing the keys lexicographically gives the same order as comparing the strings
+   with AlphaNumericCompare(), but the locale is only consulted once per distinct
+   character instead of once per character of every comparison. Numbers are encoded
+   by value, so natural ordering is kept. The only difference is when a number is
+   compared against a character that the locale sorts in between two digits.
+   \param strings the strings to build keys for
+   \param keys [out] the key of every string. Keys are only comparable to keys of the same call.
+   */
+  static void AlphaNumericCollationKeys(const std::vector<std::wstring> &strings, std::vector<std::u32string> &keys);
   static long TimeStringToSeconds(const std::string &timeString);
   static void RemoveCRLF(std::string& strLine);
 
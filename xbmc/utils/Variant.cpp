@@ -20,6 +20,7 @@
 
 #include "Variant.h"
 
+#include <algorithm>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -278,8 +279,10 @@ CVariant::CVariant(const std::map<std::string, std::string> &strMap)
 {
   m_type = VariantTypeObject;
   m_data.map = new VariantMap;
+  m_data.map->reserve(strMap.size());
+  // std::map is already sorted by key
   for (std::map<std::string, std::string>::const_iterator it = strMap.begin(); it != strMap.end(); ++it)
-    m_data.map->insert(make_pair(it->first, CVariant(it->second)));
+    m_data.map->push_back(make_pair(it->first, CVariant(it->second)));
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
@@ -294,7 +297,7 @@ CVariant::CVariant(const CVariant &variant)
   *this = variant;
 }
 
-CVariant::CVariant(CVariant&& rhs)
+CVariant::CVariant(CVariant&& rhs) noexcept
 {
   //Set this so that operator= don't try and run cleanup
   //when we're not initialized.
@@ -564,18 +567,25 @@ CVariant &CVariant::operator[](const std::string &key)
   }
 
   if (m_type == VariantTypeObject)
-    return (*m_data.map)[key];
+  {
+    VariantMap::iterator it = lowerBound(key);
+    if (it == m_data.map->end() || it->first != key)
+      it = m_data.map->insert(it, make_pair(key, CVariant()));
+    return it->second;
+  }
   else
     return ConstNullVariant;
 }
 
 const CVariant &CVariant::operator[](const std::string &key) const
 {
-  VariantMap::const_iterator it;
-  if (m_type == VariantTypeObject && (it = m_data.map->find(key)) != m_data.map->end())
-    return it->second;
-  else
-    return ConstNullVariant;
+  if (m_type == VariantTypeObject)
+  {
+    VariantMap::const_iterator it = lowerBound(key);
+    if (it != m_data.map->end() && it->first == key)
+      return it->second;
+  }
+  return ConstNullVariant;
 }
 
 CVariant &CVariant::operator[](unsigned int position)
@@ -636,7 +646,7 @@ CVariant &CVariant::operator=(const CVariant &rhs)
   return *this;
 }
 
-CVariant& CVariant::operator=(CVariant&& rhs)
+CVariant& CVariant::operator=(CVariant&& rhs) noexcept
 {
   if (m_type == VariantTypeConstNull || this == &rhs)
     return *this;
@@ -862,7 +872,11 @@ void CVariant::erase(const std::string &key)
     m_data.map = new VariantMap;
   }
   else if (m_type == VariantTypeObject)
-    m_data.map->erase(key);
+  {
+    VariantMap::iterator it = lowerBound(key);
+    if (it != m_data.map->end() && it->first == key)
+      m_data.map->erase(it);
+  }
 }
 
 void CVariant::erase(unsigned int position)
@@ -880,7 +894,19 @@ void CVariant::erase(unsigned int position)
 bool CVariant::isMember(const std::string &key) const
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->find(key) != m_data.map->end();
+  {
+    VariantMap::const_iterator it = lowerBound(key);
+    return it != m_data.map->end() && it->first == key;
+  }
 
   return false;
 }
+
+CVariant::VariantMap::iterator CVariant::lowerBound(const std::string &key) const
+{
+  return std::lower_bound(m_data.map->begin(), m_data.map->end(), key,
+                          [](const VariantMap::value_type &member, const std::string &name)
+                          {
+                            return member.first < name;
+                          });
+}
@@ -74,7 +74,7 @@ public:
   CVariant(const std::map<std::string, std::string> &strMap);
   CVariant(const std::map<std::string, CVariant> &variantMap);
   CVariant(const CVariant &variant);
-  CVariant(CVariant &&rhs);
+  CVariant(CVariant &&rhs) noexcept;
   ~CVariant();
 
 
@@ -108,7 +108,7 @@ public:
   const CVariant &operator[](unsigned int position) const;
 
   CVariant &operator=(const CVariant &rhs);
-  CVariant &operator=(CVariant &&rhs);
+  CVariant &operator=(CVariant &&rhs) noexcept;
   bool operator==(const CVariant &rhs) const;
   bool operator!=(const CVariant &rhs) const { return !(*this == rhs); }
 
@@ -123,7 +123,9 @@ public:
 
 private:
   typedef std::vector<CVariant> VariantArray;
-  typedef std::map<std::string, CVariant> VariantMap;
+  // objects are usually small, so their members are kept in a vector sorted by key
+  // instead of a node per member. Adding a member invalidates references to the others.
+  typedef std::vector<std::pair<std::string, CVariant> > VariantMap;
 
 public:
   typedef VariantArray::iterator        iterator_array;
@@ -154,6 +156,7 @@ public:
 
 private:
   void cleanup();
+  VariantMap::iterator lowerBound(const std::string &key) const;
   union VariantUnion
   {
     int64_t integer;
@@ -161,3 +161,64 @@ TEST(TestJSONVariantWriter, CanWriteArray)
   ASSERT_TRUE(CJSONVariantWriter::Write(variant, str, false));
   ASSERT_STREQ("[\n\t{\n\t\t\"foo\": \"bar\"\n\t}\n]", str.c_str());
 }
+
+TEST(TestJSONVariantWriter, CanStreamObject)
+{
+  CVariant variant;
+  variant["foo"] = "bar";
+  variant["list"].push_back(1);
+  variant["list"].push_back(-2.5);
+  variant["list"].push_back(CVariant(CVariant::VariantTypeObject));
+  variant["nested"]["null"] = CVariant();
+  variant["nested"]["bool"] = true;
+
+  for (bool compact : { true, false })
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(variant, expected, compact));
+
+    std::string str;
+    size_t chunks = 0;
+    CJSONStreamWriter writer([&](const char *data, size_t size)
+    {
+      EXPECT_LE(size, 8U);
+      str.append(data, size);
+      chunks++;
+      return true;
+    }, compact, 8);
+
+    // write the same object member by member
+    ASSERT_TRUE(writer.StartObject());
+    for (CVariant::const_iterator_map itr = variant.begin_map(); itr != variant.end_map(); ++itr)
+    {
+      ASSERT_TRUE(writer.Key(itr->first));
+      ASSERT_TRUE(writer.Write(itr->second));
+    }
+    ASSERT_FALSE(writer.IsComplete());
+    ASSERT_TRUE(writer.EndObject());
+    ASSERT_TRUE(writer.Flush());
+
+    ASSERT_TRUE(writer.IsComplete());
+    ASSERT_GT(chunks, 1U);
+    ASSERT_STREQ(expected.c_str(), str.c_str());
+  }
+}
+
+TEST(TestJSONVariantWriter, StreamStopsWhenOutputFails)
+{
+  size_t calls = 0;
+  CJSONStreamWriter writer([&](const char *data, size_t size)
+  {
+    calls++;
+    return false;
+  }, true, 4);
+
+  ASSERT_TRUE(writer.StartArray());
+  ASSERT_FALSE(writer.Write("a string longer than the buffer"));
+  ASSERT_TRUE(writer.HasFailed());
+  ASSERT_FALSE(writer.Write(1));
+  ASSERT_FALSE(writer.EndArray());
+  ASSERT_FALSE(writer.Flush());
+  ASSERT_FALSE(writer.IsComplete());
+  ASSERT_EQ(1U, calls);
+}
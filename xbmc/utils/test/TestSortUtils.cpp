@@ -19,6 +19,7 @@
  */
 
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
 #include "gtest/gtest.h"
@@ -133,3 +134,113 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)5, fields.size());
 }
+
+TEST(TestSortUtils, Sort_NumericLabels)
+{
+  SortItems items;
+  const int64_t sizes[] = { 100, 20, 3, 20, 1000000000000 };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldSize] = sizes[i];
+    (*item)[FieldId] = (int)i;
+    items.push_back(item);
+  }
+
+  SortUtils::Sort(SortBySize, SortOrderAscending, SortAttributeNone, items);
+
+  ASSERT_EQ(5U, items.size());
+  EXPECT_EQ(2, (*items[0])[FieldId].asInteger());
+  EXPECT_EQ(1, (*items[1])[FieldId].asInteger());
+  EXPECT_EQ(3, (*items[2])[FieldId].asInteger());
+  EXPECT_EQ(0, (*items[3])[FieldId].asInteger());
+  EXPECT_EQ(4, (*items[4])[FieldId].asInteger());
+  EXPECT_TRUE((*items[0])[FieldSort].asWideString() == L"3");
+
+  SortUtils::Sort(SortBySize, SortOrderDescending, SortAttributeNone, items);
+
+  EXPECT_EQ(4, (*items[0])[FieldId].asInteger());
+  EXPECT_EQ(0, (*items[1])[FieldId].asInteger());
+  EXPECT_EQ(2, (*items[4])[FieldId].asInteger());
+}
+
+TEST(TestSortUtils, Sort_SpecialAndFolders)
+{
+  DatabaseResults items(5);
+  items[0][FieldLabel] = "b file";
+  items[0][FieldFolder] = false;
+  items[1][FieldLabel] = "z folder";
+  items[1][FieldFolder] = true;
+  items[2][FieldLabel] = "a file";
+  items[2][FieldFolder] = false;
+  items[3][FieldLabel] = "bottom";
+  items[3][FieldSortSpecial] = SortSpecialOnBottom;
+  items[4][FieldLabel] = "top";
+  items[4][FieldSortSpecial] = SortSpecialOnTop;
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+
+  EXPECT_STREQ("top", items[0][FieldLabel].asString().c_str());
+  EXPECT_STREQ("z folder", items[1][FieldLabel].asString().c_str());
+  EXPECT_STREQ("a file", items[2][FieldLabel].asString().c_str());
+  EXPECT_STREQ("b file", items[3][FieldLabel].asString().c_str());
+  EXPECT_STREQ("bottom", items[4][FieldLabel].asString().c_str());
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeIgnoreFolders, items);
+
+  EXPECT_STREQ("top", items[0][FieldLabel].asString().c_str());
+  EXPECT_STREQ("a file", items[1][FieldLabel].asString().c_str());
+  EXPECT_STREQ("b file", items[2][FieldLabel].asString().c_str());
+  EXPECT_STREQ("z folder", items[3][FieldLabel].asString().c_str());
+  EXPECT_STREQ("bottom", items[4][FieldLabel].asString().c_str());
+}
+
+TEST(TestSortUtils, Sort_LargeListIsStable)
+{
+  // large enough to be sorted in parallel chunks
+  const int count = 50000;
+  DatabaseResults items(count);
+  for (int i = 0; i < count; ++i)
+  {
+    items[i][FieldLabel] = StringUtils::Format("Item %d", (count - i) % 100);
+    items[i][FieldId] = i;
+  }
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+
+  ASSERT_EQ((size_t)count, items.size());
+  for (int i = 1; i < count; ++i)
+  {
+    int64_t cmp = StringUtils::AlphaNumericCompare(items[i - 1][FieldSort].asWideString().c_str(),
+                                                   items[i][FieldSort].asWideString().c_str());
+    ASSERT_LE(cmp, 0);
+    if (cmp == 0)
+      ASSERT_LT(items[i - 1][FieldId].asInteger(), items[i][FieldId].asInteger());
+  }
+}
+
+TEST(TestSortUtils, GetSortedOrder)
+{
+  DatabaseResults items(4);
+  items[0][FieldLabel] = "c";
+  items[1][FieldLabel] = "a";
+  items[2][FieldLabel] = "d";
+  items[3][FieldLabel] = "b";
+
+  SortDescription desc;
+  desc.sortBy = SortByLabel;
+  desc.limitStart = 1;
+  desc.limitEnd = 3;
+
+  std::vector<size_t> order;
+  std::vector<std::wstring> labels;
+  SortUtils::GetSortedOrder(desc, items, order, labels);
+
+  ASSERT_EQ(2U, order.size());
+  EXPECT_EQ(3U, order[0]);
+  EXPECT_EQ(0U, order[1]);
+  ASSERT_EQ(4U, labels.size());
+  EXPECT_TRUE(labels[2] == L"d");
+  // the items themselves are left in place
+  EXPECT_STREQ("c", items[0][FieldLabel].asString().c_str());
+}
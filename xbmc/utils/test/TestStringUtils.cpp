@@ -313,6 +313,24 @@ TEST(TestStringUtils, AlphaNumericCompare)
   EXPECT_LT(var, ref);
 }
 
+TEST(TestStringUtils, AlphaNumericCollationKeys)
+{
+  std::vector<std::wstring> strings = { L"a2", L"a10", L"B", L"a", L"x", L"x1", L"a01", L"a1", L"123abc", L"abc123" };
+  std::vector<std::u32string> keys;
+  StringUtils::AlphaNumericCollationKeys(strings, keys);
+  ASSERT_EQ(strings.size(), keys.size());
+
+  for (size_t i = 0; i < strings.size(); ++i)
+  {
+    for (size_t j = 0; j < strings.size(); ++j)
+    {
+      int64_t ref = StringUtils::AlphaNumericCompare(strings[i].c_str(), strings[j].c_str());
+      EXPECT_EQ(ref < 0, keys[i] < keys[j]);
+      EXPECT_EQ(ref == 0, keys[i] == keys[j]);
+    }
+  }
+}
+
 TEST(TestStringUtils, TimeStringToSeconds)
 {
   EXPECT_EQ(77455, StringUtils::TimeStringToSeconds("21:30:55"));
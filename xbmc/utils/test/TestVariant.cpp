@@ -345,3 +345,55 @@ TEST(TestVariant, isMember)
   EXPECT_TRUE(a.isMember("key1"));
   EXPECT_FALSE(a.isMember("key2"));
 }
+
+TEST(TestVariant, memberOrder)
+{
+  CVariant a;
+  a["key3"] = 3;
+  a["key1"] = 1;
+  a["key4"] = 4;
+  a["key2"] = 2;
+  a["key1"] = 10;
+
+  // members are iterated in key order, whatever order they were added in
+  const char *keys[] = { "key1", "key2", "key3", "key4" };
+  const int values[] = { 10, 2, 3, 4 };
+  unsigned int i = 0;
+  for (auto it = a.begin_map(); it != a.end_map(); it++, i++)
+  {
+    ASSERT_LT(i, 4U);
+    EXPECT_EQ(keys[i], it->first);
+    EXPECT_EQ(values[i], it->second.asInteger());
+  }
+  EXPECT_EQ(4U, i);
+
+  a.erase("key3");
+  a.erase("key5");
+  EXPECT_EQ(3U, a.size());
+  EXPECT_FALSE(a.isMember("key3"));
+  EXPECT_EQ(4, a["key4"].asInteger());
+}
+
+TEST(TestVariant, objectEquality)
+{
+  std::map<std::string, std::string> strmap;
+  strmap["b"] = "2";
+  strmap["a"] = "1";
+  CVariant a(strmap);
+
+  CVariant b;
+  b["b"] = "2";
+  b["a"] = "1";
+
+  EXPECT_TRUE(a == b);
+  EXPECT_STREQ("1", a["a"].c_str());
+
+  b["c"] = "3";
+  EXPECT_FALSE(a == b);
+  b.erase("c");
+
+  CVariant c(b);
+  EXPECT_TRUE(c == b);
+  c["a"] = "x";
+  EXPECT_FALSE(c == b);
+}
@@ -529,8 +529,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query_prepared(strSQL, { field_value(strPath1) });
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -539,7 +539,7 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "%s unable to getpath (%s)", __FUNCTION__, strSQL.c_str());
+    CLog::Log(LOGERROR, "%s unable to getpath (%s) (%s)", __FUNCTION__, strSQL.c_str(), strPath.c_str());
   }
   return -1;
 }
@@ -732,27 +732,21 @@ int CVideoDatabase::AddPath(const std::string& strPath, const std::string &paren
     int idParentPath = GetPathId(parentPath.empty() ? (std::string)URIUtils::GetParentPath(strPath1) : parentPath);
 
     // add the path
+    field_value parent(idParentPath);
     if (idParentPath < 0)
-    {
-      if (dateAdded.IsValid())
-        strSQL=PrepareSQL("insert into path (idPath, strPath, dateAdded) values (NULL, '%s', '%s')", strPath1.c_str(), dateAdded.GetAsDBDateTime().c_str());
-      else
-        strSQL=PrepareSQL("insert into path (idPath, strPath) values (NULL, '%s')", strPath1.c_str());
-    }
-    else
-    {
-      if (dateAdded.IsValid())
-        strSQL = PrepareSQL("insert into path (idPath, strPath, dateAdded, idParentPath) values (NULL, '%s', '%s', %i)", strPath1.c_str(), dateAdded.GetAsDBDateTime().c_str(), idParentPath);
-      else
-        strSQL=PrepareSQL("insert into path (idPath, strPath, idParentPath) values (NULL, '%s', %i)", strPath1.c_str(), idParentPath);
-    }
-    m_pDS->exec(strSQL);
+      parent.set_isNull();
+    field_value added(dateAdded.IsValid() ? dateAdded.GetAsDBDateTime() : std::string());
+    if (!dateAdded.IsValid())
+      added.set_isNull();
+
+    strSQL = "insert into path (idPath, strPath, dateAdded, idParentPath) values (NULL, ?, ?, ?)";
+    m_pDS->exec_prepared(strSQL, { field_value(strPath1), added, parent });
     idPath = (int)m_pDS->lastinsertid();
     return idPath;
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "%s unable to addpath (%s)", __FUNCTION__, strSQL.c_str());
+    CLog::Log(LOGERROR, "%s unable to addpath (%s) (%s)", __FUNCTION__, strSQL.c_str(), strPath.c_str());
   }
   return -1;
 }
@@ -878,9 +872,9 @@ int CVideoDatabase::AddFile(const std::string& strFileNameAndPath)
     if (idPath < 0)
       return -1;
 
-    std::string strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
+    strSQL = "select idFile from files where strFileName=? and idPath=?";
 
-    m_pDS->query(strSQL);
+    m_pDS->query_prepared(strSQL, { field_value(strFileName), field_value(idPath) });
     if (m_pDS->num_rows() > 0)
     {
       idFile = m_pDS->fv("idFile").get_asInt() ;
@@ -889,14 +883,14 @@ int CVideoDatabase::AddFile(const std::string& strFileNameAndPath)
     }
     m_pDS->close();
 
-    strSQL=PrepareSQL("insert into files (idFile, idPath, strFileName) values(NULL, %i, '%s')", idPath, strFileName.c_str());
-    m_pDS->exec(strSQL);
+    strSQL = "insert into files (idFile, idPath, strFileName) values(NULL, ?, ?)";
+    m_pDS->exec_prepared(strSQL, { field_value(idPath), field_value(strFileName) });
     idFile = (int)m_pDS->lastinsertid();
     return idFile;
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "%s unable to addfile (%s)", __FUNCTION__, strSQL.c_str());
+    CLog::Log(LOGERROR, "%s unable to addfile (%s) (%s)", __FUNCTION__, strSQL.c_str(), strFileNameAndPath.c_str());
   }
   return -1;
 }
@@ -1065,9 +1059,8 @@ int CVideoDatabase::GetFileId(const std::string& strFilenameAndPath)
     int idPath = GetPathId(strPath);
     if (idPath >= 0)
     {
-      std::string strSQL;
-      strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
-      m_pDS->query(strSQL);
+      m_pDS->query_prepared("select idFile from files where strFileName=? and idPath=?",
+                            { field_value(strFileName), field_value(idPath) });
       if (m_pDS->num_rows() > 0)
       {
         int idFile = m_pDS->fv("files.idFile").get_asInt();
@@ -6742,7 +6735,44 @@ bool CVideoDatabase::GetMoviesNav(const std::string& strBaseDir, CFileItemList&
   return GetMoviesByWhere(videoUrl.ToString(), filter, items, sortDescription, getDetails);
 }
 
+namespace
+{
+  // collects the movies read by CVideoDatabase::ReadMoviesByWhere in a list
+  class CMovieListCallback : public CDatabase::IItemCallback
+  {
+  public:
+    explicit CMovieListCallback(CFileItemList &items) : m_items(items) { }
+
+    bool OnTotal(int total) override
+    {
+      // store the total value of items as a property
+      m_items.SetProperty("total", total);
+      return true;
+    }
+
+    bool OnItem(const CFileItemPtr &item) override
+    {
+      m_items.Add(item);
+      return true;
+    }
+
+  private:
+    CFileItemList &m_items;
+  };
+}
+
 bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
+{
+  CMovieListCallback callback(items);
+  return ReadMoviesByWhere(strBaseDir, filter, callback, sortDescription, getDetails, false);
+}
+
+bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
+{
+  return ReadMoviesByWhere(strBaseDir, filter, callback, sortDescription, getDetails, true);
+}
+
+bool CVideoDatabase::ReadMoviesByWhere(const std::string& strBaseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription, int getDetails, bool totalFirst)
 {
   try
   {
@@ -6775,17 +6805,54 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
 
+    // without sorting, items are created in database order straight from a
+    // forward-only cursor instead of buffering the whole result set first
+    if (sortDescription.sortBy == SortByNone)
+    {
+      // the total has to be known before the first movie is passed on
+      if (totalFirst && total < 0)
+        total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
+
+      strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
+      if (!m_pDS->query_forward(strSQL))
+        return false;
+
+      int count = 0;
+      while (!m_pDS->eof())
+      {
+        if (count++ == 0 && totalFirst && !callback.OnTotal(total))
+          break;
+
+        CFileItemPtr item = GetMovieItem(m_pDS->get_sql_record(), videoUrl, getDetails);
+        if (item != nullptr && !callback.OnItem(item))
+          break;
+
+        m_pDS->next();
+      }
+
+      bool stopped = !m_pDS->eof();
+      m_pDS->close();
+      if (stopped)
+        return false;
+
+      if (!totalFirst && count > 0)
+      {
+        if (total < count)
+          total = count;
+        callback.OnTotal(total);
+      }
+      return true;
+    }
+
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
     int iRowsFound = RunQuery(strSQL);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
 
-    // store the total value of items as a property
     if (total < iRowsFound)
       total = iRowsFound;
-    items.SetProperty("total", total);
-    
+
     DatabaseResults results;
     results.reserve(iRowsFound);
 
@@ -6793,33 +6860,19 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       return false;
 
     // get data from returned rows
-    items.Reserve(results.size());
+    bool stopped = !callback.OnTotal(total);
     const query_data &data = m_pDS->get_result_set().records;
-    for (const auto &i : results)
+    for (DatabaseResults::const_iterator it = results.begin(); !stopped && it != results.end(); ++it)
     {
-      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
-      if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
-          g_passwordManager.bMasterUser                                   ||
-          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
-      {
-        CFileItemPtr pItem(new CFileItem(movie));
-
-        CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", movie.m_iDbId);
-        itemUrl.AppendPath(path);
-        pItem->SetPath(itemUrl.ToString());
-
-        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
-        items.Add(pItem);
-      }
+      unsigned int targetRow = (unsigned int)it->at(FieldRow).asInteger();
+      CFileItemPtr item = GetMovieItem(data.at(targetRow), videoUrl, getDetails);
+      if (item != nullptr && !callback.OnItem(item))
+        stopped = true;
     }
 
     // cleanup
     m_pDS->close();
-    return true;
+    return !stopped;
   }
   catch (...)
   {
@@ -6828,6 +6881,25 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
   return false;
 }
 
+CFileItemPtr CVideoDatabase::GetMovieItem(const dbiplus::sql_record* const record, const CVideoDbUrl &videoUrl, int getDetails)
+{
+  CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
+  if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE &&
+      !g_passwordManager.bMasterUser                                   &&
+      !g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
+    return CFileItemPtr();
+
+  CFileItemPtr pItem(new CFileItem(movie));
+
+  CVideoDbUrl itemUrl = videoUrl;
+  std::string path = StringUtils::Format("%i", movie.m_iDbId);
+  itemUrl.AppendPath(path);
+  pItem->SetPath(itemUrl.ToString());
+
+  pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
+  return pItem;
+}
+
 bool CVideoDatabase::GetTvShowsNav(const std::string& strBaseDir, CFileItemList& items,
                                   int idGenre /* = -1 */, int idYear /* = -1 */, int idActor /* = -1 */, int idDirector /* = -1 */, int idStudio /* = -1 */, int idTag /* = -1 */,
                                   const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
@@ -792,6 +792,11 @@ public:
 
   // smart playlists and main retrieval work in these functions
   bool GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
+  /*! \brief Passes the movies to the callback while they are being read instead of collecting them in a list
+   The total number of movies is passed to IItemCallback::OnTotal() before the first movie.
+   \return false if the query failed or the callback stopped the listing
+   */
+  bool GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
   bool GetSetsByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, bool ignoreSingleMovieSets = false);
   bool GetTvShowsByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription = SortDescription(), int getDetails = VideoDbDetailsNone);
   bool GetSeasonsByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, bool appendFullShowPath = true, const SortDescription &sortDescription = SortDescription());
@@ -919,6 +924,13 @@ protected:
   void DeleteStreamDetails(int idFile);
   CVideoInfoTag GetDetailsForMovie(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
+  /*! \brief Reads the movies matching the given filter
+   \param totalFirst whether the total has to be passed to the callback before the first movie,
+   otherwise it's passed after the last one if that's cheaper
+   */
+  bool ReadMoviesByWhere(const std::string& strBaseDir, const Filter &filter, IItemCallback &callback, const SortDescription &sortDescription, int getDetails, bool totalFirst);
+  /*! \brief Creates the item of the movie in the given record, nullptr if the movie is locked */
+  std::shared_ptr<CFileItem> GetMovieItem(const dbiplus::sql_record* const record, const CVideoDbUrl &videoUrl, int getDetails);
   CVideoInfoTag GetDetailsForTvShow(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone, CFileItem* item = NULL);
   CVideoInfoTag GetDetailsForTvShow(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone, CFileItem* item = NULL);
   CVideoInfoTag GetDetailsForEpisode(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone);
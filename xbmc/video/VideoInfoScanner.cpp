@@ -29,6 +29,7 @@
 #include "events/MediaLibraryEvent.h"
 #include "FileItem.h"
 #include "filesystem/DirectoryCache.h"
+#include "filesystem/DirectoryCrawler.h"
 #include "filesystem/File.h"
 #include "filesystem/MultiPathDirectory.h"
 #include "filesystem/StackDirectory.h"
@@ -122,6 +123,14 @@ namespace VIDEO
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
 
+      // Commit added videos in batches rather than one by one
+      m_database.BeginBatch(g_advancedSettings.m_iVideoLibraryScanBatchItems,
+                            g_advancedSettings.m_iVideoLibraryScanBatchTime);
+
+      // fetch the listings and modification times of subfolders while the current one is scanned
+      m_crawler.reset(new CDirectoryCrawler(CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                            DIR_FLAG_DEFAULTS, std::vector<std::string>(), true));
+
       bool bCancelled = false;
       while (!bCancelled && !m_pathsToScan.empty())
       {
@@ -150,6 +159,9 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      m_crawler.reset();
+      m_database.EndBatch();
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -262,12 +274,13 @@ namespace VIDEO
     const std::vector<std::string> &regexps = content == CONTENT_TVSHOWS ? g_advancedSettings.m_tvshowExcludeFromScanRegExps
                                                          : g_advancedSettings.m_moviesExcludeFromScanRegExps;
 
-    if (IsExcluded(strDirectory, regexps))
-      return true;
-
     bool ignoreFolder = !m_scanAll && settings.noupdate;
-    if (content == CONTENT_NONE || ignoreFolder)
+    if (IsExcluded(strDirectory, regexps) || content == CONTENT_NONE || ignoreFolder)
+    {
+      if (m_crawler)
+        m_crawler->Release(strDirectory);
       return true;
+    }
 
     std::string hash, dbHash;
     if (content == CONTENT_MOVIES ||content == CONTENT_MUSICVIDEOS)
@@ -285,11 +298,16 @@ namespace VIDEO
       if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
       { // fast hashes match - no need to process anything
         hash = fastHash;
+        if (m_crawler)
+          m_crawler->Release(strDirectory);
       }
       else
       { // need to fetch the folder
-        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
-                                 DIR_FLAG_DEFAULTS);
+        if (m_crawler)
+          m_crawler->GetDirectory(strDirectory, items);
+        else
+          CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                   DIR_FLAG_DEFAULTS);
         items.Stack();
 
         // check whether to re-use previously computed fast hash
@@ -325,6 +343,10 @@ namespace VIDEO
       if (m_handle)
         m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(20319).c_str(), info->Name().c_str()));
 
+      // we don't recurse into tvshow folders, so don't prefetch their subfolders either
+      if (m_crawler)
+        m_crawler->Release(strDirectory);
+
       if (foundDirectly && !settings.parent_name_root)
       {
         CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
@@ -476,6 +498,7 @@ namespace VIDEO
       }
 
       pURL = NULL;
+      m_database.BatchItemDone();
 
       // Keep track of directories we've seen
       if (m_bClean && pItem->m_bIsFolder)
@@ -809,6 +832,7 @@ namespace VIDEO
 
       if (updateSeasonArt)
       {
+        m_database.CommitBatch();
         CVideoInfoDownloader loader(scraper);
         loader.GetArtwork(showInfo);
         GetSeasonThumbs(showInfo, seasonArt, CVideoThumbLoader::GetArtTypes(MediaTypeSeason), useLocal && !item->IsPlugin());
@@ -1637,6 +1661,7 @@ namespace VIDEO
             pDlgProgress->Progress();
           }
 
+          m_database.CommitBatch();
           CVideoInfoDownloader imdb(scraper);
           if (!imdb.GetEpisodeList(url, episodes))
             return INFO_NOT_FOUND;
@@ -1735,6 +1760,7 @@ namespace VIDEO
 
       if (bFound)
       {
+        m_database.CommitBatch();
         CVideoInfoDownloader imdb(scraper);
         CFileItem item;
         item.SetPath(file->strPath);
@@ -1770,6 +1796,8 @@ namespace VIDEO
     if (m_handle && !url.strTitle.empty())
       m_handle->SetText(url.strTitle);
 
+    // don't hold the batched writes open while waiting for the scraper
+    m_database.CommitBatch();
     CVideoInfoDownloader imdb(scraper);
     bool ret = imdb.GetDetails(url, movieDetails, pDialog);
 
@@ -1857,17 +1885,20 @@ namespace VIDEO
     if (excludes.size())
       digest.Update(StringUtils::Join(excludes, "|"));
 
-    struct __stat64 buffer;
-    if (XFILE::CFile::Stat(directory, &buffer) == 0)
+    int64_t time = 0;
+    if (m_crawler)
+      time = m_crawler->GetFolderTime(directory);
+    else
     {
-      int64_t time = buffer.st_mtime;
-      if (!time)
-        time = buffer.st_ctime;
-      if (time)
-      {
-        digest.Update((unsigned char *)&time, sizeof(time));
-        return digest.Finalize();
-      }
+      struct __stat64 buffer;
+      if (XFILE::CFile::Stat(directory, &buffer) == 0)
+        time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+    }
+
+    if (time)
+    {
+      digest.Update((unsigned char *)&time, sizeof(time));
+      return digest.Finalize();
     }
     return "";
   }
@@ -1875,9 +1906,8 @@ namespace VIDEO
   std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
-    CFileItemList items;
-    items.Add(CFileItemPtr(new CFileItem(directory, true)));
-    CUtil::GetRecursiveDirsListing(directory, items, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
+    // stat the folders while their parents are still being listed
+    CDirectoryCrawler crawler("", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO, std::vector<std::string>(), true);
 
     CDigest digest{CDigest::Type::MD5};
 
@@ -1885,20 +1915,26 @@ namespace VIDEO
       digest.Update(StringUtils::Join(excludes, "|"));
 
     int64_t time = 0;
-    for (int i=0; i < items.Size(); ++i)
+    std::vector<std::string> folders(1, directory);
+    while (!folders.empty())
     {
-      int64_t stat_time = 0;
-      struct __stat64 buffer;
-      if (XFILE::CFile::Stat(items[i]->GetPath(), &buffer) == 0)
-      {
-        //! @todo some filesystems may return the mtime/ctime inline, in which case this is
-        //! unnecessarily expensive. Consider supporting Stat() in our directory cache?
-        stat_time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
-        time += stat_time;
-      }
+      std::string folder = folders.back();
+      folders.pop_back();
 
+      //! @todo some filesystems may return the mtime/ctime inline, in which case this is
+      //! unnecessarily expensive. Consider supporting Stat() in our directory cache?
+      int64_t stat_time = crawler.GetFolderTime(folder);
       if (!stat_time)
         return "";
+      time += stat_time;
+
+      CFileItemList items;
+      crawler.GetDirectory(folder, items);
+      for (int i = items.Size() - 1; i >= 0; --i)
+      {
+        if (items[i]->m_bIsFolder && !items[i]->IsPath(".."))
+          folders.push_back(items[i]->GetPath());
+      }
     }
 
     if (time)
@@ -2057,6 +2093,7 @@ namespace VIDEO
   int CVideoInfoScanner::FindVideo(const std::string &title, int year, const ScraperPtr &scraper, CScraperUrl &url, CGUIDialogProgress *progress)
   {
     MOVIELIST movielist;
+    m_database.CommitBatch();
     CVideoInfoDownloader imdb(scraper);
     int returncode = imdb.FindMovie(title, year, movielist, progress);
     if (returncode < 0 || (returncode == 0 && (m_bStop || !DownloadFailed(progress))))
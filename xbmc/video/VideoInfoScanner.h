@@ -19,6 +19,7 @@
  *
  */
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -31,6 +32,11 @@ class CRegExp;
 class CFileItem;
 class CFileItemList;
 
+namespace XFILE
+{
+  class CDirectoryCrawler;
+}
+
 namespace VIDEO
 {
   class IVideoInfoTagLoader;
@@ -243,6 +249,7 @@ namespace VIDEO
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::unique_ptr<XFILE::CDirectoryCrawler> m_crawler;
   };
 }
 
@@ -20,6 +20,7 @@
 
 #include "VideoThumbLoader.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <utility>
 
@@ -39,6 +40,7 @@
 #include "cores/VideoSettings.h"
 #include "TextureCache.h"
 #include "URL.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "utils/EmbeddedArt.h"
 #include "utils/StringUtils.h"
@@ -85,28 +87,45 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+namespace
+{
+/* extraction decodes in software, leave half of the cores to playback and the GUI */
+unsigned int GetExtractionBudget()
+{
+  return std::max(1, g_cpuInfo.getCPUCount() / 2);
+}
+
+bool CanExtractFrom(const CFileItem& item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  m_item.IsPVRRecording()
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  item.IsPVRRecording()
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+}
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item))
     return false;
 
   bool result=false;
@@ -183,8 +202,58 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CChapterThumbExtractor::CChapterThumbExtractor(const CFileItem& item, const std::vector<Chapter>& chapters)
+  : m_item(item), m_chapters(chapters)
+{
+  if (m_item.IsStack())
+    m_item.SetPath(CStackDirectory::GetFirstStackedFile(m_item.GetPath()));
+}
+
+CChapterThumbExtractor::~CChapterThumbExtractor() = default;
+
+bool CChapterThumbExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CChapterThumbExtractor* jobExtract = dynamic_cast<const CChapterThumbExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath()
+                   && jobExtract->m_chapters.size() == m_chapters.size()
+                   && std::equal(m_chapters.begin(), m_chapters.end(), jobExtract->m_chapters.begin(),
+                                 [](const Chapter& a, const Chapter& b) { return a.target == b.target; }))
+      return true;
+  }
+  return false;
+}
+
+bool CChapterThumbExtractor::DoWork()
+{
+  if (m_chapters.empty() || !CanExtractFrom(m_item))
+    return false;
+
+  CLog::Log(LOGDEBUG, "%s - trying to extract %u chapter thumbs from video file %s", __FUNCTION__,
+            static_cast<unsigned int>(m_chapters.size()), CURL::GetRedacted(m_item.GetPath()).c_str());
+
+  std::vector<int> positions;
+  std::vector<CTextureDetails> details(m_chapters.size());
+  for (unsigned int i = 0; i < m_chapters.size(); ++i)
+  {
+    positions.push_back(static_cast<int>(m_chapters[i].pos));
+    details[i].file = CTextureCache::GetCacheFile(m_chapters[i].target) + ".jpg";
+  }
+
+  unsigned int done = 0;
+  return CDVDFileInfo::ExtractThumbs(m_item.GetPath(), positions, details,
+    [&](unsigned int index, bool extracted)
+    {
+      if (extracted)
+        CTextureCache::GetInstance().AddCachedTexture(m_chapters[index].target, details[index]);
+      m_completedChapter = m_chapters[index].index;
+      return ShouldCancel(++done, m_chapters.size());
+    });
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, GetExtractionBudget(), CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
 }
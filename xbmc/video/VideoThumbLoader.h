@@ -63,6 +63,49 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details? 
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Thumb extractor job for the chapters of a video file
+
+ Extracts the thumbs of all given chapters in one pass, keeping the file and
+ decoder open across the seeks. Every finished chapter is reported through
+ IJobCallback::OnJobProgress, GetCompletedChapter() tells which one it was.
+
+ \sa CDVDFileInfo::ExtractThumbs
+ */
+class CChapterThumbExtractor : public CJob
+{
+public:
+  struct Chapter
+  {
+    int index;          ///< chapter number
+    int64_t pos;        ///< position in ms
+    std::string target; ///< thumbpath
+  };
+
+  CChapterThumbExtractor(const CFileItem& item, const std::vector<Chapter>& chapters);
+  ~CChapterThumbExtractor() override;
+
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  /*!
+   \brief The chapter that finished last, valid within OnJobProgress.
+   */
+  int GetCompletedChapter() const { return m_completedChapter; }
+
+private:
+  CFileItem m_item;
+  std::vector<Chapter> m_chapters;
+  int m_completedChapter = -1;
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -270,6 +270,7 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
   }
 
   // add chapters if around
+  std::vector<CChapterThumbExtractor::Chapter> chapterThumbs;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -292,11 +293,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettings().GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
-      m_jobsStarted++;
+      chapterThumbs.push_back({ i, pos * 1000, chapterPath });
+      m_jobsStarted = i;
     }
 
     item->SetProperty("chapter", i);
@@ -305,6 +303,10 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  // one job for all chapters, so the file and decoder are opened once
+  if (!chapterThumbs.empty())
+    AddJob(new CChapterThumbExtractor(CFileItem(m_filePath, false), chapterThumbs));
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -473,7 +475,6 @@ void CGUIDialogVideoBookmarks::OnWindowLoaded()
   m_viewControl.SetParentWindow(GetID());
   m_viewControl.AddView(GetControl(CONTROL_THUMBS));
   m_jobsStarted = 0;
-  m_mapJobsChapter.clear();
   m_vecItems->Clear();
 }
 
@@ -481,7 +482,6 @@ void CGUIDialogVideoBookmarks::OnWindowUnload()
 {
   //stop running thumb extraction jobs
   CancelJobs();
-  m_mapJobsChapter.clear();
   m_vecItems->Clear();
   CGUIDialog::OnWindowUnload();
   m_viewControl.Reset();
@@ -566,19 +566,13 @@ bool CGUIDialogVideoBookmarks::OnAddEpisodeBookmark()
   return bReturn;
 }
 
-void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
-                                             bool success, CJob* job)
+void CGUIDialogVideoBookmarks::OnJobProgress(unsigned int jobID, unsigned int progress,
+                                             unsigned int total, const CJob* job)
 {
-  if (success && IsActive())
+  const CChapterThumbExtractor* extractor = dynamic_cast<const CChapterThumbExtractor*>(job);
+  if (extractor && IsActive())
   {
-    MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
-    if (iter != m_mapJobsChapter.end())
-    {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CApplicationMessenger::GetInstance().SendGUIMessage(m);
-      m_mapJobsChapter.erase(iter);
-    }
+    CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, extractor->GetCompletedChapter());
+    CApplicationMessenger::GetInstance().SendGUIMessage(m);
   }
-  CJobQueue::OnJobComplete(jobID, success, job);
 }
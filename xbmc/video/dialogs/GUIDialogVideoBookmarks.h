@@ -29,8 +29,6 @@ class CFileItemList;
 
 class CGUIDialogVideoBookmarks : public CGUIDialog, public CJobQueue
 {
-  typedef std::map<CJob*, unsigned int> MAPJOBSCHAPS;
-
 public:
   CGUIDialogVideoBookmarks(void);
   ~CGUIDialogVideoBookmarks(void) override;
@@ -72,7 +70,7 @@ protected:
   void OnPopupMenu(int item);
   CGUIControl *GetFirstFocusableControl(int id) override;
 
-  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+  void OnJobProgress(unsigned int jobID, unsigned int progress, unsigned int total, const CJob* job) override;
 
   CFileItemList* m_vecItems;
   CGUIViewControl m_viewControl;
@@ -84,5 +82,4 @@ private:
   int m_jobsStarted;
   std::string m_filePath;
   CCriticalSection m_refreshSection;
-  MAPJOBSCHAPS m_mapJobsChapter;
 };
@@ -718,6 +718,13 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
     if (strDirectory.empty())
       SetupShares();
     
+    // listings stored on disk by an earlier session are fine for browsing,
+    // but a refresh has to go to the share
+    int flags = XFILE::DIR_FLAG_ALLOW_PROMPT;
+    if (!m_vecItemsUpdating)
+      flags |= XFILE::DIR_FLAG_PERSISTENT_CACHE;
+    m_rootDir.SetFlags(flags);
+
     CFileItemList dirItems;
     if (!GetDirectoryItems(pathToUrl, dirItems, UseFileDirectories()))
       return false;